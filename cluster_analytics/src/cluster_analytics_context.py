@@ -7,11 +7,11 @@ import threading
 import time
 import numpy as np
 from collections import Counter, defaultdict
-from sklearn.cluster import DBSCAN
 
 from scene_common import log
+from scene_common.geometry import Dbscan
 from scene_common.mqtt import PubSub
-from cluster_analytics_tracker import ClusterTracker, HungarianMatcher
+from cluster_analytics_tracker import ClusterTracker
 
 class ClusterAnalyticsConfig:
   """Configuration settings for cluster analytics loaded from config.json"""
@@ -82,9 +82,11 @@ class ClusterAnalyticsContext:
     self.webui_keyfile = webui_keyfile
 
     # Initialize cluster tracker for tracking clusters across frames
-    self.cluster_tracker = ClusterTracker(matcher=HungarianMatcher(), config=self.config)
+    self.cluster_tracker = ClusterTracker(config=self.config)
 
     self.user_dbscan_params_by_scene = {}
+    # DBSCAN engines per (scene, category), they keep the neighbor structure across frames
+    self.dbscan_engines = {}
 
     # Initialize WebUI if enabled
     self.webUi = None
@@ -245,6 +247,34 @@ class ClusterAnalyticsContext:
     else:
       log.warning(f"Cannot reset DBSCAN parameters for '{category}': scene '{scene_id}' not found or no scene_id provided")
 
+  def getDbscanEngine(self, scene_id, category, dbscan_params):
+    """! Get the DBSCAN engine of a category in a scene, updated to the current parameters
+    @param   scene_id       Scene identifier
+    @param   category       Object category
+    @param   dbscan_params  DBSCAN parameters with 'eps' and 'min_samples'
+    @return  Dbscan engine
+    """
+    key = (scene_id, category)
+    eps = float(dbscan_params['eps'])
+    min_samples = int(dbscan_params['min_samples'])
+    engine = self.dbscan_engines.get(key)
+    if engine is None:
+      engine = Dbscan(eps, min_samples)
+      self.dbscan_engines[key] = engine
+    else:
+      engine.setParams(eps, min_samples)
+    return engine
+
+  def removeDbscanEngines(self, scene_id, categories):
+    """! Remove the DBSCAN engines of a scene whose category left the scene
+    @param   scene_id    Scene identifier
+    @param   categories  Categories still present in the scene
+    @return  None
+    """
+    for key in [key for key in self.dbscan_engines if key[0] == scene_id and key[1] not in categories]:
+      del self.dbscan_engines[key]
+    return
+
   def mqttOnConnect(self, client, userdata, flags, rc):
     """! Subscribes to MQTT topics on connection.
     @param   client    Client instance for this callback.
@@ -348,6 +378,9 @@ class ClusterAnalyticsContext:
       category = obj.get('category', 'unknown')
       objects_by_category[category].append(obj)
 
+    # Engines of categories which are no longer in the scene would never be used again
+    self.removeDbscanEngines(scene_id, objects_by_category)
+
     # Get the minimum min_samples requirement across all categories that have objects
     min_samples_list = [
             self.getDbscanParamsForCategory(category, scene_id)['min_samples']
@@ -373,13 +406,9 @@ class ClusterAnalyticsContext:
       coordinates = self.extractCoordinatesFromObjects(category_objects)
       coordinates_array = np.array(coordinates)
 
-      # Apply DBSCAN clustering
-      clustering = DBSCAN(
-              eps=dbscan_params['eps'],
-              min_samples=dbscan_params['min_samples']
-      ).fit(coordinates_array)
-
-      labels = clustering.labels_
+      # Apply DBSCAN clustering, object ids let the engine reuse the neighbors of the previous frame
+      engine = self.getDbscanEngine(scene_id, category, dbscan_params)
+      labels = engine.fit(coordinates_array, [str(obj.get('id', '')) for obj in category_objects])
       n_clusters = len(set(labels)) - (1 if -1 in labels else 0)
       n_noise = np.sum(labels == -1)
 
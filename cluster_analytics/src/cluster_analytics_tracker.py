@@ -3,13 +3,10 @@
 
 import uuid
 import time
-import numpy as np
-from typing import Dict, List, Tuple, Optional, Set
-from dataclasses import dataclass, field
+from typing import Dict, List, Optional, Tuple
 from collections import defaultdict
 from scene_common import log
-from abc import ABC, abstractmethod
-from scipy.optimize import linear_sum_assignment
+from robot_vision import tracking
 
 class ClusterState:
   """Finite State Machine states for cluster lifecycle tracking"""
@@ -19,248 +16,76 @@ class ClusterState:
   FADING = 'fading'        # Recently missed detections
   LOST = 'lost'            # Not detected for extended period
 
-@dataclass
-class ClusterHistory:
-  """Historical observations for temporal analysis"""
-  positions: List[Tuple[float, float, float]] = field(default_factory=list)  # [(x, y, timestamp)]
-  velocities: List[Tuple[float, float, float]] = field(default_factory=list)  # [(vx, vy, timestamp)]
-  sizes: List[int] = field(default_factory=list)
-  shapes: List[str] = field(default_factory=list)
-  timestamps: List[float] = field(default_factory=list)
-
-  MAX_HISTORY_SIZE = 100
-
-  def addObservation(self, position: Tuple[float, float], velocity: Tuple[float, float],
-                                      size: int, shape: str, timestamp: float) -> None:
-    """Add new observation and maintain history size limit"""
-    self.positions.append((*position, timestamp))
-    self.velocities.append((*velocity, timestamp))
-    self.sizes.append(size)
-    self.shapes.append(shape)
-    self.timestamps.append(timestamp)
-
-    # Trim to maximum size
-    if len(self.timestamps) > self.MAX_HISTORY_SIZE:
-      self.positions = self.positions[-self.MAX_HISTORY_SIZE:]
-      self.velocities = self.velocities[-self.MAX_HISTORY_SIZE:]
-      self.sizes = self.sizes[-self.MAX_HISTORY_SIZE:]
-      self.shapes = self.shapes[-self.MAX_HISTORY_SIZE:]
-      self.timestamps = self.timestamps[-self.MAX_HISTORY_SIZE:]
-    return
+NATIVE_CLUSTER_STATES = {
+        tracking.ClusterState.New: ClusterState.NEW,
+        tracking.ClusterState.Active: ClusterState.ACTIVE,
+        tracking.ClusterState.Stable: ClusterState.STABLE,
+        tracking.ClusterState.Fading: ClusterState.FADING,
+        tracking.ClusterState.Lost: ClusterState.LOST
+}
 
 class TrackedCluster:
   """
   Represents a cluster being tracked across video frames.
 
-  Responsibilities:
-  - Maintain cluster state (NEW -> ACTIVE -> STABLE -> FADING -> LOST)
-  - Track confidence metrics and position/velocity
-  - Maintain observation history
-  - Predict future positions for matching
+  The association, the centroid filtering and the lifecycle (NEW -> ACTIVE -> STABLE -> FADING -> LOST)
+  run in the native robot_vision ClusterTracker. This class keeps the identity published over MQTT
+  and the analysis of the last detection which matched the cluster.
   """
 
-  def __init__(self, scene_id: str, category: str, centroid: Dict[str, float],
-           shape_analysis: Dict, velocity_analysis: Dict, object_ids: List[str],
-           dbscan_params: Dict, detection_timestamp: float) -> None:
-    """Initialize a new tracked cluster"""
-    # Hardcoded cluster tracking parameters
-    # State transitions
-    self.FRAMES_TO_ACTIVATE = 3
-    self.FRAMES_TO_STABLE = 20
-    self.FRAMES_TO_FADE = 15
-    self.FRAMES_TO_LOST = 10
-
-    # Confidence
-    self.INITIAL_CONFIDENCE = 0.5
-    self.ACTIVATION_THRESHOLD = 0.6
-    self.STABILITY_THRESHOLD = 0.7
-    self.CONFIDENCE_MISS_PENALTY = 0.1
-    self.CONFIDENCE_MAX_MISS_PENALTY = 0.5
-    self.CONFIDENCE_LONGEVITY_BONUS_MAX = 0.2
-    self.CONFIDENCE_LONGEVITY_FRAMES = 100
-
+  def __init__(self, scene_id: str, native_id: int, detection: Dict) -> None:
+    """Initialize a tracked cluster from the detection which created it"""
     # Identity
     self.uuid = str(uuid.uuid4())
+    self.native_id = native_id
     self.scene_id = scene_id
-    self.category = category
+    self.category = detection.get('category', 'unknown')
+    self.dbscan_params = detection['dbscan_params']
 
-    # Current state
+    # Tracking state, refreshed from the native tracker every frame
     self.state = ClusterState.NEW
-    self.centroid = centroid
-    self.shape_analysis = shape_analysis
-    self.velocity_analysis = velocity_analysis
-    self.object_ids = object_ids
-    self.object_count = len(object_ids)
-    self.dbscan_params = dbscan_params
-
-    # Temporal tracking
-    self.first_seen = detection_timestamp
-    self.last_seen = detection_timestamp
-    self.last_updated = detection_timestamp
-    self.frames_detected = 1
-    self.frames_missed = 0
-    self.total_frames = 1
-
-    # Historical data
-    self.history = ClusterHistory()
-    self.history.addObservation(
-            position=(centroid['x'], centroid['y']),
-            velocity=tuple(velocity_analysis['average_velocity'][:2]),
-            size=self.object_count,
-            shape=shape_analysis['shape'],
-            timestamp=detection_timestamp
-    )
-
-    # Computed metrics
-    self.confidence = self.INITIAL_CONFIDENCE  # Use config-based initial confidence
+    self.confidence = 0.0
     self.stability_score = 0.0
+    self.frames_detected = 0
+    self.frames_missed = 0
+    self.total_frames = 0
+    self.first_seen = None
+    self.last_seen = None
+    self.last_updated = None
     self.predicted_position: Optional[Tuple[float, float]] = None
     self.predicted_velocity: Optional[Tuple[float, float]] = None
 
-    self._updatePrediction()
+    self.setDetection(detection)
     return
 
-  def update(self, centroid: Dict[str, float], shape_analysis: Dict,
-                      velocity_analysis: Dict, object_ids: List[str], detection_timestamp: float) -> None:
-    """Update cluster with new detection"""
-    old_state = self.state
-
-    # Update current data
-    self.centroid = centroid
-    self.shape_analysis = shape_analysis
-    self.velocity_analysis = velocity_analysis
-    self.object_ids = object_ids
-    self.object_count = len(object_ids)
-    self.last_seen = detection_timestamp
-    self.last_updated = detection_timestamp
-    self.frames_detected += 1
-    self.total_frames += 1
-    self.frames_missed = 0
-
-    # Update history
-    self.history.addObservation(
-            position=(centroid['x'], centroid['y']),
-            velocity=tuple(velocity_analysis['average_velocity'][:2]),
-            size=self.object_count,
-            shape=shape_analysis['shape'],
-            timestamp=detection_timestamp
-    )
-
-    # Recalculate metrics
-    self._updateConfidence()
-    self._updateStabilityScore()
-    self._updateState()
-    self._updatePrediction()
-
-    if old_state != self.state:
-      log.debug(f"Cluster {self.uuid} state transition: {old_state} -> {self.state}")
+  def setDetection(self, detection: Dict) -> None:
+    """Keep the analysis of the detection which matched the cluster in this frame"""
+    self.centroid = detection['center_of_mass']
+    self.shape_analysis = detection['shape_analysis']
+    self.velocity_analysis = detection['velocity_analysis']
+    self.object_ids = detection['object_ids']
+    self.object_count = len(self.object_ids)
     return
 
-  def markMissed(self, current_timestamp: float) -> None:
-    """Mark cluster as not detected in current frame"""
+  def setTrackingState(self, native_cluster) -> None:
+    """Copy the state of the native cluster"""
     old_state = self.state
 
-    self.frames_missed += 1
-    self.total_frames += 1
-    self.last_updated = current_timestamp
-
-    self._updateConfidence()
-    self._updateState()
+    self.state = NATIVE_CLUSTER_STATES[native_cluster.state]
+    self.confidence = native_cluster.confidence
+    self.stability_score = native_cluster.stability_score
+    self.frames_detected = native_cluster.frames_detected
+    self.frames_missed = native_cluster.frames_missed
+    self.total_frames = native_cluster.total_frames
+    self.first_seen = native_cluster.first_seen
+    self.last_seen = native_cluster.last_seen
+    self.last_updated = native_cluster.last_updated
+    self.predicted_position = (native_cluster.predicted_x, native_cluster.predicted_y)
+    self.predicted_velocity = (native_cluster.vx, native_cluster.vy)
 
     if old_state != self.state:
-      log.debug(f"Cluster {self.uuid} state transition: {old_state} -> {self.state} (missed {self.frames_missed} frames)")
-    return
-
-  def _updateConfidence(self) -> None:
-    """Calculate tracking confidence based on detection consistency"""
-    detection_ratio = self.frames_detected / max(self.total_frames, 1)
-
-    # Base confidence from detection ratio
-    base_confidence = detection_ratio
-
-    # Penalty for recent misses
-    miss_penalty = min(self.frames_missed * self.CONFIDENCE_MISS_PENALTY, self.CONFIDENCE_MAX_MISS_PENALTY)
-
-    # Bonus for long-term tracking
-    longevity_bonus = min(
-            self.frames_detected / self.CONFIDENCE_LONGEVITY_FRAMES,
-            self.CONFIDENCE_LONGEVITY_BONUS_MAX
-    )
-
-    self.confidence = max(0.0, min(1.0, base_confidence - miss_penalty + longevity_bonus))
-    return
-
-  def _updateStabilityScore(self) -> None:
-    """Calculate cluster stability based on historical variance"""
-    if len(self.history.positions) < 3:
-      self.stability_score = 0.0
-      return
-
-    # Analyze recent history (last 10 observations)
-    recent_positions = self.history.positions[-10:]
-    recent_sizes = self.history.sizes[-10:]
-    recent_shapes = self.history.shapes[-10:]
-
-    # Position stability (low variance = high stability)
-    positions_array = np.array([(p[0], p[1]) for p in recent_positions])
-    position_variance = np.mean(np.var(positions_array, axis=0))
-    position_stability = 1.0 / (1.0 + position_variance)
-
-    # Size stability
-    size_variance = np.var(recent_sizes)
-    size_stability = 1.0 / (1.0 + size_variance)
-
-    # Shape consistency
-    most_common_shape = max(set(recent_shapes), key=recent_shapes.count)
-    shape_consistency = recent_shapes.count(most_common_shape) / len(recent_shapes)
-
-    # Weighted combination
-    self.stability_score = (
-            0.4 * position_stability
-            + 0.3 * size_stability
-            + 0.3 * shape_consistency
-    )
-    return
-
-  def _updateState(self) -> None:
-    """Update cluster state based on tracking history (FSM)"""
-    if self.state == ClusterState.NEW:
-      if self.frames_detected >= self.FRAMES_TO_ACTIVATE and self.confidence > self.ACTIVATION_THRESHOLD:
-        self.state = ClusterState.ACTIVE
-    elif self.state == ClusterState.ACTIVE:
-      if self.frames_detected >= self.FRAMES_TO_STABLE and self.stability_score > self.STABILITY_THRESHOLD:
-        self.state = ClusterState.STABLE
-      elif self.frames_missed >= self.FRAMES_TO_FADE:
-        self.state = ClusterState.FADING
-    elif self.state == ClusterState.STABLE:
-      if self.frames_missed >= self.FRAMES_TO_FADE:
-        self.state = ClusterState.FADING
-    elif self.state == ClusterState.FADING:
-      if self.frames_missed >= self.FRAMES_TO_LOST:
-        self.state = ClusterState.LOST
-      elif self.frames_missed == 0:  # Redetected
-        self.state = ClusterState.ACTIVE
-    return
-
-  def _updatePrediction(self) -> None:
-    """Predict next position using linear extrapolation"""
-    if len(self.history.positions) < 2:
-      self.predicted_position = (self.centroid['x'], self.centroid['y'])
-      self.predicted_velocity = tuple(self.velocity_analysis['average_velocity'][:2])
-      return
-
-    # Use recent observations for prediction
-    recent_velocities = self.history.velocities[-5:]
-    avg_velocity = np.mean([v[:2] for v in recent_velocities], axis=0)
-
-    current_pos = (self.centroid['x'], self.centroid['y'])
-
-    # Predict next position (assuming time delta ~= 1 frame)
-    self.predicted_position = (
-            current_pos[0] + avg_velocity[0],
-            current_pos[1] + avg_velocity[1]
-    )
-    self.predicted_velocity = tuple(avg_velocity)
+      log.debug(f"Cluster {self.uuid} state transition: {old_state} -> {self.state} "
+                f"(missed {self.frames_missed} frames)")
     return
 
   def getAgeSeconds(self, current_time: Optional[float]) -> float:
@@ -316,7 +141,7 @@ class ClusterMemory:
   Responsibilities:
   - Store active clusters in memory
   - Archive old/lost clusters
-  - Provide query operations (by scene, category, state)
+  - Provide query operations (by scene, category, state, native id)
   - Manage cleanup and lifecycle
   """
 
@@ -324,8 +149,7 @@ class ClusterMemory:
   MAX_ARCHIVED_CLUSTERS = 50
 
   def __init__(self, config=None) -> None:
-    # Hardcoded archival parameter
-    self.ARCHIVE_TIME_THRESHOLD = 5.0
+    self.ARCHIVE_TIME_THRESHOLD = getattr(config, 'ARCHIVE_TIME_THRESHOLD', 5.0)
 
     # Primary storage
     self._active_clusters: Dict[str, TrackedCluster] = {}
@@ -334,6 +158,7 @@ class ClusterMemory:
     # Indexes for fast lookup
     self._clusters_by_scene: Dict[str, List[str]] = defaultdict(list)
     self._clusters_by_category: Dict[str, List[str]] = defaultdict(list)
+    self._clusters_by_native_id: Dict[Tuple[str, int], str] = {}
     return
 
   def add(self, cluster: TrackedCluster) -> None:
@@ -343,6 +168,7 @@ class ClusterMemory:
     # Update indexes
     self._clusters_by_scene[cluster.scene_id].append(cluster.uuid)
     self._clusters_by_category[cluster.category].append(cluster.uuid)
+    self._clusters_by_native_id[(cluster.scene_id, cluster.native_id)] = cluster.uuid
 
     log.debug(f"Added cluster {cluster.uuid} to memory (scene: {cluster.scene_id}, category: {cluster.category})")
     return
@@ -351,6 +177,11 @@ class ClusterMemory:
     """Retrieve cluster by UUID"""
     return self._active_clusters.get(cluster_uuid)
 
+  def getByNativeId(self, scene_id: str, native_id: int) -> Optional[TrackedCluster]:
+    """Retrieve cluster by the id of the native tracker of its scene"""
+    cluster_uuid = self._clusters_by_native_id.get((scene_id, native_id))
+    return self._active_clusters.get(cluster_uuid) if cluster_uuid else None
+
   def getClustersByScene(self, scene_id: str) -> List[TrackedCluster]:
     """Get all active clusters for a scene"""
     cluster_uuids = self._clusters_by_scene.get(scene_id, [])
@@ -384,6 +215,7 @@ class ClusterMemory:
       if cluster.category in self._clusters_by_category:
         if cluster_uuid in self._clusters_by_category[cluster.category]:
           self._clusters_by_category[cluster.category].remove(cluster_uuid)
+      self._clusters_by_native_id.pop((cluster.scene_id, cluster.native_id), None)
 
       log.debug(f"Archived cluster {cluster_uuid} (state: {cluster.state}, lifetime: {cluster.frames_detected} frames)")
     return
@@ -424,21 +256,13 @@ class ClusterMemory:
     @return: Number of clusters cleared
     """
     cleared_count = 0
-    clusters_to_archive = []
 
-    # Find clusters matching scene and category
-    for cluster_uuid, cluster in self._active_clusters.items():
-      if cluster.scene_id == scene_id and cluster.category == category:
-        clusters_to_archive.append(cluster_uuid)
-
-    # Archive all matching clusters
-    for cluster_uuid in clusters_to_archive:
-      cluster = self._active_clusters.get(cluster_uuid)
-      if cluster:
-        # Force state to LOST to ensure immediate removal
-        cluster.state = ClusterState.LOST
-        self.archive(cluster_uuid)
-        cleared_count += 1
+    # Archive all clusters matching scene and category
+    for cluster in self.getClustersByCategory(category, scene_id):
+      # Force state to LOST to ensure immediate removal
+      cluster.state = ClusterState.LOST
+      self.archive(cluster.uuid)
+      cleared_count += 1
 
     if cleared_count > 0:
       log.info(f"Cleared {cleared_count} clusters due to parameter change")
@@ -461,257 +285,110 @@ class ClusterMemory:
             'tracked_categories': len([c for c in self._clusters_by_category.values() if c])
     }
 
-class ClusterMatcher(ABC):
-  """Abstract base class for cluster matching strategies"""
-
-  @abstractmethod
-  def match(self, existing_clusters: List[TrackedCluster],
-       new_detections: List[Dict]) -> List[Tuple[str, int, float]]:
-    """
-    Match new detections to existing clusters.
-
-    @param existing_clusters: List of TrackedCluster objects
-    @param new_detections: List of detection dictionaries
-    @return: List of (cluster_uuid, detection_index, similarity_score) tuples
-    """
-    pass
-
-class HungarianMatcher(ClusterMatcher):
-  """
-  Hungarian algorithm matcher for optimal cluster assignment.
-  Uses multi-feature cost matrix (position, velocity, size, shape).
-  """
-
-  # Configuration constants
-  MAX_MATCHING_DISTANCE = 5.0  # Maximum distance for valid match
-  POSITION_WEIGHT = 0.4
-  VELOCITY_WEIGHT = 0.3
-  SIZE_WEIGHT = 0.2
-  SHAPE_WEIGHT = 0.1
-
-  def __init__(self, max_distance: Optional[float] = None) -> None:
-    """Initialize matcher with optional custom max distance"""
-    self.max_distance = max_distance or self.MAX_MATCHING_DISTANCE
-    return
-
-  def match(self, existing_clusters: List[TrackedCluster],
-       new_detections: List[Dict]) -> List[Tuple[str, int, float]]:
-    """Match using Hungarian algorithm with multi-feature cost matrix"""
-    if not existing_clusters or not new_detections:
-      return []
-
-    # Build cost matrix
-    cost_matrix = self._buildCostMatrix(existing_clusters, new_detections)
-
-    # Solve assignment problem
-    row_indices, col_indices = linear_sum_assignment(cost_matrix)
-
-    # Filter matches by threshold and return valid matches
-    matches = []
-    for row_idx, col_idx in zip(row_indices, col_indices):
-      cost = cost_matrix[row_idx, col_idx]
-      if cost < self.max_distance:
-        similarity = 1.0 - (cost / self.max_distance)
-        matches.append((
-                existing_clusters[row_idx].uuid,
-                col_idx,
-                similarity
-        ))
-
-    return matches
-
-  def _buildCostMatrix(self, existing_clusters: List[TrackedCluster],
-                                          new_detections: List[Dict]) -> np.ndarray:
-    """Build cost matrix for Hungarian algorithm"""
-    cost_matrix = np.zeros((len(existing_clusters), len(new_detections)))
-
-    for i, tracked in enumerate(existing_clusters):
-      for j, detection in enumerate(new_detections):
-        cost = self._calculateMatchingCost(tracked, detection)
-        cost_matrix[i, j] = cost
-
-    return cost_matrix
-
-  def _calculateMatchingCost(self, tracked: TrackedCluster, detection: Dict) -> float:
-    """Calculate matching cost between tracked cluster and new detection"""
-    # Hard constraint: must be same category
-    if tracked.category != detection.get('category'):
-      return float('inf')
-
-    # Position cost (use prediction if available)
-    predicted_pos = tracked.predicted_position or (
-            tracked.centroid['x'], tracked.centroid['y']
-    )
-    detection_pos = (
-            detection['center_of_mass']['x'],
-            detection['center_of_mass']['y']
-    )
-    position_distance = np.linalg.norm(
-            np.array(predicted_pos) - np.array(detection_pos)
-    )
-    position_cost = position_distance * self.POSITION_WEIGHT
-
-    # Velocity cost
-    tracked_vel = np.array(tracked.velocity_analysis['average_velocity'][:2])
-    detection_vel = np.array(detection['velocity_analysis']['average_velocity'][:2])
-    velocity_distance = np.linalg.norm(tracked_vel - detection_vel)
-    velocity_cost = velocity_distance * self.VELOCITY_WEIGHT
-
-    # Size cost
-    size_diff = abs(tracked.object_count - detection['objects_count'])
-    size_cost = size_diff * self.SIZE_WEIGHT
-
-    # Shape cost (binary: match or no match)
-    shape_match = (tracked.shape_analysis['shape']
-                                == detection['shape_analysis']['shape'])
-    shape_cost = (1.0 if shape_match else 2.0) * self.SHAPE_WEIGHT
-
-    total_cost = position_cost + velocity_cost + size_cost + shape_cost
-    return total_cost
+def createNativeConfig(config=None):
+  """Build the robot_vision ClusterTrackerConfig from the cluster analytics configuration"""
+  native_config = tracking.ClusterTrackerConfig()
+  if config is None:
+    return native_config
+
+  native_config.frames_to_activate = config.FRAMES_TO_ACTIVATE
+  native_config.frames_to_stable = config.FRAMES_TO_STABLE
+  native_config.frames_to_fade = config.FRAMES_TO_FADE
+  native_config.frames_to_lost = config.FRAMES_TO_LOST
+  native_config.initial_confidence = config.INITIAL_CONFIDENCE
+  native_config.activation_threshold = config.ACTIVATION_THRESHOLD
+  native_config.stability_threshold = config.STABILITY_THRESHOLD
+  native_config.confidence_miss_penalty = config.CONFIDENCE_MISS_PENALTY
+  native_config.confidence_max_miss_penalty = config.CONFIDENCE_MAX_MISS_PENALTY
+  native_config.confidence_longevity_bonus = config.CONFIDENCE_LONGEVITY_BONUS_MAX
+  native_config.confidence_longevity_frames = config.CONFIDENCE_LONGEVITY_FRAMES
+  native_config.archive_time = config.ARCHIVE_TIME_THRESHOLD
+  return native_config
 
 class ClusterTracker:
   """
   Main coordinator for cluster tracking operations.
 
+  Each scene has a native robot_vision ClusterTracker which matches the detections to the
+  predicted cluster centroids per category, filters the centroids with a constant velocity
+  Kalman estimator and drives the cluster lifecycle.
+
   Responsibilities:
-  - Orchestrate cluster lifecycle (create, update, archive)
-  - Match new detections to existing clusters
+  - Feed the cluster detections of a scene to its native tracker
+  - Keep the published identity and analysis of the tracked clusters
   - Manage cluster memory and cleanup
   - Provide query interface for active clusters
   """
 
-  def __init__(self, matcher: Optional[ClusterMatcher] = None, config=None) -> None:
-    """Initialize tracker with memory and matching strategy"""
+  def __init__(self, matcher=None, config=None) -> None:
+    """
+    Initialize tracker with memory and the native tracker configuration.
+
+    @param matcher: Ignored, kept for compatibility, the native tracker matches the cluster centroids
+    @param config: Tracker configuration
+    """
+    if matcher is not None:
+      log.warning("ClusterTracker ignores the matcher argument, the native tracker matches the cluster centroids")
     self.config = config
     self.memory = ClusterMemory(config=config)
-    self.matcher = matcher or HungarianMatcher()
+    self.native_config = createNativeConfig(config)
+    self._native_trackers: Dict[str, tracking.ClusterTracker] = {}
     return
 
+  def _getNativeTracker(self, scene_id: str) -> tracking.ClusterTracker:
+    """Get the native tracker of a scene, created on first use"""
+    native_tracker = self._native_trackers.get(scene_id)
+    if native_tracker is None:
+      native_tracker = tracking.ClusterTracker(self.native_config)
+      self._native_trackers[scene_id] = native_tracker
+    return native_tracker
+
   def processNewDetections(self, scene_id: str, new_cluster_detections: List[Dict],
                                                   timestamp: float) -> None:
     """
     Process new cluster detections and update tracking state.
 
+    Clusters of the scene which are not matched by a detection are marked as missed.
+
     @param scene_id: Scene identifier
     @param new_cluster_detections: List of cluster detection dictionaries
     @param timestamp: Detection timestamp
     """
-    # Group detections by category
-    detections_by_category = self._groupByCategory(new_cluster_detections)
-
-    # Process each category separately
-    for category, category_detections in detections_by_category.items():
-      self._processCategoryDetections(
-              scene_id, category, category_detections, timestamp
-      )
-
-    self._validateAllClustersInScene(scene_id, timestamp)
+    native_tracker = self._getNativeTracker(scene_id)
+    measurements = [
+            tracking.ClusterMeasurement(
+                    detection.get('category', 'unknown'),
+                    detection['center_of_mass']['x'],
+                    detection['center_of_mass']['y'],
+                    detection['objects_count'],
+                    detection['shape_analysis']['shape'])
+            for detection in new_cluster_detections
+    ]
+    native_tracker.track(measurements, timestamp)
+
+    for native_cluster in native_tracker.get_clusters():
+      index = native_cluster.measurement_index
+      cluster = self.memory.getByNativeId(scene_id, native_cluster.id)
+      if cluster is None:
+        if index < 0:
+          continue  # Cleared cluster which was still known to the native tracker
+        cluster = TrackedCluster(scene_id, native_cluster.id, new_cluster_detections[index])
+        self.memory.add(cluster)
+        log.debug(f"Created new cluster {cluster.uuid} "
+                        f"(scene: {scene_id}, category: {cluster.category})")
+      elif index >= 0:
+        cluster.setDetection(new_cluster_detections[index])
+      cluster.setTrackingState(native_cluster)
+
+    # Clusters dropped by the native tracker stay lost until they are archived
+    for cluster in self.memory.getClustersByScene(scene_id):
+      if not native_tracker.has_cluster(cluster.native_id):
+        cluster.state = ClusterState.LOST
 
     # Cleanup old clusters
     self.memory.cleanupOldClusters(timestamp)
     return
 
-  def _groupByCategory(self, detections: List[Dict]) -> Dict[str, List[Dict]]:
-    """Group detections by category"""
-    grouped = defaultdict(list)
-    for detection in detections:
-      category = detection.get('category', 'unknown')
-      grouped[category].append(detection)
-    return dict(grouped)
-
-  def _validateAllClustersInScene(self, scene_id: str, timestamp: float) -> None:
-    """
-    Validate all clusters in a scene and mark as missed if not recently updated.
-
-    This is the SIMPLEST and most robust approach - check every cluster
-    regardless of whether detections were found.
-
-    @param scene_id: Scene identifier
-    @param timestamp: Current processing timestamp
-    """
-    all_scene_clusters = self.memory.getClustersByScene(scene_id)
-    missed_count = 0
-
-    for cluster in all_scene_clusters:
-      # Skip already LOST clusters
-      if cluster.state == ClusterState.LOST:
-        continue
-
-      # If cluster wasn't updated this frame (last_updated < current timestamp)
-      # then mark it as missed
-      if cluster.last_updated < timestamp:
-        cluster.markMissed(timestamp)
-        missed_count += 1
-        log.debug(f"Cluster {cluster.uuid} marked as missed (not updated this frame)")
-
-    if missed_count > 0:
-      log.debug(f"Marked {missed_count} clusters as missed in scene {scene_id}")
-    return
-
-  def _processCategoryDetections(self, scene_id: str, category: str,
-                             detections: List[Dict], timestamp: float) -> None:
-    """Process detections for a specific category"""
-    # Get existing trackable clusters for this scene and category
-    existing_clusters = self.memory.getClustersByCategory(category, scene_id)
-    trackable_clusters = [
-            c for c in existing_clusters
-            if c.state in [ClusterState.NEW, ClusterState.ACTIVE,
-                                        ClusterState.STABLE, ClusterState.FADING]
-    ]
-
-    # Match detections to existing clusters
-    matches = self.matcher.match(trackable_clusters, detections)
-
-    # Track which clusters and detections were matched
-    matched_cluster_uuids: Set[str] = set()
-    matched_detection_indices: Set[int] = set()
-
-    # Update matched clusters
-    for cluster_uuid, detection_idx, similarity in matches:
-      cluster = self.memory.get(cluster_uuid)
-      if cluster:
-        detection = detections[detection_idx]
-        cluster.update(
-                centroid=detection['center_of_mass'],
-                shape_analysis=detection['shape_analysis'],
-                velocity_analysis=detection['velocity_analysis'],
-                object_ids=detection['object_ids'],
-                detection_timestamp=timestamp
-        )
-        matched_cluster_uuids.add(cluster_uuid)
-        matched_detection_indices.add(detection_idx)
-        log.debug(f"Updated cluster {cluster_uuid} (similarity: {similarity:.3f})")
-
-    # Create new clusters for unmatched detections
-    for idx, detection in enumerate(detections):
-      if idx not in matched_detection_indices:
-        new_cluster = self._createTrackedCluster(
-                scene_id, detection, timestamp
-        )
-        self.memory.add(new_cluster)
-        log.debug(f"Created new cluster {new_cluster.uuid} "
-                        f"(scene: {scene_id}, category: {category})")
-
-    # Mark unmatched existing clusters as missed
-    for cluster in trackable_clusters:
-      if cluster.uuid not in matched_cluster_uuids:
-        cluster.markMissed(timestamp)
-    return
-
-  def _createTrackedCluster(self, scene_id: str, detection: Dict,
-                       timestamp: float) -> TrackedCluster:
-    """Create new TrackedCluster from detection data"""
-    return TrackedCluster(
-            scene_id=scene_id,
-            category=detection['category'],
-            centroid=detection['center_of_mass'],
-            shape_analysis=detection['shape_analysis'],
-            velocity_analysis=detection['velocity_analysis'],
-            object_ids=detection['object_ids'],
-            dbscan_params=detection['dbscan_params'],
-            detection_timestamp=timestamp
-    )
-
   def getActiveClusters(self, scene_id: Optional[str] = None,
                    publishable_only: bool = True) -> List[TrackedCluster]:
     """
@@ -745,6 +422,9 @@ class ClusterTracker:
 
   def forceClearClustersByCategory(self, scene_id: str, category: str) -> int:
     """Force-clear all clusters for a specific scene and category."""
+    native_tracker = self._native_trackers.get(scene_id)
+    if native_tracker is not None:
+      native_tracker.clear_category(category)
     return self.memory.forceClearClustersByCategory(scene_id, category)
 
   def getStatistics(self) -> Dict:
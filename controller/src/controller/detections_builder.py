@@ -4,26 +4,50 @@
 import numpy as np
 
 from controller.scene import TripwireEvent
-from scene_common.earth_lla import convertXYZToLLA, calculateHeading
-from scene_common.geometry import DEFAULTZ, Point, Size
+from scene_common.geometry import DEFAULTZ, GeodeticTransform, Point, Rectangle, Size
 from scene_common.timestamp import get_iso_time
 
 
 def buildDetectionsDict(objects, scene):
   result_dict = {}
-  for obj in objects:
-    obj_dict = prepareObjDict(scene, obj, False)
+  geospatial = computeGeospatialData(scene, objects)
+  for idx, obj in enumerate(objects):
+    obj_dict = prepareObjDict(scene, obj, False, geospatial[idx] if geospatial is not None else None)
     result_dict[obj_dict['id']] = obj_dict
   return result_dict
 
 def buildDetectionsList(objects, scene, update_visibility=False):
   result_list = []
-  for obj in objects:
-    obj_dict = prepareObjDict(scene, obj, update_visibility)
+  geospatial = computeGeospatialData(scene, objects)
+  for idx, obj in enumerate(objects):
+    obj_dict = prepareObjDict(scene, obj, update_visibility, geospatial[idx] if geospatial is not None else None)
     result_list.append(obj_dict)
   return result_list
 
-def prepareObjDict(scene, obj, update_visibility):
+def objectVelocity(aobj):
+  velocity = aobj.velocity
+  if velocity is None:
+    velocity = Point(0, 0, 0)
+  if not velocity.is3D:
+    velocity = Point(velocity.x, velocity.y, DEFAULTZ)
+  return velocity
+
+def computeGeospatialData(scene, objects):
+  """! Converts the locations of all the objects to LLA with their headings in one
+  native call. Returns a Nx4 array of (latitude, longitude, altitude, heading), or
+  None when the scene does not output geospatial coordinates.
+  """
+  if not scene or not scene.output_lla or not objects:
+    return None
+  objects = [obj.object if isinstance(obj, TripwireEvent) else obj for obj in objects]
+  transform = getattr(scene, 'geodetic_transform', None)
+  if transform is None:
+    transform = GeodeticTransform(scene.trs_xyz_to_lla)
+  points = np.array([obj.sceneLoc.asCartesianVector for obj in objects], dtype=np.float64)
+  velocities = np.array([objectVelocity(obj).asCartesianVector for obj in objects], dtype=np.float64)
+  return transform.toLLAWithHeadings(points, velocities)
+
+def prepareObjDict(scene, obj, update_visibility, geospatial=None):
   aobj = obj
   if isinstance(obj, TripwireEvent):
     aobj = obj.object
@@ -31,11 +55,7 @@ def prepareObjDict(scene, obj, update_visibility):
 
   scene_loc_vector = aobj.sceneLoc.asCartesianVector
 
-  velocity = aobj.velocity
-  if velocity is None:
-    velocity = Point(0, 0, 0)
-  if not velocity.is3D:
-    velocity = Point(velocity.x, velocity.y, DEFAULTZ)
+  velocity = objectVelocity(aobj)
 
   obj_dict = aobj.info
   obj_dict.update({
@@ -51,10 +71,10 @@ def prepareObjDict(scene, obj, update_visibility):
     obj_dict['rotation'] = rotation
 
   if scene and scene.output_lla:
-    lat_long_alt = convertXYZToLLA(scene.trs_xyz_to_lla, scene_loc_vector)
-    obj_dict['lat_long_alt'] = lat_long_alt.tolist()
-    heading = calculateHeading(scene.trs_xyz_to_lla, aobj.sceneLoc.asCartesianVector, velocity.asCartesianVector)
-    obj_dict['heading'] = heading.tolist()
+    if geospatial is None:
+      geospatial = computeGeospatialData(scene, [aobj])[0]
+    obj_dict['lat_long_alt'] = geospatial[:3].tolist()
+    obj_dict['heading'] = float(geospatial[3])
 
   reid = aobj.reidVector
   if reid is not None:
@@ -105,8 +125,14 @@ def computeCameraBounds(scene, aobj, obj_dict):
         else:
           obj_translation = Point(obj_dict['translation'])
           obj_size = Size(obj_dict['bb_meters']['width'], obj_dict['bb_meters']['height'])
-        bounds = camera.pose.projectEstimatedBoundsToCameraPixels(obj_translation,
-                                                                  obj_size)
+        if hasattr(scene, 'cameraProjection'):
+          projection = scene.cameraProjection(camera)
+          x, y, width, height = projection.project_estimated_bounds(
+            np.array([obj_translation.asNumpyCartesian]), np.array([[obj_size.width, obj_size.height]]))[0]
+          bounds = Rectangle(origin=Point(x, y), size=(width, height))
+        else:
+          bounds = camera.pose.projectEstimatedBoundsToCameraPixels(obj_translation,
+                                                                    obj_size)
     if bounds:
       camera_bounds[cameraID] = bounds.asDict
   obj_dict['camera_bounds'] = camera_bounds
@@ -1,6 +1,7 @@
 # SPDX-FileCopyrightText: (C) 2022 - 2025 Intel Corporation
 # SPDX-License-Identifier: Apache-2.0
 
+import itertools
 import uuid
 from datetime import datetime
 
@@ -46,6 +47,8 @@ class IntelLabsTracking(Tracking):
       tracker_config.non_measurement_time_static = NON_MEASUREMENT_TIME_STATIC
 
     self.tracker = rv.tracking.MultipleObjectTracker(tracker_config)
+    # detections are referenced from the tracks through an integer handle instead of the attributes dictionary
+    self.rv_handles = itertools.count(1)
     log.info(f"Multiple Object Tracker {self.__str__()} initialized")
     log.info("Tracker config: {}".format(tracker_config))
     self.tracker.update_tracker_params(self.ref_camera_frame_rate)
@@ -79,53 +82,76 @@ class IntelLabsTracking(Tracking):
     rv_object.height = size[2]
     rv_object.yaw = sscape_object.rotation[1] if sscape_object.rotation else 0.
     rv_object.classification = self.rv_classification(sscape_object.confidence)
-    info = sscape_object.info.copy()
-    info['framecount'] = sscape_object.frameCount
-    rv_object.attributes = {
-      'info': sscape_object.uuid,
-    }
+    sscape_object.rv_handle = next(self.rv_handles)
+    rv_object.user_data = sscape_object.rv_handle
     return rv_object
 
+  def to_rv_arrays(self, sscape_objects):
+    """Convert sscape detected objects to the contiguous arrays accepted by the robot vision tracker:
+    Nx7 states (x, y, z, length, width, height, yaw), Nx2 classifications and N handles"""
+    states = np.empty((len(sscape_objects), 7))
+    confidences = np.empty(len(sscape_objects))
+    handles = np.empty(len(sscape_objects), dtype=np.int64)
+    for i, sscape_object in enumerate(sscape_objects):
+      sscape_object.uuid = str(uuid.uuid4())
+      sscape_object.rv_handle = next(self.rv_handles)
+      pt = sscape_object.sceneLoc
+      size = sscape_object.size if sscape_object.size else [DEFAULT_EDGE_LENGTH] * 3
+      yaw = sscape_object.rotation[1] if sscape_object.rotation else 0.
+      states[i] = (pt.x, pt.y, pt.z, size[0], size[1], size[2], yaw)
+      confidences[i] = 1.0 if sscape_object.confidence is None else sscape_object.confidence
+      handles[i] = sscape_object.rv_handle
+    classifications = np.stack((confidences, 1.0 - confidences), axis=1)
+    return states, classifications, handles
+
   def update_tracks(self, objects, timestamp):
-    rv_objects = [self.to_rv_object(sscape_object) for sscape_object in objects]
+    states, classifications, handles = self.to_rv_arrays(objects)
     tracking_radius = DEFAULT_TRACKING_RADIUS
     if len(objects):
       tracking_radius = sum([x.tracking_radius for x in objects]) / len(objects)
 
-    self.tracker.track(rv_objects, timestamp, distance_type=rv.tracking.DistanceType.Euclidean, distance_threshold=tracking_radius)
+    self.tracker.track(states, classifications, handles, timestamp,
+                       distance_type=rv.tracking.DistanceType.Euclidean, distance_threshold=tracking_radius)
     return
 
-  def from_tracked_object(self, tracked_object, objects):
-    """Get associated sscape object from reliable tracked object"""
-    uuid = tracked_object.attributes['info']
-    sscape_object = None
-    for obj in objects:
-      if uuid == obj.uuid:
-        sscape_object = obj
-        break
-    if not sscape_object:
-      for obj in self.all_tracker_objects:
-        if uuid == obj.uuid:
-          return obj
-
-    sscape_object.location[0].point = Point(tracked_object.x, tracked_object.y,
-                                            tracked_object.z)
-    sscape_object.velocity = Point((tracked_object.vx, tracked_object.vy, 0.0))
-
-    sscape_object.rv_id = tracked_object.id
-    found = False
+  def from_track_arrays(self, tracks, objects):
+    """Get associated sscape objects from the columnar reliable tracks, joined by the measurement index"""
+    previous_by_handle = {}
+    previous_by_rv_id = {}
     for obj in self.all_tracker_objects:
-      if hasattr(obj, 'rv_id') and sscape_object.rv_id == obj.rv_id:
-        found = True
-        sscape_object.setPrevious(obj)
+      if hasattr(obj, 'rv_handle'):
+        previous_by_handle.setdefault(obj.rv_handle, obj)
+      if hasattr(obj, 'rv_id'):
+        previous_by_rv_id.setdefault(obj.rv_id, obj)
+
+    sscape_objects = []
+    for track_id, state, handle, index in zip(tracks['id'].tolist(), tracks['state'].tolist(),
+                                              tracks['user_data'].tolist(),
+                                              tracks['measurement_index'].tolist()):
+      if index < 0:
+        # not measured in this frame, report the object of its last detection
+        previous = previous_by_handle.get(handle)
+        if previous is not None:
+          sscape_objects.append(previous)
+        continue
+
+      # state layout: x, y, vx, vy, ax, ay, z, length, width, height, yaw, w
+      sscape_object = objects[index]
+      sscape_object.location[0].point = Point(state[0], state[1], state[6])
+      sscape_object.velocity = Point((state[2], state[3], 0.0))
+
+      sscape_object.rv_id = track_id
+      previous = previous_by_rv_id.get(track_id)
+      if previous is not None:
+        sscape_object.setPrevious(previous)
         sscape_object.inferRotationFromVelocity()
-        break
-    if not found:
-      sscape_object.setGID(uuid)
+      else:
+        sscape_object.setGID(sscape_object.uuid)
 
-    self.uuid_manager.assignID(sscape_object)
+      self.uuid_manager.assignID(sscape_object)
+      sscape_objects.append(sscape_object)
 
-    return sscape_object
+    return sscape_objects
 
   def mergeAlreadyTrackedObjects(self, tracks):
     """Merge already tracked objects with current objects"""
@@ -168,10 +194,9 @@ class IntelLabsTracking(Tracking):
     """Create reliable tracks for objects detected and tracks detected"""
     when = datetime.fromtimestamp(when)
     self.update_tracks(objects, when)
-    tracked_objects = self.tracker.get_reliable_tracks()
-    self.uuid_manager.pruneInactiveTracks(tracked_objects)
-    tracks_from_detections = [self.from_tracked_object(tracked_object, objects)
-                     for tracked_object in tracked_objects]
+    tracks = self.tracker.get_reliable_track_arrays()
+    self.uuid_manager.pruneInactiveTrackIds(tracks['id'].tolist())
+    tracks_from_detections = self.from_track_arrays(tracks, objects)
 
     # Already tracked objects include moving objects from tracks consumed directly
     self.already_tracked_objects = self.mergeAlreadyTrackedObjects(already_tracked_objects)
@@ -182,14 +207,13 @@ class IntelLabsTracking(Tracking):
     """Create reliable tracks for objects from multiple cameras using batched tracking"""
     when = datetime.fromtimestamp(when)
     self.update_tracks_batched(objects_per_camera, when)
-    tracked_objects = self.tracker.get_reliable_tracks()
-    self.uuid_manager.pruneInactiveTracks(tracked_objects)
+    tracks = self.tracker.get_reliable_track_arrays()
+    self.uuid_manager.pruneInactiveTrackIds(tracks['id'].tolist())
 
-    # Flatten all objects for from_tracked_object lookup
+    # The measurement index refers to the concatenation of the camera lists
     all_objects = [obj for camera_objects in objects_per_camera for obj in camera_objects]
 
-    tracks_from_detections = [self.from_tracked_object(tracked_object, all_objects)
-                     for tracked_object in tracked_objects]
+    tracks_from_detections = self.from_track_arrays(tracks, all_objects)
 
     # Already tracked objects include moving objects from tracks consumed directly
     self.already_tracked_objects = self.mergeAlreadyTrackedObjects(already_tracked_objects)
@@ -198,7 +222,9 @@ class IntelLabsTracking(Tracking):
 
   def update_tracks_batched(self, objects_per_camera, timestamp):
     """Update tracks using batched per-camera object data"""
-    rv_objects_per_camera = []
+    states_per_camera = []
+    classifications_per_camera = []
+    handles_per_camera = []
     tracking_radius = DEFAULT_TRACKING_RADIUS
 
     # Calculate average tracking radius across all objects from all cameras
@@ -206,8 +232,10 @@ class IntelLabsTracking(Tracking):
     total_object_count = 0
 
     for camera_objects in objects_per_camera:
-      rv_camera_objects = [self.to_rv_object(sscape_object) for sscape_object in camera_objects]
-      rv_objects_per_camera.append(rv_camera_objects)
+      states, classifications, handles = self.to_rv_arrays(camera_objects)
+      states_per_camera.append(states)
+      classifications_per_camera.append(classifications)
+      handles_per_camera.append(handles)
 
       # Accumulate tracking radius sum and object count
       if len(camera_objects):
@@ -218,5 +246,6 @@ class IntelLabsTracking(Tracking):
     if total_object_count > 0:
       tracking_radius = total_tracking_radius / total_object_count
 
-    self.tracker.track(rv_objects_per_camera, timestamp, distance_type=rv.tracking.DistanceType.Euclidean, distance_threshold=tracking_radius)
+    self.tracker.track(states_per_camera, classifications_per_camera, handles_per_camera, timestamp,
+                       distance_type=rv.tracking.DistanceType.Euclidean, distance_threshold=tracking_radius)
     return
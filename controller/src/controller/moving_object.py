@@ -216,6 +216,8 @@ class MovingObject:
                                       rotation_as_matrix)).as_quat())
           self.rotation = info['rotation']
         self.orig_point = camera.pose.cameraPointToWorldPoint(Point(info['translation']))
+    elif getattr(self, '_ground_point', None) is not None:
+      self.orig_point = self._ground_point
     else:
       if camera and hasattr(camera, 'pose'):
         self.orig_point = camera.pose.cameraPointToWorldPoint(self.camLoc)
@@ -239,7 +241,18 @@ class MovingObject:
       self.mapObjectDetectionToWorld(self.info, self.first_seen, self.camera)
     return self.location[0].point
 
+  def setGroundProjection(self, bbMeters, bbShadow, baseAngle, point):
+    """Use a ground projection computed for a batch of detections instead of projecting
+    the bounding box on demand. point is the world location before the buffer size is applied."""
+    self.bbMeters, self.bbShadow, self.baseAngle = bbMeters, bbShadow, baseAngle
+    if self.size is None:
+      self.size = [self.bbMeters.width, self.bbMeters.width, self.bbMeters.height]
+    self._ground_point = point
+    return
+
   def _projectBounds(self):
+    if getattr(self, '_ground_point', None) is not None:
+      return
     if hasattr(self.camera, "pose") and self.boundingBox:
       self.bbMeters, self.bbShadow, self.baseAngle = \
         self.camera.pose.projectBounds(self.boundingBox)
@@ -9,14 +9,16 @@ import numpy as np
 import robot_vision as rv
 from scene_common import log
 from scene_common.camera import Camera
-from scene_common.earth_lla import convertLLAToECEF, calculateTRSLocal2LLAFromSurfacePoints
-from scene_common.geometry import Line, Point, Region, Tripwire
+from scene_common.earth_lla import convertLLAToECEFBatch, calculateTRSLocal2LLAFromSurfacePoints
+from scene_common.geometry import GeodeticTransform, Point, PointArray, Rectangle, Region, RegionIndex, Tripwire, segmentCrossings
 from scene_common.scene_model import SceneModel
 from scene_common.timestamp import get_epoch_time, get_iso_time
 from scene_common.transform import CameraPose
-from scene_common.mesh_util import getMeshAxisAlignedProjectionToXY, createRegionMesh, createObjectMesh
+from scene_common.options import TYPE_2
+from scene_common.mesh_util import getMeshAxisAlignedProjectionToXY, createRegionPrism, createObjectBox
 
 from controller.ilabs_tracking import IntelLabsTracking
+from controller.moving_object import MovingObject
 from controller.time_chunking import TimeChunkedIntelLabsTracking, DEFAULT_CHUNKING_INTERVAL_MS
 from controller.tracking import (MAX_UNRELIABLE_TIME,
                                  NON_MEASUREMENT_TIME_DYNAMIC,
@@ -56,7 +58,13 @@ class Scene(SceneModel):
     self.time_chunking_interval_milliseconds = time_chunking_interval_milliseconds
     self._setTracker("time_chunked_intel_labs" if time_chunking_enabled else self.DEFAULT_TRACKER)
     self._trs_xyz_to_lla = None
+    self._geodetic_transform = None
     self.use_tracker = True
+    self._undistortion_maps = {}
+    self._camera_projections = {}
+    self._region_indexes = {}
+    self._region_occupancy = {}
+    self._tripwire_segments = None
 
     # FIXME - only for backwards compatibility
     self.scale = scale
@@ -130,8 +138,53 @@ class Scene(SceneModel):
       mobj.map_translation = scene_map_translation
       mobj.map_rotation = scene_map_rotation
       objects.append(mobj)
+    self._projectDetectionsToWorld(objects, camera)
     return objects
 
+  def cameraProjection(self, camera):
+    """
+    Return the cached native projection of the camera, it is rebuilt when the pose,
+    the calibration or the viewing angle of the camera changes.
+    """
+    pose = camera.pose
+    view_angle = getattr(pose, 'angle', 0.)
+    cached = self._camera_projections.get(camera.cameraID)
+    if cached is None or cached[1] != view_angle \
+        or not cached[0].matches(pose.pose_mat, pose.intrinsics.intrinsics, pose.intrinsics.distortion):
+      projection = rv.tracking.CameraProjection(pose.pose_mat, pose.intrinsics.intrinsics,
+                                                pose.intrinsics.distortion, view_angle)
+      cached = (projection, view_angle)
+      self._camera_projections[camera.cameraID] = cached
+    return cached[0]
+
+  def _projectDetectionsToWorld(self, objects, camera):
+    """
+    Project the bounding boxes of a batch of camera detections onto the ground plane in
+    a single native call. Objects with a 3D location or a 3D bounding box keep the
+    per-object path in MovingObject.
+    """
+    batch = [obj for obj in objects
+             if isinstance(obj, MovingObject) and obj.boundingBox is not None
+             and not obj.boundingBox.origin.is3D and 'translation' not in obj.info]
+    if not batch or not hasattr(camera, 'pose'):
+      return
+
+    boxes = np.array([[obj.boundingBox.x, obj.boundingBox.y,
+                       obj.boundingBox.width, obj.boundingBox.height] for obj in batch])
+    shifts = np.array([obj.shift_type == TYPE_2 for obj in batch])
+    sizes = np.array([obj.info['size'][:2] if 'size' in obj.info
+                      else obj.size[:2] if obj.size is not None else [np.nan, np.nan]
+                      for obj in batch], dtype=float)
+    projected = self.cameraProjection(camera).project_boxes(boxes, shifts, sizes)
+
+    for idx, obj in enumerate(batch):
+      shadow = tuple(Point(*corner) for corner in projected['shadow'][idx].tolist())
+      width, height = projected['bounds'][idx].tolist()
+      bounds = Rectangle(origin=Point(shadow[3].x, 0), size=(width, height))
+      obj.setGroundProjection(bounds, shadow, float(projected['base_angle'][idx]),
+                              Point(*projected['position'][idx].tolist()))
+    return
+
   def processCameraData(self, jdata, when=None, ignoreTimeFlag=False):
     camera_id = jdata['id']
     camera = None
@@ -155,18 +208,29 @@ class Scene(SceneModel):
       return True
     for detection_type, detections in jdata['objects'].items():
       if "intrinsics" not in jdata:
-        self._convertPixelBoundingBoxesToMeters(detections, camera.pose.intrinsics.intrinsics, camera.pose.intrinsics.distortion)
+        self._convertPixelBoundingBoxesToMeters(detections, camera.pose.intrinsics.intrinsics, camera.pose.intrinsics.distortion, camera_id)
       objects = self._createMovingObjectsForDetection(detection_type, detections, when, camera)
       self._finishProcessing(detection_type, when, objects)
     return True
 
-  def _convertPixelBoundingBoxesToMeters(self, objects: list[dict], intrinsics_matrix: np.ndarray, distortion_matrix: np.ndarray) -> None:
+  def _undistortionMap(self, camera_id, intrinsics_matrix: np.ndarray, distortion_matrix: np.ndarray):
+    """
+    Return the cached undistortion map of the camera, it is rebuilt when the calibration changes.
+    """
+    undistortion_map = self._undistortion_maps.get(camera_id)
+    if undistortion_map is None or not undistortion_map.matches(intrinsics_matrix, distortion_matrix):
+      undistortion_map = rv.tracking.UndistortionMap(intrinsics_matrix, distortion_matrix)
+      self._undistortion_maps[camera_id] = undistortion_map
+    return undistortion_map
+
+  def _convertPixelBoundingBoxesToMeters(self, objects: list[dict], intrinsics_matrix: np.ndarray, distortion_matrix: np.ndarray, camera_id=None) -> None:
     """
     Convert pixel bounding boxes to meters for a batch of objects, including nested sub_detections.
 
     @param objects           List of object dictionaries containing 'bounding_box_px' to be converted
     @param intrinsics_matrix Camera intrinsics matrix as a numpy array
     @param distortion_matrix Distortion coefficients matrix as a numpy array
+    @param camera_id         Key of the cached undistortion map of the camera
     """
     if not objects or len(objects) == 0:
       return
@@ -192,9 +256,10 @@ class Scene(SceneModel):
 
     # Convert all bounding boxes in batch if there are any
     if bboxes_to_convert:
-      converted_bboxes = rv.tracking.compute_pixels_to_meter_plane_batch(
-        bboxes_to_convert, intrinsics_matrix, distortion_matrix
-      )
+      undistortion_map = self._undistortionMap(camera_id, intrinsics_matrix, distortion_matrix)
+      converted_bboxes = undistortion_map.compute_pixels_to_meter_plane(
+        np.array(bboxes_to_convert, dtype=np.float32)
+      ).tolist()
 
       # Apply converted results back to the objects
       for (bbox_type, obj_idx, key, sub_idx), (agnosticx, agnosticy, agnosticw, agnostich) in zip(bbox_mappings, converted_bboxes):
@@ -214,18 +279,25 @@ class Scene(SceneModel):
     if 'frame_rate' in jdata:
       self.ref_camera_frame_rate = min(jdata['frame_rate'], self.ref_camera_frame_rate) if self.ref_camera_frame_rate is not None else jdata["frame_rate"]
 
+    geospatial = [info for info in new if 'lat_long_alt' in info]
+    if any('translation' in info for info in geospatial):
+      log.warning("Input data must have only one of 'lat_long_alt' and 'translation'")
+      return True
+    if geospatial:
+      ecef = convertLLAToECEFBatch([info.pop('lat_long_alt') for info in geospatial])
+      for info, translation in zip(geospatial, ecef):
+        info['translation'] = translation
+
+    # All the translations are moved to the scene frame with one product
+    if new:
+      translations = np.array([Point(info['translation']).asNumpyCartesian for info in new])
+      translations = np.matmul(np.hstack([translations, np.ones((len(new), 1))]), cameraPose.pose_mat.T)
+      for info, translation in zip(new, translations):
+        info['translation'] = translation[:3]
+
     objects = []
     child_objects = []
     for info in new:
-      if 'lat_long_alt' in info:
-        if 'translation' in info:
-          log.warning("Input data must have only one of 'lat_long_alt' and 'translation'")
-          return True
-        info['translation'] = convertLLAToECEF(info.pop('lat_long_alt'))
-      translation = Point(info['translation'])
-      translation = np.hstack([translation.asNumpyCartesian, [1]])
-      translation = np.matmul(cameraPose.pose_mat, translation)
-      info['translation'] = translation[:3]
 
       # Remove reid vector from the object info as tracker does not support reid from scene hierarchy
       if 'reid' in info:
@@ -308,19 +380,11 @@ class Scene(SceneModel):
     return
 
   def _updateTripwireEvents(self, detectionType, now, curObjects):
+    crossings = self._findTripwireCrossings(curObjects)
     for key in self.tripwires:
       tripwire = self.tripwires[key]
       tripwireObjects = tripwire.objects.get(detectionType, [])
-      objects = []
-      for obj in curObjects:
-        age = now - obj.when
-        if obj.frameCount > 3 \
-           and len(obj.chain_data.publishedLocations) > 1:
-          d = tripwire.lineCrosses(Line(obj.chain_data.publishedLocations[0].as2Dxy,
-                                        obj.chain_data.publishedLocations[1].as2Dxy))
-          if d != 0:
-            event = TripwireEvent(obj, -d)
-            objects.append(event)
+      objects = crossings.get(key, [])
 
       if len(tripwireObjects) != len(objects) \
          and now - tripwire.when > DEBOUNCE_DELAY:
@@ -332,84 +396,194 @@ class Scene(SceneModel):
         self.events['objects'].append((key, tripwire))
     return
 
+  def _findTripwireCrossings(self, curObjects):
+    """
+    Test the last motion of every object against all tripwires with one native call.
+    Returns a dictionary of tripwire key to the list of TripwireEvent.
+    """
+    movers = [obj for obj in curObjects
+              if obj.frameCount > 3 and len(obj.chain_data.publishedLocations) > 1]
+    if not movers or not self.tripwires:
+      return {}
+
+    # the segments are cached until a tripwire is added, replaced or removed
+    signature = [(key, id(tripwire)) for key, tripwire in self.tripwires.items()]
+    if self._tripwire_segments is None or self._tripwire_segments[0] != signature:
+      owners = []
+      segments = []
+      for key, tripwire in self.tripwires.items():
+        tripwire_segments = tripwire.segments
+        owners.extend([key] * len(tripwire_segments))
+        segments.append(tripwire_segments)
+      self._tripwire_segments = (signature, owners, np.vstack(segments))
+    _, owners, segments = self._tripwire_segments
+
+    # Same orientation as Tripwire.lineCrosses: from the current to the previous location
+    # the locations may mix 2D and 3D points, only x and y are used
+    current = np.asarray(PointArray.fromPoints2Dxy([obj.chain_data.publishedLocations[0] for obj in movers]))
+    previous = np.asarray(PointArray.fromPoints2Dxy([obj.chain_data.publishedLocations[1] for obj in movers]))
+    motion = np.hstack([current[:, :2], previous[:, :2]])
+    crossings = {}
+    crossed = set()
+    for idx, segment, direction in segmentCrossings(motion, segments).tolist():
+      key = owners[segment]
+      # the first crossing segment of a tripwire decides the direction
+      if (idx, key) not in crossed:
+        crossed.add((idx, key))
+        crossings.setdefault(key, []).append(TripwireEvent(movers[idx], -direction))
+    return crossings
+
   def _updateRegionEvents(self, detectionType, regions, now, now_str, curObjects):
     updated = set()
-    for key in regions:
+    # When tracker is disabled, skip the frameCount check and consider all objects;
+    # otherwise, only consider objects with frameCount > 3 as reliable.
+    candidates = [obj for obj in curObjects if obj.frameCount > 3 or not self.use_tracker]
+    within = self._regionsContainingObjects(regions, candidates)
+    keys = list(regions.keys())
+    membership = np.zeros((len(keys), len(candidates)), dtype=bool)
+    for row, key in enumerate(keys):
       region = regions[key]
-      regionObjects = region.objects.get(detectionType, [])
-      objects = []
-      for obj in curObjects:
-        # When tracker is disabled, skip the frameCount check and consider all objects;
-        # otherwise, only consider objects with frameCount > 3 as reliable.
-        if (obj.frameCount > 3 or not self.use_tracker) \
-           and (region.isPointWithin(obj.sceneLoc) or self.isIntersecting(obj, region)):
-          objects.append(obj)
-
-      cur = set(x.gid for x in objects)
-      prev = set(x.gid for x in regionObjects)
-      new = cur - prev
-      old = prev - cur
-      newObjects = [x for x in objects if x.gid in new]
-      for obj in newObjects:
-        if key not in obj.chain_data.regions:
-          obj.chain_data.regions[key] = {'entered': now_str}
-          updated.add(key)
+      inside = within.get(key, ())
+      if region.compute_intersection:
+        if inside:
+          membership[row, list(inside)] = True
+        membership[row] |= self._intersectingObjects(candidates, region)
+      elif inside:
+        membership[row, list(inside)] = True
+
+    # The occupancy engine keeps the debounced occupancy and the entry times, only the
+    # regions whose membership changed are reported back
+    byGID = {str(obj.gid): obj for obj in candidates}
+    rows = {key: row for row, key in enumerate(keys)}
+    changes = self._regionOccupancy(regions).update(detectionType, now, keys,
+                                                    [str(obj.gid) for obj in candidates], membership)
+    for change in changes:
+      key = change.region
+      region = regions[key]
+      for gid in change.marked:
+        byGID[gid].chain_data.regions[key] = {'entered': now_str}
+      if change.marked:
+        updated.add(key)
 
       # For sensors add the current sensor value to any new objects
       if hasattr(region, 'value') and region.singleton_type=="environmental":
+        newObjects = [byGID[gid] for gid in change.arrived]
         for obj in newObjects:
           obj.chain_data.sensors[key] = []
         self._updateSensorObjects(key, region, newObjects)
 
-      if (len(new) or len(old)) and now - region.when > DEBOUNCE_DELAY:
-        log.debug("REGION EVENT", key, now_str, regionObjects, len(objects))
-        entered = []
-        for obj in objects:
-          if obj.gid in new and key in obj.chain_data.regions:
-            entered.append(obj)
-        if not hasattr(region, 'entered'):
-          region.entered = {}
-        region.entered[detectionType] = entered
-
-        exited = []
-        for obj in regionObjects:
-          if obj.gid in old:
-            if key in obj.chain_data.regions:
-              entered = get_epoch_time(obj.chain_data.regions[key]['entered'])
-              dwell = now - entered
-              exited.append((obj, dwell))
-            obj.chain_data.regions.pop(key, None)
-        if not hasattr(region, 'exited'):
-          region.exited = {}
-        region.exited[detectionType] = exited
-
-        region.objects[detectionType] = objects
-        updated.add(key)
-        region.when = now
-        if 'objects' not in self.events:
-          self.events['objects'] = []
-        self.events['objects'].append((key, region))
-        if len(cur) != len(prev):
-          if 'count' not in self.events:
-            self.events['count'] = []
-          self.events['count'].append((key, region))
+      if not change.fired:
+        continue
+
+      regionObjects = region.objects.get(detectionType, [])
+      objects = [candidates[idx] for idx in np.flatnonzero(membership[rows[key]])]
+      log.debug("REGION EVENT", key, now_str, regionObjects, len(objects))
+      if not hasattr(region, 'entered'):
+        region.entered = {}
+      region.entered[detectionType] = [byGID[gid] for gid in change.entered]
+
+      dwells = dict(change.exited)
+      exited = []
+      for obj in regionObjects:
+        if str(obj.gid) in dwells:
+          exited.append((obj, dwells[str(obj.gid)]))
+          obj.chain_data.regions.pop(key, None)
+      if not hasattr(region, 'exited'):
+        region.exited = {}
+      region.exited[detectionType] = exited
+
+      region.objects[detectionType] = objects
+      updated.add(key)
+      region.when = now
+      if 'objects' not in self.events:
+        self.events['objects'] = []
+      self.events['objects'].append((key, region))
+      if change.count_changed:
+        if 'count' not in self.events:
+          self.events['count'] = []
+        self.events['count'].append((key, region))
 
     return updated
 
+  def _regionOccupancy(self, regions):
+    """
+    Return the occupancy engine of a region collection. The entry holds the
+    collection so that its id cannot be reused while cached.
+    """
+    cached = self._region_occupancy.get(id(regions))
+    if cached is not None and cached[0] is regions:
+      return cached[1]
+    occupancy = rv.tracking.RegionOccupancy(DEBOUNCE_DELAY)
+    self._region_occupancy[id(regions)] = (regions, occupancy)
+    return occupancy
+
+  def _regionIndex(self, regions):
+    """
+    Return the spatial index of a region collection, it is rebuilt when the
+    collection was changed without going through _updateRegions. The entry
+    holds the collection so that its id cannot be reused while cached.
+    """
+    cached = self._region_indexes.get(id(regions))
+    index = cached[1] if cached is not None and cached[0] is regions else None
+    if index is None or len(index) != len(regions) or not all(key in index for key in regions):
+      index = RegionIndex()
+      for key, region in regions.items():
+        region.addToIndex(index, key)
+      self._region_indexes[id(regions)] = (regions, index)
+    return index
+
+  def _regionsContainingObjects(self, regions, objects):
+    """
+    Find the regions containing the scene location of each object with one
+    batched index query. Returns a dictionary of region key to the set of
+    indices of the objects within it.
+    """
+    if not regions or not objects:
+      return {}
+    index = self._regionIndex(regions)
+    # the index reads the x and y columns of the contiguous buffer directly, the
+    # locations are flattened to 2D since they may mix 2D and 3D points
+    offsets, slots = index.queryBatch(PointArray.fromPoints2Dxy([obj.sceneLoc for obj in objects]))
+    ids = index.ids
+    within = {}
+    for idx, slot in zip(np.repeat(np.arange(len(objects)), np.diff(offsets)).tolist(), slots.tolist()):
+      within.setdefault(ids[slot], set()).add(idx)
+    return within
+
+  def _regionPrism(self, region):
+    if not region.compute_intersection or region.area != Region.REGION_POLY:
+      return None
+    if region.prism is None:
+      createRegionPrism(region)
+    return region.prism
+
   def isIntersecting(self, obj, region):
-    if not region.compute_intersection:
+    prism = self._regionPrism(region)
+    if prism is None:
       return False
 
-    if region.mesh is None:
-      createRegionMesh(region)
-
     try:
-      createObjectMesh(obj)
+      box = createObjectBox(obj)
     except ValueError as e:
-      log.info(f"Error creating object mesh for intersection check: {e}")
+      log.info(f"Error creating object box for intersection check: {e}")
       return False
 
-    return obj.mesh.is_intersecting(region.mesh)
+    return bool(prism.intersectsBoxes(box.reshape(1, -1))[0])
+
+  def _intersectingObjects(self, objects, region):
+    """! Boolean mask of the objects whose box intersects the volume of the region,
+    checked in one native call instead of a mesh per object and frame."""
+    prism = self._regionPrism(region)
+    if prism is None or not objects:
+      return np.zeros(len(objects), dtype=bool)
+
+    boxes = np.full((len(objects), 10), np.nan)
+    for idx, obj in enumerate(objects):
+      try:
+        boxes[idx] = createObjectBox(obj)
+      except ValueError as e:
+        log.info(f"Error creating object box for intersection check: {e}")
+    return prism.intersectsBoxes(boxes)
 
   def _updateVisible(self, curObjects):
     """! Update the visibility of objects from cameras in the scene."""
@@ -474,6 +648,7 @@ class Scene(SceneModel):
     deleted = old - new
     for camID in deleted:
       self.cameras.pop(camID)
+      self._undistortion_maps.pop(camID, None)
     return
 
   def _updateRegions(self, existingRegions, newRegions):
@@ -492,6 +667,18 @@ class Scene(SceneModel):
     deleted = old - new
     for region_uuid in deleted:
       existingRegions.pop(region_uuid)
+
+    cached = self._region_indexes.get(id(existingRegions))
+    if cached is not None and cached[0] is existingRegions:
+      index = cached[1]
+      for regionData in newRegions:
+        existingRegions[regionData['uid']].addToIndex(index, regionData['uid'])
+      for region_uuid in deleted:
+        index.remove(region_uuid)
+    cached = self._region_occupancy.get(id(existingRegions))
+    if cached is not None and cached[0] is existingRegions:
+      for region_uuid in deleted:
+        cached[1].remove_region(region_uuid)
     return
 
   def _updateTripwires(self, newTripwires):
@@ -518,10 +705,21 @@ class Scene(SceneModel):
       self._trs_xyz_to_lla = calculateTRSLocal2LLAFromSurfacePoints(mesh_corners_xyz, self.map_corners_lla)
     return self._trs_xyz_to_lla
 
+  @property
+  def geodetic_transform(self) -> Optional[GeodeticTransform]:
+    """
+    Native batched conversion from scene coordinates to LLA built from trs_xyz_to_lla,
+    None when the scene does not output geospatial coordinates.
+    """
+    if self._geodetic_transform is None and self.trs_xyz_to_lla is not None:
+      self._geodetic_transform = GeodeticTransform(self.trs_xyz_to_lla)
+    return self._geodetic_transform
+
   def _invalidate_trs_xyz_to_lla(self):
     """
     Invalidate the cached transformation matrix from TRS to LLA coordinates.
     This method should be called when the scene geospatial mapping parameters change.
     """
     self._trs_xyz_to_lla = None
+    self._geodetic_transform = None
     return
@@ -46,7 +46,16 @@ class UUIDManager:
 
     @param  tracked_objects  The objects currently tracked by the tracker
     """
-    active_tracks = [tracked_object.id for tracked_object in tracked_objects]
+    self.pruneInactiveTrackIds([tracked_object.id for tracked_object in tracked_objects])
+    return
+
+  def pruneInactiveTrackIds(self, track_ids):
+    """
+    Removes inactive tracks from the active_ids dict and adds pending features to the database
+
+    @param  track_ids  The ids of the tracks currently tracked by the tracker
+    """
+    active_tracks = set(track_ids)
     inactive_tracks = []
     new_active_ids = {}
     with self.active_ids_lock:
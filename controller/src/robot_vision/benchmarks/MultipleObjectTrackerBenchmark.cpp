@@ -66,19 +66,19 @@ public:
         person.classification.normalize();
         
         // Kalman filter matrices for person tracking
-        person.predictedMeasurementMean = cv::Mat::zeros(7, 1, CV_64F);
-        person.predictedMeasurementMean.at<double>(0, 0) = person.x;
-        person.predictedMeasurementMean.at<double>(1, 0) = person.y;
-        person.predictedMeasurementMean.at<double>(2, 0) = person.width;
-        person.predictedMeasurementMean.at<double>(3, 0) = person.height;
-        person.predictedMeasurementMean.at<double>(4, 0) = person.vx;
-        person.predictedMeasurementMean.at<double>(5, 0) = person.vy;
-        person.predictedMeasurementMean.at<double>(6, 0) = person.yaw;
+        person.predictedMeasurementMean.setZero();
+        person.predictedMeasurementMean(0) = person.x;
+        person.predictedMeasurementMean(1) = person.y;
+        person.predictedMeasurementMean(2) = person.width;
+        person.predictedMeasurementMean(3) = person.height;
+        person.predictedMeasurementMean(4) = person.vx;
+        person.predictedMeasurementMean(5) = person.vy;
+        person.predictedMeasurementMean(6) = person.yaw;
         
         // Higher uncertainty for people (more erratic movement than vehicles)
-        person.predictedMeasurementCov = cv::Mat::eye(7, 7, CV_64F) * 0.2;
-        cv::invert(person.predictedMeasurementCov, person.predictedMeasurementCovInv);
-        person.errorCovariance = cv::Mat::eye(7, 7, CV_64F) * 0.1;
+        person.predictedMeasurementCov = rv::tracking::MeasurementCovariance::Identity() * 0.2;
+        person.predictedMeasurementCovInv = person.predictedMeasurementCov.inverse();
+        person.errorCovariance = rv::tracking::StateCovariance::Identity() * 0.1;
         
         return person;
     }
@@ -105,11 +105,11 @@ public:
                 person.vy = std::sqrt(person.vx * person.vx + person.vy * person.vy) * std::sin(person.yaw);
                 
                 // Update predicted measurement mean
-                person.predictedMeasurementMean.at<double>(0, 0) = person.x;
-                person.predictedMeasurementMean.at<double>(1, 0) = person.y;
-                person.predictedMeasurementMean.at<double>(4, 0) = person.vx;
-                person.predictedMeasurementMean.at<double>(5, 0) = person.vy;
-                person.predictedMeasurementMean.at<double>(6, 0) = person.yaw;
+                person.predictedMeasurementMean(0) = person.x;
+                person.predictedMeasurementMean(1) = person.y;
+                person.predictedMeasurementMean(4) = person.vx;
+                person.predictedMeasurementMean(5) = person.vy;
+                person.predictedMeasurementMean(6) = person.yaw;
             }
             
             people.push_back(std::move(person));
@@ -4,7 +4,12 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <vector>
 
 namespace rv {
 
@@ -26,4 +31,111 @@ std::vector<cv::Rect2f> computePixelsToMeterPlane(
     const CameraParams& params
 );
 
+/// Cached undistortion of one camera: normalized coordinates precomputed on a pixel grid and bilinearly interpolated
+///
+/// The grid covers the image, whose size defaults to twice the principal point. The cell size is halved until the
+/// interpolation error, measured against cv::undistortPoints at the cell centers and edge midpoints, is below maxError
+/// (normalized units) or the cells are one pixel wide. Points outside the grid fall back to cv::undistortPoints. Build
+/// one map per camera and rebuild it when matches() reports that the calibration changed.
+class UndistortionMap {
+public:
+    explicit UndistortionMap(const CameraParams& params, cv::Size imageSize = cv::Size(), double maxError = 1e-4,
+                             int initialCellSize = 16);
+
+    /// Check whether the map was built from the given calibration
+    bool matches(const CameraParams& params) const;
+
+    /// Undistorted normalized coordinates of a pixel
+    cv::Point2f undistort(const cv::Point2f& pixel) const;
+
+    /// Convert pixel bounding box to undistorted coordinates
+    cv::Rect2f computePixelsToMeterPlane(const cv::Rect2f& bbox) const;
+
+    /// Convert multiple pixel bounding boxes to undistorted coordinates (batch processing)
+    std::vector<cv::Rect2f> computePixelsToMeterPlane(const std::vector<cv::Rect2f>& bboxes) const;
+
+    /// Convert count boxes stored as contiguous (x, y, width, height) rows, result must not alias boxes
+    void computePixelsToMeterPlane(const float* boxes, float* result, std::size_t count) const;
+
+    /// Largest interpolation error found while building the map, in normalized units
+    double getMaxError() const { return mMaxError; }
+
+    int getCellSize() const { return mCellSize; }
+
+private:
+    void build(int cellSize);
+
+    cv::Mat mIntrinsics;            // CV_64F copies of the calibration the map was built from
+    cv::Mat mDistortion;
+    cv::Size mImageSize;
+    int mCellSize{0};
+    int mColumns{0};                // number of cells, the grid has (mColumns + 1) x (mRows + 1) nodes
+    int mRows{0};
+    std::vector<float> mGridX;      // normalized coordinates at the grid nodes, row major
+    std::vector<float> mGridY;
+    double mMaxError{0.};
+};
+
+/// Ground plane footprint of one detection box, the values CameraPose.projectBounds and
+/// MovingObject.mapObjectDetectionToWorld compute in Python
+struct GroundProjection {
+    cv::Point3d position;                 // world position handed to the tracker
+    cv::Size2d bounds;                    // metric width and height of the box
+    std::array<cv::Point3d, 4> shadow;    // far left, far right, bottom right and bottom left corners on the ground
+    double baseAngle{0.};                 // elevation of the camera seen from the bottom center of the box, in degrees
+};
+
+/// Pose and calibration of one camera, it projects whole batches of detections between the image and the ground plane
+///
+/// poseMatrix is the 4x4 (or 3x4) camera to world transform. Rays which do not hit the ground plane in front of the
+/// camera are culled at the horizon distance of the camera height, as CameraPose.cameraPointToWorldPoint does.
+class CameraProjection {
+public:
+    CameraProjection(const cv::Mat& poseMatrix, const CameraParams& params, double viewAngle = 0.,
+                     double groundHeight = 0.);
+
+    /// Check whether the projection was built from the given pose and calibration
+    bool matches(const cv::Mat& poseMatrix, const CameraParams& params) const;
+
+    /// World point of a point of the normalized image plane, intersected with the ground plane
+    cv::Point3d cameraPointToWorldPoint(const cv::Point2d& point) const;
+
+    /// World point of a 3D point in the camera coordinate system
+    cv::Point3d cameraPointToWorldPoint(const cv::Point3d& point) const;
+
+    /// Project a box of the normalized image plane
+    ///
+    /// The position is the ground point below the bottom center of the box, or the point raised by the base angle when
+    /// baseAngleShift is set (TYPE_2 objects). It is pushed away from the camera by half the mean of the object length
+    /// and width given by objectSize, NaN sizes use the box width for both.
+    GroundProjection projectBox(const cv::Rect2d& box, bool baseAngleShift = false,
+                                const cv::Vec2d& objectSize = cv::Vec2d(NAN, NAN)) const;
+
+    /// Project count boxes, baseAngleShift and objectSizes may be empty or hold one entry per box
+    std::vector<GroundProjection> projectBoxes(const std::vector<cv::Rect2d>& boxes,
+                                               const std::vector<uint8_t>& baseAngleShift = std::vector<uint8_t>(),
+                                               const std::vector<cv::Vec2d>& objectSizes = std::vector<cv::Vec2d>()) const;
+
+    /// Pixel bounds of an object with the given metric width and height standing at a world point, as
+    /// CameraPose.projectEstimatedBoundsToCameraPixels computes them
+    cv::Rect2d projectEstimatedBounds(const cv::Point3d& point, const cv::Size2d& size) const;
+
+    /// Project all bounds with a single cv::projectPoints call
+    std::vector<cv::Rect2d> projectEstimatedBounds(const std::vector<cv::Point3d>& points,
+                                                   const std::vector<cv::Size2d>& sizes) const;
+
+    cv::Point3d getTranslation() const { return mTranslation; }
+
+private:
+    std::array<double, 12> mPose;   // rows of the 3x4 camera to world transform
+    cv::Mat mIntrinsics;
+    cv::Mat mDistortion;
+    cv::Mat mRotationVector;        // world to camera transform in the form cv::projectPoints takes
+    cv::Mat mTranslationVector;
+    cv::Point3d mTranslation;       // camera position
+    double mViewAngle{0.};
+    double mGroundHeight{0.};
+    double mHorizonDistance{0.};
+};
+
 } // namespace rv
@@ -15,12 +15,18 @@
 namespace rv {
 namespace tracking {
 
-using Classification = Eigen::VectorXd;
+// Upper bound on the number of classes, the class probabilities are stored inline up to this size
+constexpr int MaxClassificationSize = 16;
+
+using Classification = Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor | Eigen::DontAlign, MaxClassificationSize, 1>;
+
+// Read-only view accepted by the classification functions, it binds to a Classification or to mapped storage
+using ClassificationRef = Eigen::Ref<const Eigen::VectorXd>;
 
 namespace classification {
-  double distance(const Classification & classificationA, const Classification & classificationB);
-  Classification combine(const Classification & classificationA, const Classification & classificationB);
-  double similarity(const Classification & classificationA, const Classification & classificationB);
+  double distance(const ClassificationRef & classificationA, const ClassificationRef & classificationB);
+  Classification combine(const ClassificationRef & classificationA, const ClassificationRef & classificationB);
+  double similarity(const ClassificationRef & classificationA, const ClassificationRef & classificationB);
 }
 
 class ClassificationData
@@ -38,6 +44,10 @@ public:
     {
       throw std::runtime_error("The classes vector is empty");
     }
+    if (classes_.size() > static_cast<std::size_t>(MaxClassificationSize))
+    {
+      throw std::runtime_error("The number of classes exceeds the maximum classification size");
+    }
   }
 
   inline std::size_t classIndex(std::string class_) const
@@ -54,9 +64,9 @@ public:
     }
   }
 
-  inline std::string getClass(const Classification & classification) const
+  inline std::string getClass(const ClassificationRef & classification) const
   {
-    if (classes.size() != classification.size())
+    if (classes.size() != static_cast<std::size_t>(classification.size()))
     {
       throw std::runtime_error("Invalid classification probability size");
     }
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rv/tracking/TrackManager.hpp"
+#include "rv/tracking/TrackedObject.hpp"
+
+namespace rv {
+namespace tracking {
+
+/**
+ * @brief Lifecycle of a tracked cluster
+ */
+enum class ClusterState
+{
+  New,    // just detected, awaiting confirmation
+  Active, // confirmed and consistently detected
+  Stable, // long-term stable presence
+  Fading, // recently missed detections
+  Lost    // not detected for an extended period, kept until it is archived
+};
+
+struct ClusterTrackerConfig
+{
+  // Gate on the distance (meters) between the predicted centroid of a cluster and a detection
+  double mMatchingDistance{5.0};
+
+  uint32_t mFramesToActivate{3};  // detections before a new cluster can be activated
+  uint32_t mFramesToStable{20};   // detections before an active cluster can be stable
+  uint32_t mFramesToFade{15};     // consecutive misses before a cluster is fading
+  uint32_t mFramesToLost{10};     // further misses before a fading cluster is lost
+
+  double mInitialConfidence{0.5};
+  double mActivationThreshold{0.6};
+  double mStabilityThreshold{0.7};
+  double mConfidenceMissPenalty{0.1};
+  double mConfidenceMaxMissPenalty{0.5};
+  double mConfidenceLongevityBonus{0.2};
+  uint32_t mConfidenceLongevityFrames{100};
+  uint32_t mStabilityWindow{10};  // detections used for the stability score
+
+  double mArchiveTime{5.0};       // seconds after its last detection a lost cluster is dropped
+
+  double mProcessNoise{1e-3};
+  double mMeasurementNoise{1e-2};
+  double mInitStateCovariance{1.};
+
+  std::string toString() const;
+};
+
+/**
+ * @brief Cluster detected in one frame
+ */
+struct ClusterMeasurement
+{
+  std::string category;
+  double x{0.};
+  double y{0.};
+  uint32_t objectCount{0u};
+  std::string shape;
+};
+
+/**
+ * @brief State of a tracked cluster
+ *
+ * The position and velocity are the filtered centroid, the object count and shape come from the last detection.
+ */
+struct TrackedCluster
+{
+  Id id{InvalidObjectId};
+  std::string category;
+  ClusterState state{ClusterState::New};
+
+  double x{0.};
+  double y{0.};
+  double vx{0.};
+  double vy{0.};
+  // Centroid extrapolated by the last frame interval
+  double predictedX{0.};
+  double predictedY{0.};
+
+  uint32_t objectCount{0u};
+  std::string shape;
+
+  double confidence{0.};
+  double stabilityScore{0.};
+  uint32_t framesDetected{0u};
+  uint32_t framesMissed{0u};
+  uint32_t totalFrames{0u};
+
+  // Timestamps in seconds
+  double firstSeen{0.};
+  double lastSeen{0.};
+  double lastUpdated{0.};
+
+  // Index of the measurement which created or updated the cluster in the last frame, -1 if it was missed
+  int64_t measurementIndex{-1};
+};
+
+/**
+ * @brief Tracks clusters of objects across frames
+ *
+ * Each category has its own TrackManager with a constant velocity MultiModelKalmanEstimator per cluster. The cluster
+ * detections of a frame are associated to the predicted centroids with the gated hungarian matcher, unmatched
+ * detections start new clusters. The TrackManager decides when a cluster is reliable and when it is dropped, which
+ * drive the New and Lost states; the confidence and stability scores drive the other transitions.
+ */
+class ClusterTracker
+{
+public:
+  ClusterTracker(const ClusterTrackerConfig &config = ClusterTrackerConfig());
+
+  /**
+   * @brief Process the cluster detections of one frame, timestamp in seconds
+   *
+   * Every category with tracked clusters is updated, the clusters of categories absent from the measurements are
+   * missed.
+   */
+  void track(const std::vector<ClusterMeasurement> &measurements, double timestamp);
+
+  /**
+   * @brief All clusters which are not archived yet, lost ones included
+   */
+  std::vector<TrackedCluster> getClusters() const;
+
+  TrackedCluster getCluster(Id id) const;
+
+  bool hasCluster(Id id) const
+  {
+    return mClusters.count(id) > 0;
+  }
+
+  /**
+   * @brief Drop the clusters of a category, returns the number of clusters which were not lost yet
+   */
+  std::size_t clearCategory(const std::string &category);
+
+  void reset();
+
+  ClusterTrackerConfig getConfig() const
+  {
+    return mConfig;
+  }
+
+private:
+  struct Observation
+  {
+    double x;
+    double y;
+    uint32_t objectCount;
+    std::string shape;
+  };
+
+  struct Cluster
+  {
+    TrackedCluster state;
+    std::deque<Observation> history; // the last mStabilityWindow detections
+  };
+
+  TrackManager &trackManager(const std::string &category);
+
+  void createCluster(TrackManager &manager, const ClusterMeasurement &measurement, int64_t index, double timestamp);
+  void updateCluster(Cluster &cluster, const TrackedObject &track, const ClusterMeasurement *measurement,
+                     int64_t index, double timestamp, bool reliable);
+  void updateConfidence(TrackedCluster &cluster) const;
+  void updateStabilityScore(Cluster &cluster) const;
+
+  ClusterTrackerConfig mConfig;
+  std::unordered_map<std::string, TrackManager> mTrackManagers; // per category
+  std::unordered_map<Id, Cluster> mClusters;
+  std::vector<Id> mOrder; // creation order of the clusters
+  Id mLastId{0};
+
+  bool mHasTimestamp{false};
+  double mLastTimestamp{0.};
+  double mLastDeltaT{0.};
+};
+
+} // namespace tracking
+} // namespace rv
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <opencv2/core.hpp>
+
+#include "rv/tracking/Classification.hpp"
+#include "rv/tracking/TrackedObject.hpp"
+
+namespace rv {
+namespace tracking {
+
+/**
+ * @brief Measurement: Detection fed to the trackers
+ *
+ * A Measurement only holds what the association and correction steps consume. It is trivially copyable and the
+ * class probabilities are stored inline, so creating one does not allocate. TrackedObject measurements are still
+ * accepted everywhere and converted with fromTrackedObject().
+ */
+struct Measurement
+{
+  static constexpr int MaxClasses = MaxClassificationSize;
+
+  Id id = InvalidObjectId;
+
+  // Position
+  double x{0.};
+  double y{0.};
+  double z{0.};
+
+  // Orientation
+  double yaw{0.};
+
+  // Size
+  double length{0.}; // along x
+  double width{0.};  // along y
+  double height{0.}; // along z
+
+  // Detection score, used to split the high and low confidence measurements
+  double score{1.};
+
+  // Class probabilities, only the first numClasses entries are valid
+  int32_t numClasses{1};
+  double classification[MaxClasses]{1.};
+
+  // Opaque handle owned by the caller
+  uint64_t userData{0};
+
+  /**
+   * @brief Read-only view of the class probabilities.
+   */
+  Eigen::Map<const Eigen::VectorXd> classificationVector() const
+  {
+    return Eigen::Map<const Eigen::VectorXd>(classification, numClasses);
+  }
+
+  /**
+   * @brief Copy the class probabilities, the score is set to the maximum probability.
+   */
+  void setClassification(const ClassificationRef &probabilities);
+
+  /**
+   * @brief Convert to a cv::Mat vector.
+   */
+  cv::Mat measurementVector() const;
+
+  /**
+   * @brief Build a new track state out of this measurement.
+   */
+  TrackedObject toTrackedObject() const;
+
+  static Measurement fromTrackedObject(const TrackedObject &object);
+};
+
+} // namespace tracking
+} // namespace rv
@@ -5,11 +5,13 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <opencv2/core.hpp>
 #include <opencv2/tracking/kalman_filters.hpp>
 #include <vector>
 #include <chrono>
 #include "rv/Utils.hpp"
+#include "rv/tracking/Measurement.hpp"
 #include "rv/tracking/TrackedObject.hpp"
 #include "rv/tracking/UnscentedKalmanFilter.hpp"
 
@@ -23,6 +25,25 @@ enum MotionModel{
   CTRV
 };
 
+/**
+ * @brief Diagnostics event emitted by the adaptive model pruning of the MultiModelKalmanEstimator
+ */
+struct ModelPruningEvent
+{
+  enum class Type
+  {
+    Pruned,     // the model probability was pinned at its minimum, the model is frozen and no longer propagated
+    Reactivated // the innovation suggested a maneuver, the model is reinstated from the combined estimate
+  };
+
+  Type type{Type::Pruned};
+  Id id{InvalidObjectId};     // id of the track
+  std::size_t model{0u};      // index of the model in the estimator
+  MotionModel motionModel{MotionModel::CV};
+  std::chrono::system_clock::time_point timestamp;
+  double innovationStatistic{0.}; // normalized innovation squared of the measurement, only set on reactivation
+};
+
 class MultiModelKalmanEstimator
 {
 public:
@@ -30,8 +51,13 @@ public:
 
   /**
    * @brief Initialize the tracker with the current state
+   *
+   * When useSquareRootFilter is set the filters propagate the cholesky factor of the covariance instead of
+   * refactoring the covariance on every step, which is more robust for long-lived tracks.
+   *
+   * dataType selects the precision of the filters (CV_64F or CV_32F), the combined state is always reported in double.
    */
-  void initialize(TrackedObject track, const std::chrono::system_clock::time_point &timestamp, double processNoise = 1e-4, double measurementNoise = 1e-2, double initStateCovariance = 1., const std::vector<MotionModel> &motionModels = std::vector<MotionModel>());
+  void initialize(TrackedObject track, const std::chrono::system_clock::time_point &timestamp, double processNoise = 1e-4, double measurementNoise = 1e-2, double initStateCovariance = 1., const std::vector<MotionModel> &motionModels = std::vector<MotionModel>(), bool useSquareRootFilter = false, int dataType = CV_64F);
 
   /**
    * @brief Set measurement and trigger tracking procedure
@@ -45,6 +71,16 @@ public:
     mLastTimestamp = timestamp;
   }
 
+  /**
+   * @brief Enable the adaptive mode, it freezes models whose probability is pinned at its minimum
+   *
+   * A model is frozen after pruningFrames consecutive corrections with a probability within 1% of the minimum
+   * probability, the most likely model is never frozen. Frozen models are not propagated, they are reinstated from the
+   * combined estimate when the normalized innovation squared of a measurement exceeds reactivationThreshold times its
+   * running average.
+   */
+  void setModelPruning(bool enabled, uint32_t pruningFrames = 30u, double reactivationThreshold = 10.);
+
   /**
    * @brief Trigger the state prediction step
    */
@@ -55,12 +91,47 @@ public:
    */
   void predict(const double deltaT);
 
+  /**
+   * @brief Extrapolate the mean of the current state and postpone the filter prediction
+   *
+   * The position is advanced with the current velocity and acceleration, the covariances are left untouched. The
+   * postponed steps are folded into a single filter prediction over the accumulated time, which runs on the next
+   * predict(), correct() or completePrediction() call.
+   */
+  void deferPrediction(const std::chrono::system_clock::time_point &timestamp);
+
+  /**
+   * @brief Extrapolate the mean of the current state and postpone the filter prediction
+   */
+  void deferPrediction(const double deltaT);
+
+  /**
+   * @brief Run the postponed filter prediction, if any
+   */
+  void completePrediction();
+
+  uint32_t getPendingPredictionFrames() const
+  {
+    return mPendingPredictionFrames;
+  }
+
   /**
    * @brief Correct the current state by measuring the current object state
    * The input is a measurement of the current state of the object.
    */
   void correct(const TrackedObject &measurement);
 
+  /**
+   * @brief Correct the current state with a compact measurement, the user data handle is taken over and the track
+   * attributes are kept
+   */
+  void correct(const Measurement &measurement);
+
+  /**
+   * @brief Correct the current state with a compact measurement and replace the track attributes
+   */
+  void correct(const Measurement &measurement, std::shared_ptr<const Attributes> attributes);
+
   /**
    * @brief Const access to the current state
    */
@@ -84,6 +155,11 @@ public:
     mLastTimestamp = timestamp;
   }
 
+  int getDataType() const
+  {
+    return mDataType;
+  }
+
   cv::Mat getKalmanFilterMeasurementCovariance(std::size_t j) const;
   cv::Mat getKalmanFilterErrorCovariance(std::size_t j) const;
 
@@ -91,6 +167,17 @@ public:
   cv::Mat getTransitionProbability() const;
   cv::Mat getConditionalProbability() const;
 
+  bool isModelActive(std::size_t j) const;
+  std::size_t getNumberOfActiveModels() const
+  {
+    return mActiveModels.size();
+  }
+
+  /**
+   * @brief Returns the pruning and reactivation events since the last call and clears them
+   */
+  std::vector<ModelPruningEvent> popModelPruningEvents();
+
 private:
   TrackedObject mCurrentState;
   std::chrono::system_clock::time_point mLastTimestamp;
@@ -98,18 +185,44 @@ private:
   /**
    * @brief Trigger the state prediction step
    */
-  void predictState(const double deltaT);
+  void predictState(double deltaT);
 
   /**
    * @brief Trigger the state prediction step
    */
-  void singleModelPredict(double deltaT);
+  void singleModelPredict(double deltaT, std::size_t model);
+
+  /**
+   * @brief Correct the current state by measuring the current object state
+   * The input is a measurement of the current state of the object.
+   */
+  void correctState(const Measurement &measurement);
 
   /**
    * @brief Correct the current state by measuring the current object state
    * The input is a measurement of the current state of the object.
    */
-  void singleModelCorrect(const TrackedObject &measurement);
+  void singleModelCorrect(const Measurement &measurement, std::size_t model);
+
+  /**
+   * @brief Transition and model probabilities restricted to the active models
+   */
+  void activeModelProbabilities(cv::Mat &transitionProbability, cv::Mat &modelProbability) const;
+
+  /**
+   * @brief Normalized innovation squared of the measurement with respect to the predicted measurement
+   */
+  double normalizedInnovationSquared(const Measurement &measurement) const;
+
+  /**
+   * @brief Freeze the models whose probability has been pinned at the minimum for mModelPruningFrames
+   */
+  void updateModelPruning();
+
+  /**
+   * @brief Reinstate all frozen models from the current combined state
+   */
+  void reactivateModels(double innovationStatistic);
 
   /**
    * @brief Combines probability coming from the three models and calculates the conditional probability
@@ -127,6 +240,16 @@ private:
                           std::vector<cv::Mat> &covarianceEstimate,
                           std::vector<cv::Mat> &stateEstimates);
 
+  /**
+   * @brief Calculates the State Estimates and the cholesky factors of the Covariance Estimates of the models from the
+   * factors of their covariances, for the square-root filters
+   */
+  static void interactionFactors(std::vector<cv::Mat> const &states,
+                                 std::vector<cv::Mat> const &covarianceFactors,
+                                 cv::Mat const &conditionalProbablity,
+                                 std::vector<cv::Mat> &covarianceFactorEstimate,
+                                 std::vector<cv::Mat> &stateEstimates);
+
   /**
    * @brief Updates the Model Probability to be used in the correction step
    */
@@ -147,6 +270,16 @@ private:
                                           cv::Mat &combinedState,
                                           cv::Mat &combinedCovariance);
 
+  /**
+   * @brief Calculates the combined state estimate and covariance estimate from the cholesky factors of the covariances
+   * of the square-root filters
+   */
+  static void combineStatesAndCovarianceFactors(std::vector<cv::Mat> const &states,
+                                                std::vector<cv::Mat> const &covarianceFactors,
+                                                cv::Mat const &modelProbability,
+                                                cv::Mat &combinedState,
+                                                cv::Mat &combinedCovariance);
+
   std::vector<TrackedObject> mSystemModelStates;
 
   int32_t mDP{0}; // Dimension of state vector
@@ -157,8 +290,24 @@ private:
   double mBeta{0.0};  // 2.0 for Gaussian distributions
   double mKappa{0.0}; // 3 - L
 
+  int mDataType{CV_64F}; // precision of the filters
+
   std::vector<cv::Ptr<cv::detail::tracking::UnscentedKalmanFilterMod>> mKalmanFilters;
   std::vector<cv::Ptr<cv::detail::tracking::UkfSystemModel>> mSystemModels;
+  cv::Ptr<cv::detail::tracking::UkfWorkspace> mWorkspace;
+  std::vector<MotionModel> mMotionModels;
+
+  bool mModelPruning{false};
+  uint32_t mModelPruningFrames{30u};
+  double mModelReactivationThreshold{10.};
+  double mInnovationAverage{0.};              // running average of the normalized innovation squared while frozen
+
+  std::vector<std::size_t> mActiveModels;     // indices of the models which are propagated
+  std::vector<uint32_t> mPinnedFrames;        // consecutive corrections with the model probability at the minimum
+  std::vector<ModelPruningEvent> mModelPruningEvents;
+
+  double mPendingDeltaT{0.};              // time accumulated by the postponed predictions
+  uint32_t mPendingPredictionFrames{0u};  // number of postponed predictions
 
   double mMaxProbability{1.};
   double mMinProbability{0.95};
@@ -3,11 +3,19 @@
 
 #pragma once
 
+#include "rv/tracking/Measurement.hpp"
 #include "rv/tracking/ObjectMatching.hpp"
 #include "rv/tracking/TrackManager.hpp"
 #include "rv/tracking/TrackedObject.hpp"
 
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace rv {
@@ -22,15 +30,19 @@ public:
   }
 
   MultipleObjectTracker(TrackManagerConfig const &config)
-    : mTrackManager(config), mDistanceType(DistanceType::MultiClassEuclidean), mDistanceThreshold(5.0)
+    : mTrackManager(config), mDistanceType(DistanceType::MultiClassEuclidean), mDistanceThreshold(5.0),
+      mSinglePrecision(config.mUseSinglePrecision)
   {
   }
 
   MultipleObjectTracker(TrackManagerConfig const &config, const DistanceType & distanceType, double distanceThreshold)
-  : mTrackManager(config), mDistanceType(distanceType),  mDistanceThreshold(distanceThreshold)
+  : mTrackManager(config), mDistanceType(distanceType),  mDistanceThreshold(distanceThreshold),
+    mSinglePrecision(config.mUseSinglePrecision)
   {
   }
 
+  ~MultipleObjectTracker();
+
   MultipleObjectTracker(const MultipleObjectTracker &) = delete;
   MultipleObjectTracker &operator=(const MultipleObjectTracker &) = delete;
   /**
@@ -73,12 +85,84 @@ public:
              const DistanceType & distanceType, double distanceThreshold,
              double scoreThreshold = 0.50);
 
+  /**
+   * @brief Sets the list of compact measurements and triggers the tracking procedure
+   *
+   * The measurements are split by their score, the track attributes are left unchanged by the correction.
+   */
+  void track(std::vector<Measurement> measurements,
+             const std::chrono::system_clock::time_point &timestamp,
+             double scoreThreshold = 0.50);
+
+  /**
+   * @brief Sets the list of compact measurements and triggers the tracking procedure
+   *
+   */
+  void track(std::vector<Measurement> measurements,
+             const std::chrono::system_clock::time_point &timestamp,
+             const DistanceType & distanceType, double distanceThreshold,
+             double scoreThreshold = 0.50);
+
+  /**
+   * @brief Sets the compact measurements from multiple cameras and triggers the tracking procedure
+   *
+   */
+  void track(std::vector<std::vector<Measurement>> measurementsPerCamera,
+             const std::chrono::system_clock::time_point &timestamp,
+             double scoreThreshold = 0.50);
+
+  /**
+   * @brief Sets the compact measurements from multiple cameras and triggers the tracking procedure
+   *
+   */
+  void track(std::vector<std::vector<Measurement>> measurementsPerCamera,
+             const std::chrono::system_clock::time_point &timestamp,
+             const DistanceType & distanceType, double distanceThreshold,
+             double scoreThreshold = 0.50);
+
+  /**
+   * @brief Runs the tracking procedure on a worker thread, the returned future completes when the tracks are updated
+   *
+   * Successive calls are processed in order by a single worker thread, started by the first call. Every other method
+   * of the tracker waits for the pending calls first, the tracker must not be used from more than one thread at a time.
+   * An exception thrown by a call is only reported through its future.
+   */
+  std::shared_future<void> trackAsync(std::vector<Measurement> measurements,
+                                      const std::chrono::system_clock::time_point &timestamp,
+                                      double scoreThreshold = 0.50);
+
+  std::shared_future<void> trackAsync(std::vector<Measurement> measurements,
+                                      const std::chrono::system_clock::time_point &timestamp,
+                                      const DistanceType & distanceType, double distanceThreshold,
+                                      double scoreThreshold = 0.50);
+
+  std::shared_future<void> trackAsync(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                      const std::chrono::system_clock::time_point &timestamp,
+                                      double scoreThreshold = 0.50);
+
+  std::shared_future<void> trackAsync(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                      const std::chrono::system_clock::time_point &timestamp,
+                                      const DistanceType & distanceType, double distanceThreshold,
+                                      double scoreThreshold = 0.50);
+
+  /**
+   * @brief Blocks until the pending asynchronous tracking calls are done, their errors are left in their futures
+   */
+  inline void waitForPendingTracking() const
+  {
+    if (mPendingTracking.valid())
+    {
+      mPendingTracking.wait();
+    }
+  }
+
   /**
    * @brief Returns a list of reliable tracked objects states
    *
    */
   inline std::vector<TrackedObject> getReliableTracks()
   {
+    waitForPendingTracking();
     return mTrackManager.getReliableTracks();
   }
 
@@ -88,15 +172,50 @@ public:
    */
   inline std::vector<TrackedObject> getTracks()
   {
+    waitForPendingTracking();
     return mTrackManager.getTracks();
   }
 
+  /**
+   * @brief Returns the index of the input measurement that corrected or created the track in the last frame, -1 if
+   * the track was not measured
+   *
+   * With measurements per camera the index refers to the concatenation of the camera lists in the given order.
+   */
+  inline int64_t getMeasurementIndex(Id id) const
+  {
+    waitForPendingTracking();
+    auto it = mMeasurementIndices.find(id);
+    return it == mMeasurementIndices.end() ? -1 : it->second;
+  }
+
+  /**
+   * @brief Returns the model pruning and reactivation events since the last call
+   *
+   */
+  inline std::vector<ModelPruningEvent> popModelPruningEvents()
+  {
+    waitForPendingTracking();
+    return mTrackManager.popModelPruningEvents();
+  }
+
+  /**
+   * @brief Returns the number of tracks whose full prediction was skipped in the last frame
+   *
+   */
+  inline size_t getNumberOfSkippedPredictions() const
+  {
+    waitForPendingTracking();
+    return mTrackManager.getNumberOfSkippedPredictions();
+  }
+
   /**
    * @brief Updates the frame-based params in mTrackManager
    *
    */
   inline void updateTrackerParams(int camera_frame_rate)
   {
+    waitForPendingTracking();
     mTrackManager.updateTrackerConfig(camera_frame_rate);
   }
 
@@ -106,6 +225,7 @@ public:
    */
   std::chrono::system_clock::time_point getTimestamp()
   {
+    waitForPendingTracking();
     return mLastTimestamp;
   }
 
@@ -113,22 +233,60 @@ private:
   TrackManager mTrackManager;
   DistanceType mDistanceType;
   double mDistanceThreshold{5.0};
+  bool mSinglePrecision{false}; // build the association cost matrices in float
 
   std::chrono::system_clock::time_point mLastTimestamp;
 
+  // input index of the measurement assigned to each track in the last frame
+  std::unordered_map<Id, int64_t> mMeasurementIndices;
+
+  // completes when the last trackAsync call is done
+  std::shared_future<void> mPendingTracking;
+
+  // the worker thread runs the queued steps in order, it keeps its OpenMP team across calls
+  std::thread mTrackingWorker;
+  std::mutex mTrackingMutex;
+  std::condition_variable mTrackingCondition;
+  std::deque<std::packaged_task<void()>> mTrackingQueue;
+  bool mStopTracking{false};
+
+  /**
+   * @brief Queue a tracking step after the pending ones
+   */
+  template <class Step> std::shared_future<void> enqueueTracking(Step step)
+  {
+    // the step is moved out of the task when it runs, so its captures are released once it is done even while its
+    // future is still held
+    std::packaged_task<void()> task([step = std::move(step)]() mutable {
+      Step running(std::move(step));
+      running();
+    });
+    mPendingTracking = task.get_future().share();
+    pushTracking(std::move(task));
+    return mPendingTracking;
+  }
+
+  void pushTracking(std::packaged_task<void()> task);
+
+  void runTrackingWorker();
+
   /**
    * @brief Helper function to match tracks with objects and update measurements
    *
-   * @param tracks Vector of tracks to match
+   * @param tracks Vector of tracks to match, the deferred tracks matched through a stale predicted measurement
+   *        covariance are refreshed and matched again
    * @param objects Vector of objects to match
+   * @param inputIndices Input index of each object, recorded for the assigned tracks
    * @param distanceType Distance calculation method
    * @param distanceThreshold Maximum distance for matching
    * @param[out] unassignedObjects Indices of objects that were not assigned to any track
    * @return Updated vector of unassigned tracks
    */
+  template <class MeasurementType>
   std::vector<tracking::TrackedObject> matchAndAssignMeasurements(
-    const std::vector<tracking::TrackedObject> &tracks,
-    const std::vector<tracking::TrackedObject> &objects,
+    std::vector<tracking::TrackedObject> tracks,
+    const std::vector<MeasurementType> &objects,
+    const std::vector<size_t> &inputIndices,
     const DistanceType &distanceType,
     double distanceThreshold,
     std::vector<size_t> &unassignedObjects);
@@ -137,19 +295,35 @@ private:
    * @brief Helper function to match tracks with objects batched from multiple cameras
    * and update measurements
    *
-   * @param tracks Vector of tracks to match
+   * @param tracks Vector of tracks to match, refreshed like in the single camera variant
    * @param[inout] objects Vector of vectors, where each inner vector contains objects from one camera
             assigned objects will be removed from each inner vector
+   * @param[inout] inputIndicesPerCamera Input index of each object, filtered along with the objects
    * @param distanceType Distance calculation method
    * @param distanceThreshold Maximum distance for matching
    * @return Updated vector of unassigned tracks
    */
+  template <class MeasurementType>
   std::vector<tracking::TrackedObject> matchAndAssignMeasurements(
-    const std::vector<tracking::TrackedObject> &tracks,
-    std::vector<std::vector<tracking::TrackedObject>> &objectsPerCamera,
+    std::vector<tracking::TrackedObject> tracks,
+    std::vector<std::vector<MeasurementType>> &objectsPerCamera,
+    std::vector<std::vector<size_t>> &inputIndicesPerCamera,
     const DistanceType &distanceType,
     double distanceThreshold);
 
+  /**
+   * @brief Tracking procedure shared by the TrackedObject and the Measurement inputs
+   */
+  template <class MeasurementType>
+  void trackObjects(std::vector<MeasurementType> objects,
+                    const std::chrono::system_clock::time_point &timestamp,
+                    const DistanceType &distanceType, double distanceThreshold, double scoreThreshold);
+
+  template <class MeasurementType>
+  void trackObjects(std::vector<std::vector<MeasurementType>> objectsPerCamera,
+                    const std::chrono::system_clock::time_point &timestamp,
+                    const DistanceType &distanceType, double distanceThreshold, double scoreThreshold);
+
 };
 } // namespace tracking
 } // namespace rv
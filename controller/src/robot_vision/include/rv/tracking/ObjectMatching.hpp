@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 
+#include "rv/tracking/Measurement.hpp"
 #include "rv/tracking/TrackedObject.hpp"
 
 namespace apollo {
@@ -27,12 +28,27 @@ enum class DistanceType
   MCEMahalanobis
 };
 
+/**
+ * @brief Associates measurements to tracks with the gated hungarian matcher
+ *
+ * When singlePrecision is set the cost matrix is stored and optimized in float.
+ */
+void match(const std::vector<TrackedObject> &tracks,
+            const std::vector<Measurement> &measurements,
+            std::vector<std::pair<size_t, size_t>> &assignments,
+            std::vector<size_t> &unassignedTracks,
+            std::vector<size_t> &unassignedMeasurements,
+            const DistanceType &distanceType, double threshold, bool singlePrecision = false);
+
+/**
+ * @brief Associates measurements given as TrackedObject to tracks
+ */
 void match(const std::vector<TrackedObject> &tracks,
             const std::vector<TrackedObject> &measurements,
             std::vector<std::pair<size_t, size_t>> &assignments,
             std::vector<size_t> &unassignedTracks,
             std::vector<size_t> &unassignedMeasurements,
-            const DistanceType &distanceType, double threshold);
+            const DistanceType &distanceType, double threshold, bool singlePrecision = false);
 
 } // namespace tracking
 } // namespace rv
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rv {
+namespace tracking {
+
+/**
+ * @brief Occupancy change of one region in one update
+ *
+ * A region is reported when tracks arrived in it or when its published occupancy changed.
+ */
+struct RegionEvent
+{
+  std::string region;
+
+  // Tracks inside the region which are not part of the published occupancy yet
+  std::vector<std::string> arrived;
+
+  // Tracks which got their entry timestamp in this update, a subset of arrived
+  std::vector<std::string> marked;
+
+  // The debounce delay elapsed and the occupancy was published, the fields below are only set in that case
+  bool fired{false};
+  std::vector<std::string> entered;
+  std::vector<std::pair<std::string, double>> exited; // track id and dwell time in seconds
+  bool countChanged{false};
+  std::size_t count{0u};
+};
+
+/**
+ * @brief Incremental region occupancy with debounced enter, exit and dwell events
+ *
+ * The published occupancy of each region and category only changes when the membership differs from it and no
+ * occupancy of the region was published in the last debounce seconds, otherwise the change stays pending. A track gets
+ * its entry timestamp the first time it is seen inside a region and keeps it until its exit is published, or until it
+ * is seen outside before its arrival was published. The dwell time is measured from that timestamp.
+ */
+class RegionOccupancy
+{
+public:
+  RegionOccupancy(double debounce = 0.5);
+
+  /**
+   * @brief Update the occupancy of the regions of one category
+   *
+   * membership is a row-major regions.size() x tracks.size() mask, membership[r * tracks.size() + t] is non-zero
+   * when track t is inside region r. Regions absent from the list keep their state.
+   */
+  std::vector<RegionEvent> update(const std::string &category,
+                                  double timestamp,
+                                  const std::vector<std::string> &regions,
+                                  const std::vector<std::string> &tracks,
+                                  const uint8_t *membership);
+
+  /**
+   * @brief Forget the occupancy and the entry timestamps of a region
+   */
+  void removeRegion(const std::string &region);
+
+  void reset()
+  {
+    mRegions.clear();
+  }
+
+  /**
+   * @brief Number of tracks of the category in the published occupancy of the region
+   */
+  std::size_t count(const std::string &region, const std::string &category) const;
+
+  /**
+   * @brief Entry timestamp of the track in the region, NaN if it has none
+   */
+  double enteredAt(const std::string &region, const std::string &track) const;
+
+  double getDebounce() const
+  {
+    return mDebounce;
+  }
+
+private:
+  struct RegionState
+  {
+    std::unordered_map<std::string, std::unordered_set<std::string>> published;       // per category
+    std::unordered_map<std::string, std::unordered_map<std::string, double>> entered; // per category and track
+    double lastPublished{-std::numeric_limits<double>::infinity()};
+  };
+
+  double mDebounce{0.5};
+  std::unordered_map<std::string, RegionState> mRegions;
+};
+
+} // namespace tracking
+} // namespace rv
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <vector>
 #include "rv/tracking/MultiModelKalmanEstimator.hpp"
+#include "rv/tracking/Measurement.hpp"
 #include "rv/tracking/TrackedObject.hpp"
 
 namespace rv {
@@ -32,6 +33,17 @@ struct TrackManagerConfig
 
   std::vector<MotionModel> mMotionModels{MotionModel::CV, MotionModel::CA, MotionModel::CTRV};
 
+  bool mUseSquareRootFilter{false};
+  bool mUseSinglePrecision{false};
+
+  bool mAdaptiveModelPruning{false};
+  uint32_t mModelPruningFrames{30};
+  double mModelReactivationThreshold{10.};
+
+  bool mLazyPrediction{false};
+  uint32_t mLazyPredictionRefreshFrames{5};
+  double mLazyPredictionGatingDistance{5.};
+
   std::string toString() const
   {
     std::string motionModelsText = " motion_models:";
@@ -60,7 +72,14 @@ struct TrackManagerConfig
       + std::to_string(mMaxUnreliableTime) + ", reactivation_frames:" + std::to_string(mReactivationFrames)
       + ", default_process_noise:" + std::to_string(mDefaultProcessNoise) + ", default_measurement_noise:"
       + std::to_string(mDefaultMeasurementNoise) + ", init_state_covariance:"
-      + std::to_string(mInitStateCovariance) + motionModelsText + ")";
+      + std::to_string(mInitStateCovariance) + motionModelsText
+      + ", use_square_root_filter:" + std::to_string(mUseSquareRootFilter)
+      + ", use_single_precision:" + std::to_string(mUseSinglePrecision)
+      + ", adaptive_model_pruning:" + std::to_string(mAdaptiveModelPruning) + ", model_pruning_frames:"
+      + std::to_string(mModelPruningFrames) + ", model_reactivation_threshold:"
+      + std::to_string(mModelReactivationThreshold) + ", lazy_prediction:" + std::to_string(mLazyPrediction)
+      + ", lazy_prediction_refresh_frames:" + std::to_string(mLazyPredictionRefreshFrames)
+      + ", lazy_prediction_gating_distance:" + std::to_string(mLazyPredictionGatingDistance) + ")";
   }
 };
 
@@ -101,6 +120,12 @@ public:
    */
   Id createTrack(TrackedObject object, const std::chrono::system_clock::time_point &timestamp);
 
+  /**
+   * @brief Create a new track out of a compact measurement
+   *
+   */
+  Id createTrack(const Measurement &measurement, const std::chrono::system_clock::time_point &timestamp);
+
   /**
    * @brief Trigger state estimation update
    *
@@ -110,9 +135,37 @@ public:
   /**
    * @brief Trigger state estimation update
    *
+   * With mLazyPrediction a track only gets its mean extrapolated, the full prediction runs when the track is a
+   * gating candidate, is corrected, is queried by id or after mLazyPredictionRefreshFrames frames.
    */
   void predict(double deltaT);
 
+  /**
+   * @brief Complete the postponed predictions of the tracks within mLazyPredictionGatingDistance of a measurement
+   *
+   */
+  void predictGatingCandidates(const std::vector<TrackedObject> &measurements);
+  void predictGatingCandidates(const std::vector<Measurement> &measurements);
+
+  /**
+   * @brief Complete the postponed predictions of the tracks at the given indices and refresh their states
+   *
+   * The deferred tracks carry the predicted measurement covariance of their last full prediction, the tracks matched
+   * through it have to be refreshed before the assignment is trusted.
+   *
+   * @return Whether any of the given tracks had a postponed prediction
+   */
+  bool completePredictions(std::vector<TrackedObject> &tracks, const std::vector<size_t> &indices);
+
+  /**
+   * @brief Number of tracks whose full prediction was skipped in the last frame
+   *
+   */
+  size_t getNumberOfSkippedPredictions() const
+  {
+    return mSkippedPredictions;
+  }
+
   /**
    * @brief Assign a measurement to an KalmanEstimator.
    *
@@ -120,6 +173,11 @@ public:
    */
   void setMeasurement(const Id &id, const TrackedObject &measurement);
 
+  /**
+   * @brief Assign a compact measurement to an KalmanEstimator, the track attributes are left unchanged
+   */
+  void setMeasurement(const Id &id, const Measurement &measurement);
+
   /**
    * @brief Triggers the correct measurements step
    *
@@ -139,7 +197,8 @@ public:
   MultiModelKalmanEstimator getKalmanEstimator(const Id &id);
 
   /**
-   * @brief Returns a list of tracked objects states
+   * @brief Returns a list of tracked objects states, the postponed predictions of the returned tracks are completed
+   * first
    *
    */
   std::vector<TrackedObject> getTracks();
@@ -148,6 +207,21 @@ public:
   std::vector<TrackedObject> getSuspendedTracks();
   std::vector<TrackedObject> getDriftingTracks();
 
+  /**
+   * @brief Returns the reliable or unreliable tracks without completing their postponed predictions
+   *
+   * The deferred tracks carry an extrapolated mean and the covariances of their last full prediction, they are meant
+   * for the association step, which refreshes the matched tracks with completePredictions().
+   */
+  std::vector<TrackedObject> getDeferredReliableTracks();
+  std::vector<TrackedObject> getDeferredUnreliableTracks();
+
+  /**
+   * @brief Returns the model pruning and reactivation events of all tracks since the last call
+   *
+   */
+  std::vector<ModelPruningEvent> popModelPruningEvents();
+
   /**
    * @brief Check wether the given Id is registered in the track manager
    *
@@ -195,7 +269,8 @@ public:
 private:
   std::unordered_map<Id, MultiModelKalmanEstimator> mKalmanEstimators;
   std::unordered_map<Id, MultiModelKalmanEstimator> mSuspendedKalmanEstimators;
-  std::unordered_map<Id, TrackedObject> mMeasurementMap;
+  std::unordered_map<Id, Measurement> mMeasurementMap;
+  std::unordered_map<Id, std::shared_ptr<const Attributes>> mMeasurementAttributes;
   std::unordered_map<Id, uint32_t> mNonMeasurementFrames;
   std::unordered_map<Id, uint32_t> mNumberOfTrackedFrames;
 
@@ -203,6 +278,16 @@ private:
 
   bool mAutoIdGeneration{true};
 
+  size_t mSkippedPredictions{0};
+
+  bool isPredictionDeferred(const MultiModelKalmanEstimator &estimator) const;
+
+  void completePendingPredictions(bool reliable);
+
+  template <class MeasurementType> void predictCandidates(const std::vector<MeasurementType> &measurements);
+
+  void correctWithMeasurement(const Id &id, MultiModelKalmanEstimator &estimator) const;
+
   TrackManagerConfig mConfig;
 };
 
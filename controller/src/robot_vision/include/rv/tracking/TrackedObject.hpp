@@ -4,10 +4,13 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
 #include <opencv2/core.hpp>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <type_traits>
 
 #include "rv/tracking/Classification.hpp"
 
@@ -16,20 +19,28 @@ namespace tracking {
 using Id = int32_t;
 constexpr Id InvalidObjectId = -1;
 
-class TrackedObject
-{
-public:
-  TrackedObject();
+using Attributes = std::unordered_map<std::string, std::string>;
 
-  static const int StateSize;
-  static const int MeasurementSize;
+constexpr int TrackedObjectStateSize = 12;
+constexpr int TrackedObjectMeasurementSize = 7;
 
-  Id id = InvalidObjectId;
+// Fixed size blocks stored by value in the tracked objects, unaligned so the objects can live in any container
+using StateVector = Eigen::Matrix<double, TrackedObjectStateSize, 1, Eigen::DontAlign>;
+using StateCovariance = Eigen::Matrix<double, TrackedObjectStateSize, TrackedObjectStateSize, Eigen::DontAlign>;
+using MeasurementVector = Eigen::Matrix<double, TrackedObjectMeasurementSize, 1, Eigen::DontAlign>;
+using MeasurementCovariance = Eigen::Matrix<double, TrackedObjectMeasurementSize, TrackedObjectMeasurementSize, Eigen::DontAlign>;
 
+/**
+ * @brief Kinematic state of a tracked object
+ *
+ * The fields follow the order of the filter state vector, so the state can be read and written as one contiguous
+ * array with state().
+ */
+struct KinematicState
+{
   // Position
   double x{0.};
   double y{0.};
-  double z{0.};
 
   // Linear Velocity
   double vx{0.};
@@ -39,31 +50,67 @@ public:
   double ax{0.};
   double ay{0.};
 
+  double z{0.};
+
+  // Size
+  double length{0.}; // along x
+  double width{0.};  // along y
+  double height{0.}; // along z
+
   // Orientation
   double yaw{0.};
-  double previousYaw{0.};
 
   // Angular velocity
   double w{0.}; // Turn rate
 
-  // Size
-  double length{0.}; // along x
-  double width{0.};  // along y
-  double height{0.}; // along z
+  Eigen::Map<StateVector> state()
+  {
+    return Eigen::Map<StateVector>(&x);
+  }
+
+  Eigen::Map<const StateVector> state() const
+  {
+    return Eigen::Map<const StateVector>(&x);
+  }
+};
+
+static_assert(std::is_standard_layout<KinematicState>::value && std::is_trivially_copyable<KinematicState>::value,
+              "KinematicState must be a plain array of doubles");
+static_assert(sizeof(KinematicState) == TrackedObjectStateSize * sizeof(double),
+              "KinematicState must not be padded");
+static_assert(offsetof(KinematicState, w) == (TrackedObjectStateSize - 1) * sizeof(double),
+              "KinematicState fields must follow the state vector order");
+
+class TrackedObject : public KinematicState
+{
+public:
+  TrackedObject();
+
+  static const int StateSize;
+  static const int MeasurementSize;
+
+  Id id = InvalidObjectId;
+
+  double previousYaw{0.};
 
   bool corrected{false};
 
   std::string toString() const;
 
   // tracked object parameters
-  cv::Mat predictedMeasurementMean;
-  cv::Mat predictedMeasurementCov;
-  cv::Mat predictedMeasurementCovInv;
-  cv::Mat errorCovariance;
+  MeasurementVector predictedMeasurementMean;
+  MeasurementCovariance predictedMeasurementCov;
+  MeasurementCovariance predictedMeasurementCovInv;
+  StateCovariance errorCovariance;
 
   Classification classification;
 
-  std::unordered_map<std::string, std::string> attributes;
+  // Opaque handle owned by the caller, carried from the last measurement without allocating
+  uint64_t userData{0};
+
+  // Free-form attributes of the last measurement, null when it had none. They are shared by the copies of the object,
+  // which never copy the map, prefer userData when only a reference back to the caller is needed
+  std::shared_ptr<const Attributes> attributes;
 
   bool isDynamic() const;
 
@@ -11,6 +11,7 @@
 #include <opencv2/tracking.hpp>
 #include <opencv2/tracking/kalman_filters.hpp>
 #include <typeinfo>
+#include <vector>
 
 namespace cv {
 namespace detail {
@@ -50,6 +51,40 @@ template <typename _Tp> bool inline choleskyDecomposition(const _Tp *A, size_t a
   return success;
 }
 
+/**
+ * @brief Scratch buffers used by UnscentedKalmanFilterMod during a single predict step.
+ *
+ * The buffers only hold intermediate results (sigma points, function values at the sigma points and their
+ * deviations from the mean), everything needed by correct() is kept by the filter itself. This allows the
+ * filters of a MultiModelKalmanEstimator to share a single workspace as long as they are not run concurrently.
+ * The buffers are allocated once and reused, so steady-state predict/correct do not allocate memory.
+ */
+struct UkfWorkspace
+{
+  Mat sigmaPoints; // set of sigma points ( x_i, i = 1..2*DP+1 ), DP x 2*DP+1
+  Mat covarianceL; // scaled cholesky factor of the covariance used to spread the sigma points, DP x DP
+
+  Mat transitionSPFuncVals;         // state function values at sigma points ( f_i ), DP x 2*DP+1
+  Mat transitionSPFuncValsCenter;   // state deviations from the estimate of state ( fc_i ), DP x 2*DP+1
+  Mat transitionSPFuncValsWeighted; // state deviations scaled by the covariance weights ( Wc[i]*fc_i ), DP x 2*DP+1
+
+  Mat measurementSPFuncVals;         // measurement function values at sigma points ( h_i ), MP x 2*DP+1
+  Mat measurementSPFuncValsCenter;   // measurement deviations from the estimate of measurement ( hc_i ), MP x 2*DP+1
+  Mat measurementSPFuncValsWeighted; // measurement deviations scaled by the covariance weights ( Wc[i]*hc_i ), MP x 2*DP+1
+
+  // Square-root variant only
+  Mat stateCompound;         // [ sqrt(Wc[i])*fc_i, i = 1..2*DP | sqrt(Q) ].t, triangularized in place, 3*DP x DP
+  Mat measurementCompound;   // [ sqrt(Wc[i])*hc_i, i = 1..2*DP | sqrt(R) ].t, triangularized in place, 2*DP+MP x MP
+  Mat correctionFactor;      // columns of the rank-1 downdates applied by correct() ( K*Sy ), DP x MP
+  Mat rankUpdateVector;      // scratch vector of the rank-1 updates, DP x 1
+  Mat householderWorkspace;  // scratch row of the householder reflections, 1 x DP
+
+  /**
+   * @brief Allocate the buffers for the given dimensions, it is a no-op if they already have the right size
+   */
+  void create(int DP, int MP, int dataType);
+};
+
 class UnscentedKalmanFilterMod : public UnscentedKalmanFilter
 {
   int DP;       // dimensionality of the state vector
@@ -57,8 +92,8 @@ class UnscentedKalmanFilterMod : public UnscentedKalmanFilter
   int CP;       // dimensionality of the control vector
   int dataType; // type of elements of vectors and matrices
 
-  Mat state;    // estimate of the system state (x*), DP x 1
-  Mat errorCov; // estimate of the state cross-covariance matrix (P), DP x DP
+  Mat state;            // estimate of the system state (x*), DP x 1
+  mutable Mat errorCov; // estimate of the state cross-covariance matrix (P), DP x DP
 
   Mat processNoiseCov;     // process noise cross-covariance matrix (Q), DP x DP
   Mat measurementNoiseCov; // measurement noise cross-covariance matrix (R), MP x MP
@@ -76,31 +111,48 @@ class UnscentedKalmanFilterMod : public UnscentedKalmanFilter
 
   // Auxillary members
   Mat measurementEstimate; // estimate of current measurement (y*), MP x 1
+  Mat innovation;          // difference between the measurement and its estimate (y - y*), MP x 1
 
-  Mat sigmaPoints; // set of sigma points ( x_i, i = 1..2*DP+1 ), DP x 2*DP+1
-
-  Mat transitionSPFuncVals;  // set of state function values at sigma points ( f_i, i = 1..2*DP+1 ), DP x 2*DP+1
-  Mat measurementSPFuncVals; // set of measurement function values at sigma points ( h_i, i = 1..2*DP+1 ), MP x 2*DP+1
-
-  Mat transitionSPFuncValsCenter;  // set of state function values at sigma points minus estimate of state ( fc_i, i =
-                                   // 1..2*DP+1 ), DP x 2*DP+1
-  Mat measurementSPFuncValsCenter; // set of measurement function values at sigma points minus estimate of measurement (
-                                   // hc_i, i = 1..2*DP+1 ), MP x 2*DP+1
+  Ptr<UkfWorkspace> workspace; // sigma points and function values, possibly shared with other filters
 
   Mat Wm; // vector of weights for estimate mean, 2*DP+1 x 1
   Mat Wc; // matrix of weights for estimate covariance, 2*DP+1 x 2*DP+1
 
-  Mat gain;  // Kalman gain matrix (K), DP x MP
-  Mat xyCov; // estimate of the covariance between x* and y* (Sxy), DP x MP
-  Mat yyCov; // estimate of the y* cross-covariance matrix (Syy), MP x MP
+  Mat gain;   // Kalman gain matrix (K), DP x MP
+  Mat xyCov;  // estimate of the covariance between x* and y* (Sxy), DP x MP
+  Mat yyCov;  // estimate of the y* cross-covariance matrix (Syy), MP x MP
+  Mat yyCovL; // cholesky factor of Syy used to compute the gain, MP x MP
 
   Mat r; // zero vector of process noise for getting transitionSPFuncVals,
   Mat q; // zero vector of measurement noise for getting measurementSPFuncVals
 
-  Mat getSigmaPoints(const Mat &mean, const Mat &covMatrix, double coef);
+  // Square-root variant: the cholesky factors are propagated with QR and rank-1 updates instead of being recomputed
+  // from the covariances. yyCov is kept up to date as Sy*Sy.t, errorCov is only formed as S*S.t when it is requested.
+  bool squareRoot;
+  mutable bool errorCovStale; // errorCov is behind errorCovL
+  Mat errorCovL;            // lower triangular factor of P ( S ), DP x DP
+  Mat processNoiseCovL;     // lower triangular factor of Q, DP x DP
+  Mat measurementNoiseCovL; // lower triangular factor of R, MP x MP
+
+  // points = [ mean, mean + coef * cholesky( covMatrix ), mean - coef * cholesky( covMatrix ) ]
+  void computeSigmaPoints(const Mat &mean, const Mat &covMatrix, double coef, Mat &points);
+
+  // points = [ mean, mean + coef * covMatrixL, mean - coef * covMatrixL ]
+  void spreadSigmaPoints(const Mat &mean, const Mat &covMatrixL, double coef, Mat &points);
+
+  template <typename _Tp> void predictImpl(const Mat &control);
+  template <typename _Tp> void correctImpl(const Mat &measurement);
+  template <typename _Tp> void predictSquareRootImpl(const Mat &control);
+  template <typename _Tp> void correctSquareRootImpl(const Mat &measurement);
+
+  // P = S*S.t if errorCov is behind errorCovL
+  void formErrorCov() const;
 
 public:
   UnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params);
+  UnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params,
+                           const Ptr<UkfWorkspace> &workspace,
+                           bool squareRoot = false);
   ~UnscentedKalmanFilterMod();
 
   // perform prediction step
@@ -111,27 +163,99 @@ public:
   // measurement - current measurement vector, MP x 1
   Mat correct(InputArray measurement) override;
 
+  // perform prediction/correction step without returning a copy of the state, the results are accessible through
+  // stateRef() and errorCovRef(). These do not allocate memory once the filter has run a first time.
+  void predictStep(const Mat &control);
+  void correctStep(const Mat &measurement);
+
+  // share the sigma point buffers with other filters of the same dimensions
+  void setWorkspace(const Ptr<UkfWorkspace> &workspace);
+
+  // true if the filter propagates the cholesky factor of the covariance (square-root UKF)
+  bool isSquareRoot() const
+  {
+    return squareRoot;
+  }
+
   //  Get system parameters
   Mat getProcessNoiseCov() const override;
   Mat getMeasurementNoiseCov() const override;
   Mat getErrorCov() const override;
   Mat getMeasurementCov() const;
 
-  void setStateAndCovariance(cv::Mat state, cv::Mat errorCov)
-  {
-    state = state.clone();
-    errorCov = errorCov.clone();
-  }
+  // overwrite the state and its covariance, the cholesky factor is recomputed in the square-root variant
+  void setStateAndCovariance(const Mat &newState, const Mat &newErrorCov);
+
+  // overwrite the state and the cholesky factor of its covariance, e.g. with the IMM mixing, square-root variant only
+  void setStateAndCovarianceFactor(const Mat &newState, const Mat &newErrorCovL);
 
   //  Get the state estimate
   Mat getState() const override;
+
+  //  Read-only access to the internal buffers, valid until the next predict/correct
+  const Mat &stateRef() const
+  {
+    return state;
+  }
+
+  const Mat &errorCovRef() const
+  {
+    formErrorCov();
+    return errorCov;
+  }
+
+  // lower triangular factor of the state covariance ( S ), square-root variant only
+  const Mat &errorCovFactorRef() const
+  {
+    return errorCovL;
+  }
+
+  const Mat &measurementCovRef() const
+  {
+    return yyCov;
+  }
+
+  const Mat &measurementEstimateRef() const
+  {
+    return measurementEstimate;
+  }
 };
 
+/**
+ * @brief Lower triangular factor of the mixture SUM_i( w_i*(S_i*S_i.t + (x_i - x)*(x_i - x).t) ) of the IMM mixing
+ *
+ * The factor is computed by a QR factorization of the weighted factors S_i and deviations x_i - x, the covariances are
+ * never formed. The weights must be non-negative, the states and factors have the type of mixedState.
+ */
+void mixCovarianceFactors(const std::vector<Mat> &states,
+                          const std::vector<Mat> &factors,
+                          const std::vector<double> &weights,
+                          const Mat &mixedState,
+                          Mat &mixedFactor);
+
+/**
+ * @brief Mixture SUM_i( w_i*(S_i*S_i.t + (x_i - x)*(x_i - x).t) ) of the IMM combination, formed as A.t*A from the same
+ * stack A of weighted factors and deviations as mixCovarianceFactors()
+ */
+void combineCovarianceFactors(const std::vector<Mat> &states,
+                              const std::vector<Mat> &factors,
+                              const std::vector<double> &weights,
+                              const Mat &combinedState,
+                              Mat &combinedCovariance);
+
 Ptr<UnscentedKalmanFilterMod> inline createUnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params)
 {
   Ptr<UnscentedKalmanFilterMod> kfu(new UnscentedKalmanFilterMod(params));
   return kfu;
 }
+
+Ptr<UnscentedKalmanFilterMod> inline createUnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params,
+                                                                    const Ptr<UkfWorkspace> &workspace,
+                                                                    bool squareRoot = false)
+{
+  Ptr<UnscentedKalmanFilterMod> kfu(new UnscentedKalmanFilterMod(params, workspace, squareRoot));
+  return kfu;
+}
 }
 }
 }
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Zero-copy conversion between cv::Mat and numpy arrays.
+ *
+ * numpy -> cv::Mat: the matrix is a header over the array buffer, it is only valid while the array is alive. Bound
+ * functions receive it for the duration of the call, they must clone() it to keep it. Writes through the matrix are
+ * visible in the array. Arrays which are not C-contiguous or have an unsupported dtype are converted (copied) to a
+ * contiguous array first, unless the argument is marked noconvert(). 1D arrays become 1xN row matrices, 3D arrays
+ * become multi-channel matrices.
+ *
+ * cv::Mat -> numpy: the array shares the matrix buffer and is read-only, since the buffer may belong to a live filter
+ * state; copy() it to get a writable array. Matrices returned by value are moved into a capsule which holds a reference
+ * on the cv::Mat data, so the array keeps the buffer alive after the owner is gone; if the owner writes the buffer in
+ * place the array sees the update. Matrices returned by reference with reference_internal keep their parent alive
+ * instead. Matrices wrapping foreign memory (no cv::UMatData) are copied since nothing would keep them valid.
+ */
+namespace rv {
+namespace python {
+
+namespace py = pybind11;
+
+inline int matDepth(const py::dtype &dtype)
+{
+  switch (dtype.num())
+  {
+  case py::detail::npy_api::NPY_UBYTE_:
+    return CV_8U;
+  case py::detail::npy_api::NPY_BYTE_:
+    return CV_8S;
+  case py::detail::npy_api::NPY_USHORT_:
+    return CV_16U;
+  case py::detail::npy_api::NPY_SHORT_:
+    return CV_16S;
+  case py::detail::npy_api::NPY_INT_:
+    return CV_32S;
+  case py::detail::npy_api::NPY_FLOAT_:
+    return CV_32F;
+  case py::detail::npy_api::NPY_DOUBLE_:
+    return CV_64F;
+  default:
+    return -1;
+  }
+}
+
+inline py::dtype numpyType(int depth)
+{
+  switch (depth)
+  {
+  case CV_8U:
+    return py::dtype::of<uint8_t>();
+  case CV_8S:
+    return py::dtype::of<int8_t>();
+  case CV_16U:
+    return py::dtype::of<uint16_t>();
+  case CV_16S:
+    return py::dtype::of<int16_t>();
+  case CV_32S:
+    return py::dtype::of<int32_t>();
+  case CV_32F:
+    return py::dtype::of<float>();
+  case CV_64F:
+    return py::dtype::of<double>();
+  default:
+    throw std::runtime_error("Unsupported cv::Mat depth " + std::to_string(depth));
+  }
+}
+
+/**
+ * @brief Check whether the array can be wrapped by a cv::Mat header without copying
+ */
+inline bool isMatCompatible(const py::array &array)
+{
+  return matDepth(array.dtype()) >= 0 && (array.flags() & py::array::c_style) && array.ndim() >= 1 && array.ndim() <= 3
+         && (array.ndim() < 3 || array.shape(2) <= CV_CN_MAX);
+}
+
+/**
+ * @brief Wrap a C-contiguous array of a supported dtype into a cv::Mat header, no data is copied
+ */
+inline cv::Mat arrayToMat(const py::array &array)
+{
+  const int depth = matDepth(array.dtype());
+  if (depth < 0)
+  {
+    throw std::runtime_error("Unsupported array dtype for cv::Mat");
+  }
+  if (!(array.flags() & py::array::c_style))
+  {
+    throw std::runtime_error("The array must be C-contiguous to be wrapped by a cv::Mat");
+  }
+
+  void *data = const_cast<void *>(array.data());
+  switch (array.ndim())
+  {
+  case 1:
+    return cv::Mat(1, static_cast<int>(array.shape(0)), depth, data);
+  case 2:
+    return cv::Mat(static_cast<int>(array.shape(0)), static_cast<int>(array.shape(1)), depth, data);
+  case 3:
+    if (array.shape(2) > CV_CN_MAX)
+    {
+      throw std::runtime_error("The third dimension of the array exceeds the maximum number of cv::Mat channels");
+    }
+    return cv::Mat(static_cast<int>(array.shape(0)), static_cast<int>(array.shape(1)),
+                   CV_MAKETYPE(depth, static_cast<int>(array.shape(2))), data);
+  default:
+    throw std::runtime_error("Input array must be 1, 2 or 3-dimensional");
+  }
+}
+
+/**
+ * @brief Expose the cv::Mat buffer as a read-only array whose lifetime is tied to base
+ */
+inline py::array matToArray(const cv::Mat &mat, py::handle base)
+{
+  if (mat.dims > 2)
+  {
+    throw std::runtime_error("Only 2D cv::Mat can be converted to numpy arrays");
+  }
+
+  std::vector<py::ssize_t> shape{mat.rows, mat.cols};
+  std::vector<py::ssize_t> strides{static_cast<py::ssize_t>(mat.step[0]), static_cast<py::ssize_t>(mat.step[1])};
+  if (mat.channels() > 1)
+  {
+    shape.push_back(mat.channels());
+    strides.push_back(static_cast<py::ssize_t>(mat.elemSize1()));
+  }
+
+  py::array array(numpyType(mat.depth()), shape, strides, mat.data, base);
+  py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  return array;
+}
+
+} // namespace python
+} // namespace rv
+
+namespace pybind11 {
+namespace detail {
+
+template <> struct type_caster<cv::Mat>
+{
+public:
+  PYBIND11_TYPE_CASTER(cv::Mat, const_name("numpy.ndarray"));
+
+  bool load(handle src, bool convert)
+  {
+    if (isinstance<pybind11::array>(src))
+    {
+      auto array = reinterpret_borrow<pybind11::array>(src);
+      if (rv::python::isMatCompatible(array))
+      {
+        mArray = array;
+        value = rv::python::arrayToMat(mArray);
+        return true;
+      }
+    }
+    if (!convert)
+    {
+      return false;
+    }
+
+    // fall back to a contiguous double copy, as the former numpy_to_mat helper did
+    auto array = array_t<double, pybind11::array::c_style | pybind11::array::forcecast>::ensure(src);
+    if (!array || !rv::python::isMatCompatible(array))
+    {
+      return false;
+    }
+    mArray = array;
+    value = rv::python::arrayToMat(mArray);
+    return true;
+  }
+
+  static handle cast(const cv::Mat &src, return_value_policy policy, handle parent)
+  {
+    if (src.empty())
+    {
+      return array_t<double>(std::vector<pybind11::ssize_t>{0, 0}).release();
+    }
+
+    if ((policy == return_value_policy::reference_internal || policy == return_value_policy::reference) && parent)
+    {
+      return rv::python::matToArray(src, parent).release();
+    }
+
+    // a cv::Mat copy shares the reference counted buffer, the capsule releases it together with the array
+    cv::Mat *owner = new cv::Mat(src.u != nullptr ? src : src.clone());
+    capsule base(owner, [](void *mat) { delete static_cast<cv::Mat *>(mat); });
+    return rv::python::matToArray(*owner, base).release();
+  }
+
+private:
+  // keeps the buffer of the loaded matrix alive for the duration of the call
+  pybind11::array mArray;
+};
+
+} // namespace detail
+} // namespace pybind11
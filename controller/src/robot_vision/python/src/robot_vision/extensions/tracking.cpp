@@ -4,36 +4,129 @@
 #include <opencv2/core.hpp>
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <rv/tracking/MultiModelKalmanEstimator.hpp>
+#include <rv/tracking/Measurement.hpp>
 #include <rv/tracking/MultipleObjectTracker.hpp>
 #include <rv/tracking/TrackManager.hpp>
 #include <rv/tracking/TrackTracker.hpp>
 #include <rv/tracking/TrackedObject.hpp>
 #include <rv/tracking/Classification.hpp>
+#include <rv/tracking/ClusterTracker.hpp>
 #include <rv/tracking/CameraUtils.hpp>
+#include <rv/tracking/RegionOccupancy.hpp>
 #include <chrono>
+#include <future>
 #include <vector>
 #include <Eigen/Dense>
 
+#include "mat_caster.hpp"
+
 namespace py = pybind11;
 
-// Helper function to convert numpy array to cv::Mat
-cv::Mat numpy_to_mat(py::array_t<double> input) {
-    py::buffer_info buf_info = input.request();
-
-    if (buf_info.ndim == 1) {
-        // Handle 1D arrays (like distortion coefficients)
-        cv::Mat mat(1, buf_info.shape[0], CV_64F, (double*)buf_info.ptr);
-        return mat.clone();
-    } else if (buf_info.ndim == 2) {
-        // Handle 2D arrays (like intrinsics matrix)
-        cv::Mat mat(buf_info.shape[0], buf_info.shape[1], CV_64F, (double*)buf_info.ptr);
-        return mat.clone();
-    } else {
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Helper function to view a numpy array as cv::Mat, the matrix shares the buffer and must not outlive the array
+cv::Mat numpy_to_mat(const DoubleArray &input) {
+    if (input.ndim() != 1 && input.ndim() != 2) {
         throw std::runtime_error("Input array must be 1-dimensional or 2-dimensional");
     }
+    return rv::python::arrayToMat(input);
+}
+
+using MeasurementArray = DoubleArray;
+using HandleArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+// Helper function to build the compact measurements out of contiguous arrays:
+// Nx7 (x, y, z, length, width, height, yaw), NxK class probabilities and N user data handles
+std::vector<rv::tracking::Measurement> arrays_to_measurements(const MeasurementArray &states,
+                                                              const MeasurementArray &classifications,
+                                                              const HandleArray &handles) {
+    if (states.ndim() != 2 || states.shape(1) != rv::tracking::TrackedObject::MeasurementSize) {
+        throw std::runtime_error("The states must be a Nx7 array of (x, y, z, length, width, height, yaw)");
+    }
+    const auto count = states.shape(0);
+    if (classifications.ndim() != 2 || classifications.shape(0) != count || classifications.shape(1) < 1
+        || classifications.shape(1) > rv::tracking::MaxClassificationSize) {
+        throw std::runtime_error("The classifications must be a NxK array with 1 <= K <= "
+                                 + std::to_string(rv::tracking::MaxClassificationSize));
+    }
+    if (handles.ndim() != 1 || handles.shape(0) != count) {
+        throw std::runtime_error("The handles must be an array of N integers");
+    }
+
+    auto state = states.unchecked<2>();
+    auto classification = classifications.unchecked<2>();
+    auto handle = handles.unchecked<1>();
+    const auto numClasses = static_cast<int>(classifications.shape(1));
+
+    std::vector<rv::tracking::Measurement> measurements(static_cast<size_t>(count));
+    for (py::ssize_t i = 0; i < count; ++i) {
+        auto &measurement = measurements[i];
+        measurement.x = state(i, 0);
+        measurement.y = state(i, 1);
+        measurement.z = state(i, 2);
+        measurement.length = state(i, 3);
+        measurement.width = state(i, 4);
+        measurement.height = state(i, 5);
+        measurement.yaw = state(i, 6);
+        measurement.setClassification(Eigen::Map<const Eigen::VectorXd>(classification.data(i, 0), numClasses));
+        measurement.userData = static_cast<uint64_t>(handle(i));
+    }
+    return measurements;
+}
+
+std::vector<std::vector<rv::tracking::Measurement>> arrays_to_measurements(const std::vector<MeasurementArray> &states,
+                                                                           const std::vector<MeasurementArray> &classifications,
+                                                                           const std::vector<HandleArray> &handles) {
+    if (classifications.size() != states.size() || handles.size() != states.size()) {
+        throw std::runtime_error("The states, classifications and handles must be given for every camera");
+    }
+
+    std::vector<std::vector<rv::tracking::Measurement>> measurementsPerCamera;
+    measurementsPerCamera.reserve(states.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        measurementsPerCamera.push_back(arrays_to_measurements(states[i], classifications[i], handles[i]));
+    }
+    return measurementsPerCamera;
+}
+
+// Helper function to lay out the tracks as columns: ids, Nx12 states in the filter order, Nx12 error covariance
+// diagonals, user data handles and the index of the input measurement assigned in the last frame (-1 if none)
+py::dict tracks_to_arrays(const rv::tracking::MultipleObjectTracker &tracker, const std::vector<rv::tracking::TrackedObject> &tracks) {
+    const auto count = static_cast<py::ssize_t>(tracks.size());
+    const py::ssize_t stateSize = rv::tracking::TrackedObject::StateSize;
+
+    py::array_t<int32_t> ids(count);
+    py::array_t<double> states({count, stateSize});
+    py::array_t<double> covariances({count, stateSize});
+    py::array_t<int64_t> handles(count);
+    py::array_t<int64_t> measurementIndices(count);
+
+    auto id = ids.mutable_unchecked<1>();
+    auto state = states.mutable_unchecked<2>();
+    auto covariance = covariances.mutable_unchecked<2>();
+    auto handle = handles.mutable_unchecked<1>();
+    auto measurementIndex = measurementIndices.mutable_unchecked<1>();
+
+    for (py::ssize_t i = 0; i < count; ++i) {
+        const auto &track = tracks[i];
+        id(i) = track.id;
+        Eigen::Map<rv::tracking::StateVector>(state.mutable_data(i, 0)) = track.state();
+        Eigen::Map<rv::tracking::StateVector>(covariance.mutable_data(i, 0)) = track.errorCovariance.diagonal();
+        handle(i) = static_cast<int64_t>(track.userData);
+        measurementIndex(i) = tracker.getMeasurementIndex(track.id);
+    }
+
+    py::dict columns;
+    columns["id"] = ids;
+    columns["state"] = states;
+    columns["covariance"] = covariances;
+    columns["user_data"] = handles;
+    columns["measurement_index"] = measurementIndices;
+    return columns;
 }
 
 PYBIND11_MODULE(tracking, tracking)
@@ -87,17 +180,67 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
     .def_readwrite("corrected", &rv::tracking::TrackedObject::corrected, "Returns True if the TrackedObject was the result of a correction step.")
     .def_readwrite("id", &rv::tracking::TrackedObject::id, "Object's identification number.")
     .def("isDynamic", &rv::tracking::TrackedObject::isDynamic, "Returns True if the TrackedObject is considered to be moving.")
-    .def_readwrite("classification", &rv::tracking::TrackedObject::classification, "Returns a numpy array with classification probabilities.")
-    .def_readwrite("attributes", &rv::tracking::TrackedObject::attributes, "Dictionary of attributes. Note: only string types are supported.")
+    .def_property("classification",
+                  [](rv::tracking::TrackedObject &object) -> rv::tracking::Classification & { return object.classification; },
+                  [](rv::tracking::TrackedObject &object, const rv::tracking::ClassificationRef &classification) {
+                    if (classification.size() < 1 || classification.size() > rv::tracking::MaxClassificationSize)
+                    {
+                      throw std::runtime_error("The classification must have between 1 and "
+                                               + std::to_string(rv::tracking::MaxClassificationSize) + " entries");
+                    }
+                    object.classification = classification;
+                  },
+                  py::return_value_policy::reference_internal, "Returns a numpy array with classification probabilities.")
+    .def_readwrite("user_data", &rv::tracking::TrackedObject::userData, "Opaque 64 bit handle owned by the caller, taken over from the last measurement.")
+    .def_property("attributes",
+                  [](const rv::tracking::TrackedObject &object) {
+                    return object.attributes ? *object.attributes : rv::tracking::Attributes();
+                  },
+                  [](rv::tracking::TrackedObject &object, rv::tracking::Attributes attributes) {
+                    object.attributes = std::make_shared<const rv::tracking::Attributes>(std::move(attributes));
+                  },
+                  "Dictionary of attributes, a copy shared by the copies of the object. Note: only string types are supported.")
     .def_property("vector",
                   &rv::tracking::TrackedObject::getVectorXf,
                   &rv::tracking::TrackedObject::setVectorXf,
                   py::return_value_policy::take_ownership, "Returns this object's state vector as numpy array.")
-    .def_readwrite("measurement_mean", &rv::tracking::TrackedObject::predictedMeasurementMean, "Returns this object's measurement vector as numpy array.")
-    .def_readwrite("measurement_covariance", &rv::tracking::TrackedObject::predictedMeasurementCov, "Measurement covariance matrix, convert to numpy using np.array(tracked_object.measurement_covariance).")
-    .def_readwrite("error_covariance", &rv::tracking::TrackedObject::errorCovariance, "Error covariance matrix, convert to numpy using np.array(tracked_object.error_covariance).")
+    .def_property("measurement_mean",
+                  [](rv::tracking::TrackedObject &object) -> rv::tracking::MeasurementVector & { return object.predictedMeasurementMean; },
+                  [](rv::tracking::TrackedObject &object, const rv::tracking::MeasurementVector &mean) { object.predictedMeasurementMean = mean; },
+                  py::return_value_policy::reference_internal,
+                  "This object's measurement vector as numpy array, a read-only view which keeps the object alive, assign a new array to change it.")
+    .def_property("measurement_covariance",
+                  [](rv::tracking::TrackedObject &object) -> rv::tracking::MeasurementCovariance & { return object.predictedMeasurementCov; },
+                  [](rv::tracking::TrackedObject &object, const rv::tracking::MeasurementCovariance &covariance) { object.predictedMeasurementCov = covariance; },
+                  py::return_value_policy::reference_internal,
+                  "Measurement covariance matrix as numpy array, a read-only view which keeps the object alive, assign a new array to change it.")
+    .def_property("error_covariance",
+                  [](rv::tracking::TrackedObject &object) -> rv::tracking::StateCovariance & { return object.errorCovariance; },
+                  [](rv::tracking::TrackedObject &object, const rv::tracking::StateCovariance &covariance) { object.errorCovariance = covariance; },
+                  py::return_value_policy::reference_internal,
+                  "Error covariance matrix as numpy array, a read-only view which keeps the object alive, assign a new array to change it.")
     .def("__repr__", &rv::tracking::TrackedObject::toString, "String representation.");
 
+  py::class_<rv::tracking::Measurement>(tracking, "Measurement",
+    "Compact detection accepted by the trackers, it holds up to 16 class probabilities and no attributes.")
+    .def(py::init<>())
+    .def(py::init(&rv::tracking::Measurement::fromTrackedObject), "Convert a TrackedObject, its attributes are dropped.", py::arg("object"))
+    .def_readwrite("id", &rv::tracking::Measurement::id, "Object's identification number.")
+    .def_readwrite("x", &rv::tracking::Measurement::x, "Position 'x' in meters.")
+    .def_readwrite("y", &rv::tracking::Measurement::y, "Position 'y' in meters.")
+    .def_readwrite("z", &rv::tracking::Measurement::z, "Position 'z' in meters.")
+    .def_readwrite("yaw", &rv::tracking::Measurement::yaw, "Orientation about Z axis in radians.")
+    .def_readwrite("length", &rv::tracking::Measurement::length, "Object's length in meters.")
+    .def_readwrite("width", &rv::tracking::Measurement::width, "Object's width in meters.")
+    .def_readwrite("height", &rv::tracking::Measurement::height, "Object's height in meters.")
+    .def_readwrite("score", &rv::tracking::Measurement::score, "Detection score, compared against the probability threshold of track().")
+    .def_readwrite("user_data", &rv::tracking::Measurement::userData, "Opaque 64 bit handle owned by the caller.")
+    .def_property("classification",
+      [](const rv::tracking::Measurement &measurement) { return Eigen::VectorXd(measurement.classificationVector()); },
+      &rv::tracking::Measurement::setClassification,
+      "Class probabilities as numpy array, setting them also sets the score to the maximum probability.")
+    .def("to_tracked_object", &rv::tracking::Measurement::toTrackedObject, "Convert to a TrackedObject.");
+
 
   py::class_<rv::tracking::MultiModelKalmanEstimator>(tracking, "MultiModelKalmanEstimator",
     "Implements the Interacting Multiple Model Kalman Estimator. The models can be selected during initialization. The method initialize() must be called before using the KalmanEstimator.")
@@ -113,22 +256,50 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
          py::arg("process_noise") = 1e-6,
          py::arg("measurement_noise") = 1e-4,
          py::arg("init_state_covariance") = 1.,
-         py::arg("motion_models") = std::vector<rv::tracking::MotionModel>())
+         py::arg("motion_models") = std::vector<rv::tracking::MotionModel>(),
+         py::arg("use_square_root_filter") = false,
+         py::arg("data_type") = CV_64F)
     .def("predict",
          py::overload_cast<double>(&rv::tracking::MultiModelKalmanEstimator::predict),
+         py::call_guard<py::gil_scoped_release>(),
          "Predict the position at T+deltaT time.",
          py::arg("deltaT"))
     .def("predict",
          py::overload_cast<const std::chrono::system_clock::time_point &>(&rv::tracking::MultiModelKalmanEstimator::predict),
+         py::call_guard<py::gil_scoped_release>(),
          "Predict the position at given timestamp.",
          py::arg("timestamp"))
+    .def("defer_prediction",
+         py::overload_cast<double>(&rv::tracking::MultiModelKalmanEstimator::deferPrediction),
+         py::call_guard<py::gil_scoped_release>(),
+         "Extrapolate the mean at T+deltaT time and postpone the filter prediction.",
+         py::arg("deltaT"))
+    .def("defer_prediction",
+         py::overload_cast<const std::chrono::system_clock::time_point &>(&rv::tracking::MultiModelKalmanEstimator::deferPrediction),
+         py::call_guard<py::gil_scoped_release>(),
+         "Extrapolate the mean at the given timestamp and postpone the filter prediction.",
+         py::arg("timestamp"))
+    .def("complete_prediction",
+         &rv::tracking::MultiModelKalmanEstimator::completePrediction,
+         py::call_guard<py::gil_scoped_release>(),
+         "Run the postponed filter prediction, if any.")
+    .def_property_readonly("pending_prediction_frames",
+         &rv::tracking::MultiModelKalmanEstimator::getPendingPredictionFrames,
+         "Number of postponed predictions.")
     .def("correct",
-         &rv::tracking::MultiModelKalmanEstimator::correct,
+         py::overload_cast<const rv::tracking::TrackedObject &>(&rv::tracking::MultiModelKalmanEstimator::correct),
+         py::call_guard<py::gil_scoped_release>(),
          "Update estimator with current measurement.",
          py::arg("measurement"))
+    .def("correct",
+         py::overload_cast<const rv::tracking::Measurement &>(&rv::tracking::MultiModelKalmanEstimator::correct),
+         py::call_guard<py::gil_scoped_release>(),
+         "Update estimator with a compact measurement, the track attributes are kept.",
+         py::arg("measurement"))
     .def("timestamp", &rv::tracking::MultiModelKalmanEstimator::getTimestamp, "Read current timestamp.")
     .def("track",
          &rv::tracking::MultiModelKalmanEstimator::track,
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp.",
          py::arg("measurement"),
          py::arg("timestamp"))
@@ -140,19 +311,200 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
          "Returns the list of internal states.")
      .def("kalman_filter_error_covariance",
           &rv::tracking::MultiModelKalmanEstimator::getKalmanFilterErrorCovariance,
-          "Get error covariance of the Nth kalman filter.", py::arg("n"))
+          "Get error covariance of the Nth kalman filter as numpy array, it shares the buffer of the filter.", py::arg("n"))
      .def("kalman_filter_measurement_covariance",
           &rv::tracking::MultiModelKalmanEstimator::getKalmanFilterMeasurementCovariance,
-          "Get measurement covariance of the Nth kalman filter.", py::arg("n"))
+          "Get measurement covariance of the Nth kalman filter as numpy array, it shares the buffer of the filter.", py::arg("n"))
      .def_property_readonly("model_probability",
           &rv::tracking::MultiModelKalmanEstimator::getModelProbability,
-          "Probability of following certain motion model.")
+          "Probability of following certain motion model, a numpy array sharing the buffer of the estimator.")
      .def_property_readonly("transition_probability",
           &rv::tracking::MultiModelKalmanEstimator::getTransitionProbability,
           "Transition probability from model a to model b.")
      .def_property_readonly("conditional_probability",
           &rv::tracking::MultiModelKalmanEstimator::getConditionalProbability,
-          "Current conditional probability from model a to model b.");
+          "Current conditional probability from model a to model b.")
+     .def("set_model_pruning",
+          &rv::tracking::MultiModelKalmanEstimator::setModelPruning,
+          "Enable the adaptive mode which freezes models pinned at the minimum probability and reinstates them on maneuvers.",
+          py::arg("enabled"),
+          py::arg("pruning_frames") = 30u,
+          py::arg("reactivation_threshold") = 10.)
+     .def("is_model_active",
+          &rv::tracking::MultiModelKalmanEstimator::isModelActive,
+          "Returns False if the Nth model is frozen by the adaptive model pruning.", py::arg("n"))
+     .def_property_readonly("number_of_active_models",
+          &rv::tracking::MultiModelKalmanEstimator::getNumberOfActiveModels,
+          "Number of models which are currently propagated.")
+     .def("pop_model_pruning_events",
+          &rv::tracking::MultiModelKalmanEstimator::popModelPruningEvents,
+          "Returns the model pruning and reactivation events since the last call.");
+
+  py::class_<rv::tracking::ModelPruningEvent> modelPruningEvent(tracking, "ModelPruningEvent",
+    "Diagnostics event emitted when the adaptive model pruning freezes or reinstates a motion model.");
+  py::enum_<rv::tracking::ModelPruningEvent::Type>(modelPruningEvent, "Type", "ModelPruningEvent type.")
+    .value("Pruned", rv::tracking::ModelPruningEvent::Type::Pruned, "The model has been frozen.")
+    .value("Reactivated", rv::tracking::ModelPruningEvent::Type::Reactivated, "The model has been reinstated.")
+    .export_values();
+  modelPruningEvent
+    .def_readonly("type", &rv::tracking::ModelPruningEvent::type, "Event type.")
+    .def_readonly("id", &rv::tracking::ModelPruningEvent::id, "Id of the track.")
+    .def_readonly("model", &rv::tracking::ModelPruningEvent::model, "Index of the model in the estimator.")
+    .def_readonly("motion_model", &rv::tracking::ModelPruningEvent::motionModel, "Motion model of the model.")
+    .def_readonly("timestamp", &rv::tracking::ModelPruningEvent::timestamp, "Timestamp of the event.")
+    .def_readonly("innovation_statistic", &rv::tracking::ModelPruningEvent::innovationStatistic,
+      "Normalized innovation squared which triggered a reactivation.");
+
+  py::class_<rv::tracking::RegionEvent>(tracking, "RegionEvent",
+    "Occupancy change of one region, reported when tracks arrived in it or when its published occupancy changed.")
+    .def_readonly("region", &rv::tracking::RegionEvent::region, "Id of the region.")
+    .def_readonly("arrived", &rv::tracking::RegionEvent::arrived,
+      "Tracks inside the region which are not part of the published occupancy yet.")
+    .def_readonly("marked", &rv::tracking::RegionEvent::marked,
+      "Tracks which got their entry timestamp in this update.")
+    .def_readonly("fired", &rv::tracking::RegionEvent::fired,
+      "Whether the debounce delay elapsed and the occupancy was published.")
+    .def_readonly("entered", &rv::tracking::RegionEvent::entered, "Published entries.")
+    .def_readonly("exited", &rv::tracking::RegionEvent::exited, "Published exits as (track, dwell seconds).")
+    .def_readonly("count_changed", &rv::tracking::RegionEvent::countChanged,
+      "Whether the published number of tracks changed.")
+    .def_readonly("count", &rv::tracking::RegionEvent::count, "Published number of tracks.");
+
+  py::class_<rv::tracking::RegionOccupancy>(tracking, "RegionOccupancy",
+    "Incremental region occupancy with debounced enter, exit and dwell events.")
+    .def(py::init<double>(), py::arg("debounce") = 0.5)
+    .def("update",
+         [](rv::tracking::RegionOccupancy &occupancy, const std::string &category, double timestamp,
+            const std::vector<std::string> &regions, const std::vector<std::string> &tracks,
+            const py::array_t<uint8_t, py::array::c_style | py::array::forcecast> &membership) {
+           if (static_cast<std::size_t>(membership.size()) != regions.size() * tracks.size()
+               || (membership.size() != 0 && (membership.ndim() != 2
+                   || static_cast<std::size_t>(membership.shape(0)) != regions.size())))
+           {
+             throw std::runtime_error("The membership must be a regions x tracks mask");
+           }
+           py::gil_scoped_release release;
+           return occupancy.update(category, timestamp, regions, tracks, membership.data());
+         },
+         "Update the occupancy of the regions of one category from a regions x tracks boolean membership mask, returns "
+         "the RegionEvent of the regions which changed.",
+         py::arg("category"),
+         py::arg("timestamp"),
+         py::arg("regions"),
+         py::arg("tracks"),
+         py::arg("membership"))
+    .def("remove_region", &rv::tracking::RegionOccupancy::removeRegion,
+         "Forget the occupancy and the entry timestamps of a region.", py::arg("region"))
+    .def("reset", &rv::tracking::RegionOccupancy::reset, "Forget all regions.")
+    .def("count", &rv::tracking::RegionOccupancy::count,
+         "Number of tracks of the category in the published occupancy of the region.",
+         py::arg("region"), py::arg("category"))
+    .def("entered_at", &rv::tracking::RegionOccupancy::enteredAt,
+         "Entry timestamp of the track in the region, NaN if it has none.", py::arg("region"), py::arg("track"))
+    .def_property_readonly("debounce", &rv::tracking::RegionOccupancy::getDebounce, "Debounce delay in seconds.");
+
+  py::enum_<rv::tracking::ClusterState>(tracking, "ClusterState", "Lifecycle of a tracked cluster.")
+    .value("New", rv::tracking::ClusterState::New, "Just detected, awaiting confirmation.")
+    .value("Active", rv::tracking::ClusterState::Active, "Confirmed and consistently detected.")
+    .value("Stable", rv::tracking::ClusterState::Stable, "Long-term stable presence.")
+    .value("Fading", rv::tracking::ClusterState::Fading, "Recently missed detections.")
+    .value("Lost", rv::tracking::ClusterState::Lost, "Not detected for an extended period, kept until it is archived.")
+    .export_values();
+
+  py::class_<rv::tracking::ClusterTrackerConfig>(tracking, "ClusterTrackerConfig",
+    "Holds all the configuration parameters used by the ClusterTracker.")
+    .def(py::init<>(), "Initialize ClusterTrackerConfig with default parameters.")
+    .def_readwrite("matching_distance", &rv::tracking::ClusterTrackerConfig::mMatchingDistance,
+     "Maximum distance (meters) between the predicted centroid of a cluster and a detection to match them.")
+    .def_readwrite("frames_to_activate", &rv::tracking::ClusterTrackerConfig::mFramesToActivate,
+     "Number of detections before a new cluster can be activated.")
+    .def_readwrite("frames_to_stable", &rv::tracking::ClusterTrackerConfig::mFramesToStable,
+     "Number of detections before an active cluster can be stable.")
+    .def_readwrite("frames_to_fade", &rv::tracking::ClusterTrackerConfig::mFramesToFade,
+     "Number of consecutive misses before a cluster is fading.")
+    .def_readwrite("frames_to_lost", &rv::tracking::ClusterTrackerConfig::mFramesToLost,
+     "Number of further misses before a fading cluster is lost.")
+    .def_readwrite("initial_confidence", &rv::tracking::ClusterTrackerConfig::mInitialConfidence,
+     "Confidence of a new cluster.")
+    .def_readwrite("activation_threshold", &rv::tracking::ClusterTrackerConfig::mActivationThreshold,
+     "Confidence above which a new cluster is activated.")
+    .def_readwrite("stability_threshold", &rv::tracking::ClusterTrackerConfig::mStabilityThreshold,
+     "Stability score above which an active cluster is stable.")
+    .def_readwrite("confidence_miss_penalty", &rv::tracking::ClusterTrackerConfig::mConfidenceMissPenalty,
+     "Confidence penalty per consecutive missed frame.")
+    .def_readwrite("confidence_max_miss_penalty", &rv::tracking::ClusterTrackerConfig::mConfidenceMaxMissPenalty,
+     "Maximum confidence penalty for the missed frames.")
+    .def_readwrite("confidence_longevity_bonus", &rv::tracking::ClusterTrackerConfig::mConfidenceLongevityBonus,
+     "Maximum confidence bonus for long-lived clusters.")
+    .def_readwrite("confidence_longevity_frames", &rv::tracking::ClusterTrackerConfig::mConfidenceLongevityFrames,
+     "Number of detections giving the full longevity bonus.")
+    .def_readwrite("stability_window", &rv::tracking::ClusterTrackerConfig::mStabilityWindow,
+     "Number of recent detections used for the stability score.")
+    .def_readwrite("archive_time", &rv::tracking::ClusterTrackerConfig::mArchiveTime,
+     "Time (seconds) after its last detection a lost cluster is dropped.")
+    .def_readwrite("process_noise", &rv::tracking::ClusterTrackerConfig::mProcessNoise,
+     "Process noise of the centroid Kalman estimators.")
+    .def_readwrite("measurement_noise", &rv::tracking::ClusterTrackerConfig::mMeasurementNoise,
+     "Measurement noise of the centroid Kalman estimators.")
+    .def_readwrite("init_state_covariance", &rv::tracking::ClusterTrackerConfig::mInitStateCovariance,
+     "Init state covariance of the centroid Kalman estimators.")
+    .def("__repr__", &rv::tracking::ClusterTrackerConfig::toString, "String representation");
+
+  py::class_<rv::tracking::ClusterMeasurement>(tracking, "ClusterMeasurement", "Cluster detected in one frame.")
+    .def(py::init<>())
+    .def(py::init([](const std::string &category, double x, double y, uint32_t objectCount, const std::string &shape) {
+           return rv::tracking::ClusterMeasurement{category, x, y, objectCount, shape};
+         }),
+         py::arg("category"), py::arg("x"), py::arg("y"), py::arg("object_count") = 0u, py::arg("shape") = "")
+    .def_readwrite("category", &rv::tracking::ClusterMeasurement::category, "Category of the clustered objects.")
+    .def_readwrite("x", &rv::tracking::ClusterMeasurement::x, "Centroid x coordinate.")
+    .def_readwrite("y", &rv::tracking::ClusterMeasurement::y, "Centroid y coordinate.")
+    .def_readwrite("object_count", &rv::tracking::ClusterMeasurement::objectCount, "Number of clustered objects.")
+    .def_readwrite("shape", &rv::tracking::ClusterMeasurement::shape, "Shape of the cluster.");
+
+  py::class_<rv::tracking::TrackedCluster>(tracking, "TrackedCluster", "State of a tracked cluster.")
+    .def_readonly("id", &rv::tracking::TrackedCluster::id, "Id of the cluster.")
+    .def_readonly("category", &rv::tracking::TrackedCluster::category, "Category of the clustered objects.")
+    .def_readonly("state", &rv::tracking::TrackedCluster::state, "ClusterState of the cluster.")
+    .def_readonly("x", &rv::tracking::TrackedCluster::x, "Filtered centroid x coordinate.")
+    .def_readonly("y", &rv::tracking::TrackedCluster::y, "Filtered centroid y coordinate.")
+    .def_readonly("vx", &rv::tracking::TrackedCluster::vx, "Centroid velocity along x.")
+    .def_readonly("vy", &rv::tracking::TrackedCluster::vy, "Centroid velocity along y.")
+    .def_readonly("predicted_x", &rv::tracking::TrackedCluster::predictedX,
+      "Centroid x coordinate extrapolated by the last frame interval.")
+    .def_readonly("predicted_y", &rv::tracking::TrackedCluster::predictedY,
+      "Centroid y coordinate extrapolated by the last frame interval.")
+    .def_readonly("object_count", &rv::tracking::TrackedCluster::objectCount,
+      "Number of clustered objects in the last detection.")
+    .def_readonly("shape", &rv::tracking::TrackedCluster::shape, "Shape of the last detection.")
+    .def_readonly("confidence", &rv::tracking::TrackedCluster::confidence, "Confidence score in [0, 1].")
+    .def_readonly("stability_score", &rv::tracking::TrackedCluster::stabilityScore, "Stability score in [0, 1].")
+    .def_readonly("frames_detected", &rv::tracking::TrackedCluster::framesDetected, "Number of detections.")
+    .def_readonly("frames_missed", &rv::tracking::TrackedCluster::framesMissed, "Number of consecutive misses.")
+    .def_readonly("total_frames", &rv::tracking::TrackedCluster::totalFrames, "Number of frames since its creation.")
+    .def_readonly("first_seen", &rv::tracking::TrackedCluster::firstSeen, "Timestamp of the first detection.")
+    .def_readonly("last_seen", &rv::tracking::TrackedCluster::lastSeen, "Timestamp of the last detection.")
+    .def_readonly("last_updated", &rv::tracking::TrackedCluster::lastUpdated, "Timestamp of the last update.")
+    .def_readonly("measurement_index", &rv::tracking::TrackedCluster::measurementIndex,
+      "Index of the measurement which created or updated the cluster in the last frame, -1 if it was missed.");
+
+  py::class_<rv::tracking::ClusterTracker>(tracking, "ClusterTracker",
+    "Tracks clusters of objects across frames with a constant velocity Kalman estimator per cluster.")
+    .def(py::init<const rv::tracking::ClusterTrackerConfig &>(),
+         py::arg("config") = rv::tracking::ClusterTrackerConfig())
+    .def("track", &rv::tracking::ClusterTracker::track, py::call_guard<py::gil_scoped_release>(),
+         "Process the cluster detections of one frame, timestamp in seconds.",
+         py::arg("measurements"), py::arg("timestamp"))
+    .def("get_clusters", &rv::tracking::ClusterTracker::getClusters,
+         "Returns all clusters which are not archived yet, lost ones included, in creation order.")
+    .def("get_cluster", &rv::tracking::ClusterTracker::getCluster, "Returns the cluster with the given id.",
+         py::arg("id"))
+    .def("has_cluster", &rv::tracking::ClusterTracker::hasCluster, "Whether the cluster is tracked.", py::arg("id"))
+    .def("clear_category", &rv::tracking::ClusterTracker::clearCategory,
+         "Drop the clusters of a category, returns the number of clusters which were not lost yet.",
+         py::arg("category"))
+    .def("reset", &rv::tracking::ClusterTracker::reset, "Drop all clusters.")
+    .def_property_readonly("config", &rv::tracking::ClusterTracker::getConfig, "ClusterTrackerConfig of the tracker.");
 
   py::enum_<rv::tracking::MotionModel>(tracking, "MotionModel", "MotionModel enum class.")
     .value("CV", rv::tracking::MotionModel::CV, "Constant velocity.")
@@ -196,6 +548,22 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
      "Default init state covariance passed to the KalmanEstimator init function.")
     .def_readwrite("motion_models", &rv::tracking::TrackManagerConfig::mMotionModels,
      "List of motion models to use. It defaults to [CV, CA, CTRV]")
+    .def_readwrite("use_square_root_filter", &rv::tracking::TrackManagerConfig::mUseSquareRootFilter,
+     "Propagate the cholesky factor of the covariance (square-root UKF) instead of the covariance itself. Defaults to False.")
+    .def_readwrite("use_single_precision", &rv::tracking::TrackManagerConfig::mUseSinglePrecision,
+     "Run the Kalman filters and build the association cost matrices in float32. Defaults to False.")
+    .def_readwrite("adaptive_model_pruning", &rv::tracking::TrackManagerConfig::mAdaptiveModelPruning,
+     "Freeze the motion models whose probability is pinned at the minimum and reinstate them on maneuvers. Defaults to False.")
+    .def_readwrite("model_pruning_frames", &rv::tracking::TrackManagerConfig::mModelPruningFrames,
+     "Number of consecutive frames a model probability must stay at the minimum before the model is frozen.")
+    .def_readwrite("model_reactivation_threshold", &rv::tracking::TrackManagerConfig::mModelReactivationThreshold,
+     "Ratio between the normalized innovation squared of a measurement and its running average above which the frozen models of a track are reinstated.")
+    .def_readwrite("lazy_prediction", &rv::tracking::TrackManagerConfig::mLazyPrediction,
+     "Only extrapolate the mean of the tracks far from any measurement and postpone their full prediction. Defaults to False.")
+    .def_readwrite("lazy_prediction_refresh_frames", &rv::tracking::TrackManagerConfig::mLazyPredictionRefreshFrames,
+     "Number of frames after which a postponed prediction is run even without nearby measurements.")
+    .def_readwrite("lazy_prediction_gating_distance", &rv::tracking::TrackManagerConfig::mLazyPredictionGatingDistance,
+     "Distance (meters) to a measurement under which a track gets its full prediction.")
     .def("__repr__", &rv::tracking::TrackManagerConfig::toString, "String representation");
 
 
@@ -210,36 +578,68 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
      "Construct with default config. Set auto_id_generation to False to use the already assigned track_id instead.",
      py::arg("track_manager_config"), py::arg("auto_id_generation"))
     .def("create_track",
-         &rv::tracking::TrackManager::createTrack,
+         py::overload_cast<rv::tracking::TrackedObject, const std::chrono::system_clock::time_point &>(&rv::tracking::TrackManager::createTrack),
          "Create a new track, returns object id of new track.",
          py::arg("object"),
          py::arg("timestamp"))
+    .def("create_track",
+         py::overload_cast<const rv::tracking::Measurement &, const std::chrono::system_clock::time_point &>(&rv::tracking::TrackManager::createTrack),
+         "Create a new track from a compact measurement, returns object id of new track.",
+         py::arg("object"),
+         py::arg("timestamp"))
     .def("predict",
          py::overload_cast<const double>(&rv::tracking::TrackManager::predict),
+         py::call_guard<py::gil_scoped_release>(),
          "Predict at T+deltaT time.",
          py::arg("deltaT"))
     .def("predict",
          py::overload_cast<const std::chrono::system_clock::time_point &>(&rv::tracking::TrackManager::predict),
+         py::call_guard<py::gil_scoped_release>(),
          "Predict at the given timestamp.",
          py::arg("timestamp"))
     .def("set_measurement",
-         &rv::tracking::TrackManager::setMeasurement,
+         py::overload_cast<const rv::tracking::Id &, const rv::tracking::TrackedObject &>(&rv::tracking::TrackManager::setMeasurement),
          "Create a new track, returns object id of new track.",
          py::arg("id"),
          py::arg("measurement"))
-     .def("correct", &rv::tracking::TrackManager::correct, "Trigger state correction for all tracks.")
-     .def("get_tracks", &rv::tracking::TrackManager::getTracks, "returns a list of all active tracks.")
+    .def("set_measurement",
+         py::overload_cast<const rv::tracking::Id &, const rv::tracking::Measurement &>(&rv::tracking::TrackManager::setMeasurement),
+         "Set the compact measurement of the given track, the track attributes are kept.",
+         py::arg("id"),
+         py::arg("measurement"))
+     .def("correct", &rv::tracking::TrackManager::correct, py::call_guard<py::gil_scoped_release>(), "Trigger state correction for all tracks.")
+     .def("get_tracks", &rv::tracking::TrackManager::getTracks, py::call_guard<py::gil_scoped_release>(), "returns a list of all active tracks.")
+     .def("pop_model_pruning_events",
+          &rv::tracking::TrackManager::popModelPruningEvents,
+          "Returns the model pruning and reactivation events of all tracks since the last call.")
+     .def("predict_gating_candidates",
+          py::overload_cast<const std::vector<rv::tracking::TrackedObject> &>(&rv::tracking::TrackManager::predictGatingCandidates),
+          py::call_guard<py::gil_scoped_release>(),
+          "Complete the postponed predictions of the tracks close to any of the given measurements.",
+          py::arg("measurements"))
+     .def("predict_gating_candidates",
+          py::overload_cast<const std::vector<rv::tracking::Measurement> &>(&rv::tracking::TrackManager::predictGatingCandidates),
+          py::call_guard<py::gil_scoped_release>(),
+          "Complete the postponed predictions of the tracks close to any of the given measurements.",
+          py::arg("measurements"))
+     .def_property_readonly("skipped_predictions",
+          &rv::tracking::TrackManager::getNumberOfSkippedPredictions,
+          "Number of tracks whose full prediction was skipped in the last frame.")
      .def("get_reliable_tracks",
           &rv::tracking::TrackManager::getReliableTracks,
+          py::call_guard<py::gil_scoped_release>(),
           "Returns a list of all tracks classified as reliable.")
      .def("get_unreliable_tracks",
           &rv::tracking::TrackManager::getUnreliableTracks,
+          py::call_guard<py::gil_scoped_release>(),
           "Returns a list of all tracks classified as unreliable.")
      .def("get_suspended_tracks",
           &rv::tracking::TrackManager::getSuspendedTracks,
+          py::call_guard<py::gil_scoped_release>(),
           "Returns a list of suspended tracks. Static objects that have not been visible for config.non_measurement_frames_static frames.")
      .def("get_drifting_tracks",
           &rv::tracking::TrackManager::getDriftingTracks,
+          py::call_guard<py::gil_scoped_release>(),
           "Returns a list of tracks in risk of being deleted. Objects that have not been visible for config.non_measurement_frames_dynamic / 2.")
      .def("get_track",
           &rv::tracking::TrackManager::getTrack,
@@ -247,6 +647,7 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
           py::arg("id"))
      .def("get_kalman_estimator",
           &rv::tracking::TrackManager::getKalmanEstimator,
+          py::call_guard<py::gil_scoped_release>(),
           "Returns the MultiModelKalmanEstimator  stored for the given id.",
           py::arg("id"))
      .def("has_id",
@@ -279,6 +680,27 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
          py::arg("camera_frame_rate"))
      .def_property_readonly("config", &rv::tracking::TrackManager::getConfig, "Current track manager configuration");
 
+  py::class_<std::shared_future<void>>(tracking, "TrackingFuture",
+     "Handle of a track step running in the background, see MultipleObjectTracker.track_async.")
+    .def("wait",
+         [](const std::shared_future<void> &future) { future.wait(); },
+         py::call_guard<py::gil_scoped_release>(),
+         "Block until the track step has completed.")
+    .def("done",
+         [](const std::shared_future<void> &future) {
+           return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+         },
+         "Check whether the track step has completed.")
+    .def("result",
+         [](const std::shared_future<void> &future) {
+           {
+             py::gil_scoped_release release;
+             future.wait();
+           }
+           future.get();
+         },
+         "Block until the track step has completed and raise the exception thrown by it, if any.");
+
   py::class_<rv::tracking::MultipleObjectTracker>(tracking, "MultipleObjectTracker",
      "Multiple Object Tracking algorithm using the TrackManager in the background. It performs an association step using the Gated Hungarian matcher.")
     .def(py::init<>(), "Default constructor, use default config parameters.")
@@ -292,12 +714,14 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
       py::arg("distance_threshold"))
     .def("track",
          py::overload_cast<std::vector<rv::tracking::TrackedObject>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp. Use the default distance type and threshold.",
          py::arg("objects"),
          py::arg("timestamp"),
          py::arg("probability_threshold") = 0.5)
     .def("track",
          py::overload_cast<std::vector<rv::tracking::TrackedObject>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp. Run match() with the given distance type and threshold.",
          py::arg("objects"),
          py::arg("timestamp"),
@@ -306,25 +730,226 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
          py::arg("probability_threshold") = 0.5)
     .def("track",
          py::overload_cast<std::vector<std::vector<rv::tracking::TrackedObject>>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp with objects per camera. Use the default distance type and threshold.",
          py::arg("objects_per_camera"),
          py::arg("timestamp"),
          py::arg("probability_threshold") = 0.5)
     .def("track",
          py::overload_cast<std::vector<std::vector<rv::tracking::TrackedObject>>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp with objects per camera. Run match() with the given distance type and threshold.",
          py::arg("objects_per_camera"),
          py::arg("timestamp"),
          py::arg("distance_type"),
          py::arg("distance_threshold"),
          py::arg("probability_threshold") = 0.5)
-    .def("timestamp", &rv::tracking::MultipleObjectTracker::getTimestamp, "Read current timestamp.")
-    .def("get_tracks", &rv::tracking::MultipleObjectTracker::getTracks, "Returns a list of all active tracks")
+    .def("track",
+         py::overload_cast<std::vector<rv::tracking::Measurement>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
+         "Trigger the track step for the next timestamp with compact measurements. Use the default distance type and threshold.",
+         py::arg("objects"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         py::overload_cast<std::vector<rv::tracking::Measurement>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
+         "Trigger the track step for the next timestamp with compact measurements. Run match() with the given distance type and threshold.",
+         py::arg("objects"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         py::overload_cast<std::vector<std::vector<rv::tracking::Measurement>>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
+         "Trigger the track step for the next timestamp with compact measurements per camera. Use the default distance type and threshold.",
+         py::arg("objects_per_camera"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         py::overload_cast<std::vector<std::vector<rv::tracking::Measurement>>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::track),
+         py::call_guard<py::gil_scoped_release>(),
+         "Trigger the track step for the next timestamp with compact measurements per camera. Run match() with the given distance type and threshold.",
+         py::arg("objects_per_camera"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         [](rv::tracking::MultipleObjectTracker &tracker, const MeasurementArray &states, const MeasurementArray &classifications,
+            const HandleArray &handles, const std::chrono::system_clock::time_point &timestamp, double scoreThreshold) {
+           auto measurements = arrays_to_measurements(states, classifications, handles);
+           py::gil_scoped_release release;
+           tracker.track(std::move(measurements), timestamp, scoreThreshold);
+         },
+         "Trigger the track step for the next timestamp with contiguous arrays: Nx7 states (x, y, z, length, width, height, yaw), NxK class probabilities and N int64 handles reported as user_data of the tracks. Use the default distance type and threshold.",
+         py::arg("states"),
+         py::arg("classifications"),
+         py::arg("handles"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         [](rv::tracking::MultipleObjectTracker &tracker, const MeasurementArray &states, const MeasurementArray &classifications,
+            const HandleArray &handles, const std::chrono::system_clock::time_point &timestamp,
+            const rv::tracking::DistanceType &distanceType, double distanceThreshold, double scoreThreshold) {
+           auto measurements = arrays_to_measurements(states, classifications, handles);
+           py::gil_scoped_release release;
+           tracker.track(std::move(measurements), timestamp, distanceType, distanceThreshold, scoreThreshold);
+         },
+         "Trigger the track step for the next timestamp with contiguous arrays. Run match() with the given distance type and threshold.",
+         py::arg("states"),
+         py::arg("classifications"),
+         py::arg("handles"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         [](rv::tracking::MultipleObjectTracker &tracker, const std::vector<MeasurementArray> &states,
+            const std::vector<MeasurementArray> &classifications, const std::vector<HandleArray> &handles,
+            const std::chrono::system_clock::time_point &timestamp, double scoreThreshold) {
+           auto measurements = arrays_to_measurements(states, classifications, handles);
+           py::gil_scoped_release release;
+           tracker.track(std::move(measurements), timestamp, scoreThreshold);
+         },
+         "Trigger the track step for the next timestamp with one set of contiguous arrays per camera. Use the default distance type and threshold.",
+         py::arg("states_per_camera"),
+         py::arg("classifications_per_camera"),
+         py::arg("handles_per_camera"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track",
+         [](rv::tracking::MultipleObjectTracker &tracker, const std::vector<MeasurementArray> &states,
+            const std::vector<MeasurementArray> &classifications, const std::vector<HandleArray> &handles,
+            const std::chrono::system_clock::time_point &timestamp, const rv::tracking::DistanceType &distanceType,
+            double distanceThreshold, double scoreThreshold) {
+           auto measurements = arrays_to_measurements(states, classifications, handles);
+           py::gil_scoped_release release;
+           tracker.track(std::move(measurements), timestamp, distanceType, distanceThreshold, scoreThreshold);
+         },
+         "Trigger the track step for the next timestamp with one set of contiguous arrays per camera. Run match() with the given distance type and threshold.",
+         py::arg("states_per_camera"),
+         py::arg("classifications_per_camera"),
+         py::arg("handles_per_camera"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         py::overload_cast<std::vector<rv::tracking::Measurement>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::trackAsync),
+         "Run the track step for the next timestamp in the background and return a TrackingFuture. Steps are applied in call order, "
+         "the other methods of the tracker wait for the pending steps. Use the default distance type and threshold.",
+         py::arg("objects"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         py::overload_cast<std::vector<rv::tracking::Measurement>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::trackAsync),
+         "Run the track step for the next timestamp in the background and return a TrackingFuture. Run match() with the given distance type and threshold.",
+         py::arg("objects"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         py::overload_cast<std::vector<std::vector<rv::tracking::Measurement>>, const std::chrono::system_clock::time_point &, double>(&rv::tracking::MultipleObjectTracker::trackAsync),
+         "Run the track step for the next timestamp with compact measurements per camera in the background. Use the default distance type and threshold.",
+         py::arg("objects_per_camera"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         py::overload_cast<std::vector<std::vector<rv::tracking::Measurement>>, const std::chrono::system_clock::time_point &, const rv::tracking::DistanceType &, double, double>(&rv::tracking::MultipleObjectTracker::trackAsync),
+         "Run the track step for the next timestamp with compact measurements per camera in the background. Run match() with the given distance type and threshold.",
+         py::arg("objects_per_camera"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         [](rv::tracking::MultipleObjectTracker &tracker, const MeasurementArray &states, const MeasurementArray &classifications,
+            const HandleArray &handles, const std::chrono::system_clock::time_point &timestamp, double scoreThreshold) {
+           return tracker.trackAsync(arrays_to_measurements(states, classifications, handles), timestamp, scoreThreshold);
+         },
+         "Run the track step for the next timestamp with contiguous arrays in the background, the arrays are copied before returning. Use the default distance type and threshold.",
+         py::arg("states"),
+         py::arg("classifications"),
+         py::arg("handles"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         [](rv::tracking::MultipleObjectTracker &tracker, const MeasurementArray &states, const MeasurementArray &classifications,
+            const HandleArray &handles, const std::chrono::system_clock::time_point &timestamp,
+            const rv::tracking::DistanceType &distanceType, double distanceThreshold, double scoreThreshold) {
+           return tracker.trackAsync(arrays_to_measurements(states, classifications, handles), timestamp, distanceType, distanceThreshold, scoreThreshold);
+         },
+         "Run the track step for the next timestamp with contiguous arrays in the background. Run match() with the given distance type and threshold.",
+         py::arg("states"),
+         py::arg("classifications"),
+         py::arg("handles"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         [](rv::tracking::MultipleObjectTracker &tracker, const std::vector<MeasurementArray> &states,
+            const std::vector<MeasurementArray> &classifications, const std::vector<HandleArray> &handles,
+            const std::chrono::system_clock::time_point &timestamp, double scoreThreshold) {
+           return tracker.trackAsync(arrays_to_measurements(states, classifications, handles), timestamp, scoreThreshold);
+         },
+         "Run the track step for the next timestamp with one set of contiguous arrays per camera in the background. Use the default distance type and threshold.",
+         py::arg("states_per_camera"),
+         py::arg("classifications_per_camera"),
+         py::arg("handles_per_camera"),
+         py::arg("timestamp"),
+         py::arg("probability_threshold") = 0.5)
+    .def("track_async",
+         [](rv::tracking::MultipleObjectTracker &tracker, const std::vector<MeasurementArray> &states,
+            const std::vector<MeasurementArray> &classifications, const std::vector<HandleArray> &handles,
+            const std::chrono::system_clock::time_point &timestamp, const rv::tracking::DistanceType &distanceType,
+            double distanceThreshold, double scoreThreshold) {
+           return tracker.trackAsync(arrays_to_measurements(states, classifications, handles), timestamp, distanceType, distanceThreshold, scoreThreshold);
+         },
+         "Run the track step for the next timestamp with one set of contiguous arrays per camera in the background. Run match() with the given distance type and threshold.",
+         py::arg("states_per_camera"),
+         py::arg("classifications_per_camera"),
+         py::arg("handles_per_camera"),
+         py::arg("timestamp"),
+         py::arg("distance_type"),
+         py::arg("distance_threshold"),
+         py::arg("probability_threshold") = 0.5)
+    .def("timestamp", &rv::tracking::MultipleObjectTracker::getTimestamp, py::call_guard<py::gil_scoped_release>(), "Read current timestamp.")
+    .def("get_tracks", &rv::tracking::MultipleObjectTracker::getTracks, py::call_guard<py::gil_scoped_release>(), "Returns a list of all active tracks")
     .def("get_reliable_tracks",
          &rv::tracking::MultipleObjectTracker::getReliableTracks,
+         py::call_guard<py::gil_scoped_release>(),
          "Returns a list of all active reliable tracks.")
+    .def("get_reliable_track_arrays",
+         [](rv::tracking::MultipleObjectTracker &tracker) {
+           std::vector<rv::tracking::TrackedObject> tracks;
+           {
+             py::gil_scoped_release release;
+             tracks = tracker.getReliableTracks();
+           }
+           return tracks_to_arrays(tracker, tracks);
+         },
+         "Returns the reliable tracks as a dictionary of numpy columns: 'id' (N), 'state' (Nx12: x, y, vx, vy, ax, ay, z, length, width, height, yaw, w), "
+         "'covariance' (Nx12 error covariance diagonals), 'user_data' (N) and 'measurement_index' (N), the index of the input measurement that corrected or created the track in the last frame or -1. "
+         "With measurements per camera the index refers to the concatenation of the camera lists.")
+    .def("measurement_index",
+         &rv::tracking::MultipleObjectTracker::getMeasurementIndex,
+         py::call_guard<py::gil_scoped_release>(),
+         "Index of the input measurement that corrected or created the track in the last frame, -1 if the track was not measured.",
+         py::arg("id"))
+    .def("pop_model_pruning_events",
+         &rv::tracking::MultipleObjectTracker::popModelPruningEvents,
+         py::call_guard<py::gil_scoped_release>(),
+         "Returns the model pruning and reactivation events since the last call.")
+    .def_property_readonly("skipped_predictions",
+         py::cpp_function(&rv::tracking::MultipleObjectTracker::getNumberOfSkippedPredictions, py::call_guard<py::gil_scoped_release>()),
+         "Number of tracks whose full prediction was skipped in the last frame.")
     .def("update_tracker_params",
          &rv::tracking::MultipleObjectTracker::updateTrackerParams,
+         py::call_guard<py::gil_scoped_release>(),
          "Updates tracker frame based parameters.");
 
   py::class_<rv::tracking::TrackTracker>(tracking,
@@ -335,6 +960,7 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
       py::arg("track_manager_config"))
     .def("track",
          &rv::tracking::TrackTracker::track,
+         py::call_guard<py::gil_scoped_release>(),
          "Trigger the track step for the next timestamp. Note: The objects must have an id already assigned.",
          py::arg("tracked_objects"),
          py::arg("timestamp"))
@@ -342,6 +968,7 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
     .def("get_tracks", &rv::tracking::TrackTracker::getTracks, "Returns a list of all active tracks.")
     .def("get_reliable_tracks",
          &rv::tracking::TrackTracker::getReliableTracks,
+         py::call_guard<py::gil_scoped_release>(),
          "Returns a list of all active reliable tracks.");
 
      tracking.def("match", [](const std::vector<rv::tracking::TrackedObject> &measurements, const std::vector<rv::tracking::TrackedObject> &tracks, const rv::tracking::DistanceType &distanceType, double threshold) {
@@ -387,8 +1014,8 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
         float y,
         float width,
         float height,
-        py::array_t<double> camera_intrinsics_matrix,
-        py::array_t<double> distortion_matrix
+        const DoubleArray &camera_intrinsics_matrix,
+        const DoubleArray &distortion_matrix
     ) {
         // Convert numpy arrays to cv::Mat
         cv::Mat intrinsics = numpy_to_mat(camera_intrinsics_matrix);
@@ -405,8 +1032,8 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
 
      tracking.def("compute_pixels_to_meter_plane_batch", [](
         py::list bboxes_list,
-        py::array_t<double> camera_intrinsics_matrix,
-        py::array_t<double> distortion_matrix
+        const DoubleArray &camera_intrinsics_matrix,
+        const DoubleArray &distortion_matrix
     ) {
         // Convert numpy arrays to cv::Mat
         cv::Mat intrinsics = numpy_to_mat(camera_intrinsics_matrix);
@@ -428,7 +1055,11 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
 
         // Call the C++ batch implementation
         rv::CameraParams params{intrinsics, distortion};
-        auto results = rv::computePixelsToMeterPlane(bboxes, params);
+        std::vector<cv::Rect2f> results;
+        {
+          py::gil_scoped_release release;
+          results = rv::computePixelsToMeterPlane(bboxes, params);
+        }
 
         // Convert results to Python list of tuples
         py::list result_list;
@@ -439,4 +1070,186 @@ py::class_<rv::tracking::Classification>(tracking, "Classification", "Classifica
         return result_list;
     });
 
+    using BoxArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+    py::class_<rv::UndistortionMap>(tracking, "UndistortionMap",
+      "Cached undistortion of one camera, a grid of normalized coordinates interpolated bilinearly. Build it once per camera "
+      "and rebuild it when matches() returns False.")
+      .def(py::init([](const DoubleArray &intrinsics, const DoubleArray &distortion, std::pair<int, int> imageSize,
+                       double maxError, int initialCellSize) {
+             return rv::UndistortionMap(rv::CameraParams{numpy_to_mat(intrinsics), numpy_to_mat(distortion)},
+                                        cv::Size(imageSize.first, imageSize.second), maxError, initialCellSize);
+           }),
+           "Build the map for the given calibration. The image size (width, height) defaults to twice the principal point, "
+           "the cells are refined until the interpolation error is below max_error (normalized units).",
+           py::arg("camera_intrinsics_matrix"),
+           py::arg("distortion_matrix"),
+           py::arg("image_size") = std::pair<int, int>(0, 0),
+           py::arg("max_error") = 1e-4,
+           py::arg("initial_cell_size") = 16)
+      .def("matches",
+           [](const rv::UndistortionMap &map, const DoubleArray &intrinsics, const DoubleArray &distortion) {
+             return map.matches(rv::CameraParams{numpy_to_mat(intrinsics), numpy_to_mat(distortion)});
+           },
+           "Check whether the map was built from the given calibration.",
+           py::arg("camera_intrinsics_matrix"),
+           py::arg("distortion_matrix"))
+      .def("compute_pixels_to_meter_plane",
+           [](const rv::UndistortionMap &map, const BoxArray &boxes) {
+             if (boxes.size() != 0 && (boxes.ndim() != 2 || boxes.shape(1) != 4)) {
+               throw std::runtime_error("The bounding boxes must be an Nx4 array of (x, y, width, height)");
+             }
+             const py::ssize_t count = boxes.size() / 4;
+             BoxArray result({count, static_cast<py::ssize_t>(4)});
+             {
+               py::gil_scoped_release release;
+               map.computePixelsToMeterPlane(boxes.data(), result.mutable_data(), static_cast<std::size_t>(count));
+             }
+             return result;
+           },
+           "Convert an Nx4 array of pixel bounding boxes (x, y, width, height) to undistorted coordinates, returns an Nx4 float32 array.",
+           py::arg("bboxes"))
+      .def_property_readonly("max_error", &rv::UndistortionMap::getMaxError,
+           "Largest interpolation error found while building the map, in normalized units.")
+      .def_property_readonly("cell_size", &rv::UndistortionMap::getCellSize, "Grid spacing in pixels.");
+
+    using BoolArray = py::array_t<bool, py::array::c_style | py::array::forcecast>;
+
+    py::class_<rv::CameraProjection>(tracking, "CameraProjection",
+      "Pose and calibration of one camera, projects batches of detections between the normalized image plane and the ground plane.")
+      .def(py::init([](const DoubleArray &pose, const DoubleArray &intrinsics, const DoubleArray &distortion,
+                       double viewAngle, double groundHeight) {
+             return rv::CameraProjection(numpy_to_mat(pose), rv::CameraParams{numpy_to_mat(intrinsics), numpy_to_mat(distortion)},
+                                         viewAngle, groundHeight);
+           }),
+           "Build the projection from the 4x4 camera to world pose matrix, the calibration, the viewing angle of the camera "
+           "on the map in degrees and the height of the ground plane.",
+           py::arg("pose_matrix"),
+           py::arg("camera_intrinsics_matrix"),
+           py::arg("distortion_matrix"),
+           py::arg("view_angle") = 0.,
+           py::arg("ground_height") = 0.)
+      .def("matches",
+           [](const rv::CameraProjection &projection, const DoubleArray &pose, const DoubleArray &intrinsics,
+              const DoubleArray &distortion) {
+             return projection.matches(numpy_to_mat(pose), rv::CameraParams{numpy_to_mat(intrinsics), numpy_to_mat(distortion)});
+           },
+           "Check whether the projection was built from the given pose and calibration.",
+           py::arg("pose_matrix"),
+           py::arg("camera_intrinsics_matrix"),
+           py::arg("distortion_matrix"))
+      .def("camera_point_to_world_point",
+           [](const rv::CameraProjection &projection, double x, double y) {
+             const cv::Point3d point = projection.cameraPointToWorldPoint(cv::Point2d(x, y));
+             return py::make_tuple(point.x, point.y, point.z);
+           },
+           "World point of a point of the normalized image plane on the ground plane.",
+           py::arg("x"),
+           py::arg("y"))
+      .def("project_boxes",
+           [](const rv::CameraProjection &projection, const DoubleArray &boxes, py::object baseAngleShift, py::object objectSizes) {
+             if (boxes.size() != 0 && (boxes.ndim() != 2 || boxes.shape(1) != 4)) {
+               throw std::runtime_error("The bounding boxes must be an Nx4 array of (x, y, width, height)");
+             }
+             const std::size_t count = static_cast<std::size_t>(boxes.size() / 4);
+             std::vector<cv::Rect2d> rects(count);
+             for (std::size_t i = 0; i < count; ++i) {
+               const double *box = boxes.data() + 4 * i;
+               rects[i] = cv::Rect2d(box[0], box[1], box[2], box[3]);
+             }
+             std::vector<uint8_t> shifts;
+             if (!baseAngleShift.is_none()) {
+               const auto flags = baseAngleShift.cast<BoolArray>();
+               shifts.assign(flags.data(), flags.data() + flags.size());
+             }
+             std::vector<cv::Vec2d> sizes;
+             if (!objectSizes.is_none()) {
+               const auto values = objectSizes.cast<DoubleArray>();
+               if (values.size() != 0 && (values.ndim() != 2 || values.shape(1) != 2)) {
+                 throw std::runtime_error("The object sizes must be an Nx2 array of (length, width)");
+               }
+               for (py::ssize_t i = 0; i < values.size() / 2; ++i) {
+                 sizes.emplace_back(values.data()[2 * i], values.data()[2 * i + 1]);
+               }
+             }
+
+             std::vector<rv::GroundProjection> projections;
+             {
+               py::gil_scoped_release release;
+               projections = projection.projectBoxes(rects, shifts, sizes);
+             }
+
+             const py::ssize_t n = static_cast<py::ssize_t>(count);
+             py::array_t<double> positions({n, static_cast<py::ssize_t>(3)});
+             py::array_t<double> bounds({n, static_cast<py::ssize_t>(2)});
+             py::array_t<double> shadows({n, static_cast<py::ssize_t>(4), static_cast<py::ssize_t>(3)});
+             py::array_t<double> baseAngles(n);
+             auto position = positions.mutable_unchecked<2>();
+             auto bound = bounds.mutable_unchecked<2>();
+             auto shadow = shadows.mutable_unchecked<3>();
+             auto baseAngle = baseAngles.mutable_unchecked<1>();
+             for (py::ssize_t i = 0; i < n; ++i) {
+               const rv::GroundProjection &result = projections[i];
+               position(i, 0) = result.position.x;
+               position(i, 1) = result.position.y;
+               position(i, 2) = result.position.z;
+               bound(i, 0) = result.bounds.width;
+               bound(i, 1) = result.bounds.height;
+               for (py::ssize_t k = 0; k < 4; ++k) {
+                 shadow(i, k, 0) = result.shadow[k].x;
+                 shadow(i, k, 1) = result.shadow[k].y;
+                 shadow(i, k, 2) = result.shadow[k].z;
+               }
+               baseAngle(i) = result.baseAngle;
+             }
+
+             py::dict columns;
+             columns["position"] = positions;
+             columns["bounds"] = bounds;
+             columns["shadow"] = shadows;
+             columns["base_angle"] = baseAngles;
+             return columns;
+           },
+           "Project an Nx4 array of normalized image plane boxes (x, y, width, height) onto the ground plane. base_angle_shift "
+           "(N bools) raises the position by the base angle (TYPE_2 objects), object_sizes (Nx2 length and width, NaN to use the "
+           "box width) sets how far the position is pushed away from the camera. Returns a dictionary of numpy columns: "
+           "'position' (Nx3), 'bounds' (Nx2 metric width and height), 'shadow' (Nx4x3 far left, far right, bottom right and "
+           "bottom left ground corners) and 'base_angle' (N, degrees).",
+           py::arg("boxes"),
+           py::arg("base_angle_shift") = py::none(),
+           py::arg("object_sizes") = py::none())
+      .def("project_estimated_bounds",
+           [](const rv::CameraProjection &projection, const DoubleArray &points, const DoubleArray &sizes) {
+             if ((points.size() != 0 && (points.ndim() != 2 || points.shape(1) != 3))
+                 || (sizes.size() != 0 && (sizes.ndim() != 2 || sizes.shape(1) != 2))) {
+               throw std::runtime_error("The points must be an Nx3 array and the sizes an Nx2 array of (width, height)");
+             }
+             std::vector<cv::Point3d> worldPoints;
+             std::vector<cv::Size2d> metricSizes;
+             for (py::ssize_t i = 0; i < points.size() / 3; ++i) {
+               worldPoints.emplace_back(points.data()[3 * i], points.data()[3 * i + 1], points.data()[3 * i + 2]);
+             }
+             for (py::ssize_t i = 0; i < sizes.size() / 2; ++i) {
+               metricSizes.emplace_back(sizes.data()[2 * i], sizes.data()[2 * i + 1]);
+             }
+
+             std::vector<cv::Rect2d> bounds;
+             {
+               py::gil_scoped_release release;
+               bounds = projection.projectEstimatedBounds(worldPoints, metricSizes);
+             }
+             py::array_t<double> result({static_cast<py::ssize_t>(bounds.size()), static_cast<py::ssize_t>(4)});
+             auto rows = result.mutable_unchecked<2>();
+             for (py::ssize_t i = 0; i < static_cast<py::ssize_t>(bounds.size()); ++i) {
+               rows(i, 0) = bounds[i].x;
+               rows(i, 1) = bounds[i].y;
+               rows(i, 2) = bounds[i].width;
+               rows(i, 3) = bounds[i].height;
+             }
+             return result;
+           },
+           "Pixel bounds (x, y, width, height) of objects with the given metric (width, height) standing at the Nx3 world points.",
+           py::arg("points"),
+           py::arg("sizes"));
+
 }
@@ -9,6 +9,8 @@
 #include <chrono>
 #include <vector>
 
+#include "mat_caster.hpp"
+
 namespace py = pybind11;
 
 PYBIND11_MODULE(types, types)
@@ -20,16 +22,7 @@ PYBIND11_MODULE(types, types)
 
   // tracking module
 
-  // Expose the opencv matrix as a pybind11 buffer, only for 2D matrix of double
-  py::class_<cv::Mat>(types, "Mat", py::buffer_protocol(), "2D array class using the py::buffer_protocol. It represents a Matrix as 2D array of double precision data. Use numpy.array(mat) to access data.").def_buffer([](cv::Mat &mat) -> py::buffer_info {
-    return py::buffer_info(mat.data,                                /* Pointer to buffer */
-                           sizeof(double),                          /* Size of one scalar */
-                           py::format_descriptor<double>::format(), /* Python struct-style format descriptor */
-                           mat.dims,                                /* Number of dimensions */
-                           {mat.rows, mat.cols},                    /* Buffer dimensions */
-                           {sizeof(double) * mat.cols,              /* Strides (in bytes) for each index */
-                            sizeof(double)});
-  })
-  .def("__repr__", [](const cv::Mat& mat) {
-      return "robot_vision.extensions.types.Mat(): Use numpy.array(Mat()) to access data.";});
+  // cv::Mat is converted to and from numpy arrays without copying, see mat_caster.hpp. Mat is kept as an alias so
+  // isinstance checks against the former buffer class keep working.
+  types.attr("Mat") = py::module_::import("numpy").attr("ndarray");
 }
@@ -3,8 +3,71 @@
 
 #include "rv/tracking/CameraUtils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
 namespace rv {
 
+namespace {
+
+constexpr double EarthRadius = 6371000.;          // in meters
+constexpr double FallbackHorizonDistance = 1000.; // FALLBACK_HORIZON_DISTANCE of scene_common.transform
+
+inline double toRadians(double degrees)
+{
+    return degrees * M_PI / 180.;
+}
+
+/// Cartesian offset of a polar point (radius, azimuth, inclination in degrees) with the conventions of fast_geometry
+inline cv::Point3d polarOffset(double radius, double azimuth, double inclination)
+{
+    const double a = toRadians(azimuth);
+    const double i = toRadians(inclination);
+    return cv::Point3d(radius * std::cos(a), radius * std::cos(i) * std::sin(a), radius * std::sin(i) * std::cos(a));
+}
+
+/// Bilinear interpolation of the grid at grid coordinates (gx, gy), returns false if the point is outside the grid
+inline bool interpolateGrid(const float* gridX, const float* gridY, int columns, int rows, float gx, float gy,
+                            float& x, float& y)
+{
+    // no branches, the batch loop is vectorized
+    const bool inside = (gx >= 0.f) & (gy >= 0.f) & (gx <= columns) & (gy <= rows);
+
+    // clamp so that points outside the grid (and NaNs) still read valid nodes, their result is discarded
+    gx = std::min(std::max(0.f, gx), static_cast<float>(columns));
+    gy = std::min(std::max(0.f, gy), static_cast<float>(rows));
+    const int c = std::min(static_cast<int>(gx), columns - 1);
+    const int r = std::min(static_cast<int>(gy), rows - 1);
+    const float tx = gx - c;
+    const float ty = gy - r;
+
+    const int i = r * (columns + 1) + c;
+    const int j = i + columns + 1;
+    x = (1.f - ty) * ((1.f - tx) * gridX[i] + tx * gridX[i + 1]) + ty * ((1.f - tx) * gridX[j] + tx * gridX[j + 1]);
+    y = (1.f - ty) * ((1.f - tx) * gridY[i] + tx * gridY[i + 1]) + ty * ((1.f - tx) * gridY[j] + tx * gridY[j + 1]);
+    return inside;
+}
+
+bool sameValues(const cv::Mat& values, const cv::Mat& reference)
+{
+    cv::Mat converted;
+    values.convertTo(converted, CV_64F);
+    if (converted.total() != reference.total())
+    {
+        return false;
+    }
+    if (!converted.isContinuous())
+    {
+        converted = converted.clone();
+    }
+    return converted.total() == 0
+           || std::equal(converted.ptr<double>(), converted.ptr<double>() + converted.total(), reference.ptr<double>());
+}
+
+} // namespace
+
 cv::Rect2f computePixelsToMeterPlane(
     const cv::Rect2f& bbox,
     const CameraParams& params
@@ -40,4 +103,351 @@ std::vector<cv::Rect2f> computePixelsToMeterPlane(
     return results;
 }
 
+
+UndistortionMap::UndistortionMap(const CameraParams& params, cv::Size imageSize, double maxError, int initialCellSize)
+{
+    params.intrinsics.convertTo(mIntrinsics, CV_64F);
+    params.distortion.convertTo(mDistortion, CV_64F);
+    if (mIntrinsics.rows != 3 || mIntrinsics.cols != 3)
+    {
+        throw std::runtime_error("The camera intrinsics must be a 3x3 matrix");
+    }
+
+    mImageSize = imageSize;
+    if (mImageSize.width <= 0 || mImageSize.height <= 0)
+    {
+        // a principal point at the origin leaves a single cell, other points use the exact undistortion
+        mImageSize = cv::Size(std::max(1, static_cast<int>(std::ceil(2. * mIntrinsics.at<double>(0, 2)))),
+                              std::max(1, static_cast<int>(std::ceil(2. * mIntrinsics.at<double>(1, 2)))));
+    }
+
+    int cellSize = std::max(initialCellSize, 1);
+    build(cellSize);
+    while (mMaxError > maxError && cellSize > 1)
+    {
+        cellSize /= 2;
+        build(cellSize);
+    }
+}
+
+void UndistortionMap::build(int cellSize)
+{
+    mCellSize = cellSize;
+    mColumns = (mImageSize.width + cellSize - 1) / cellSize;
+    mRows = (mImageSize.height + cellSize - 1) / cellSize;
+
+    std::vector<cv::Point2f> nodes;
+    nodes.reserve(static_cast<std::size_t>(mColumns + 1) * (mRows + 1));
+    for (int r = 0; r <= mRows; ++r)
+    {
+        for (int c = 0; c <= mColumns; ++c)
+        {
+            nodes.emplace_back(static_cast<float>(c * cellSize), static_cast<float>(r * cellSize));
+        }
+    }
+
+    std::vector<cv::Point2f> undistorted;
+    cv::undistortPoints(nodes, undistorted, mIntrinsics, mDistortion);
+    mGridX.resize(undistorted.size());
+    mGridY.resize(undistorted.size());
+    for (std::size_t i = 0; i < undistorted.size(); ++i)
+    {
+        mGridX[i] = undistorted[i].x;
+        mGridY[i] = undistorted[i].y;
+    }
+
+    // the bilinear error peaks between the nodes, check the cell centers and the midpoints of the cell edges
+    const float half = 0.5f * cellSize;
+    std::vector<cv::Point2f> samples;
+    samples.reserve(3 * nodes.size());
+    for (int r = 0; r <= mRows; ++r)
+    {
+        for (int c = 0; c <= mColumns; ++c)
+        {
+            const float u = static_cast<float>(c * cellSize);
+            const float v = static_cast<float>(r * cellSize);
+            if (c < mColumns)
+            {
+                samples.emplace_back(u + half, v);
+            }
+            if (r < mRows)
+            {
+                samples.emplace_back(u, v + half);
+            }
+            if (c < mColumns && r < mRows)
+            {
+                samples.emplace_back(u + half, v + half);
+            }
+        }
+    }
+
+    std::vector<cv::Point2f> expected;
+    cv::undistortPoints(samples, expected, mIntrinsics, mDistortion);
+    mMaxError = 0.;
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const cv::Point2f point = undistort(samples[i]);
+        mMaxError = std::max(mMaxError, static_cast<double>(std::max(std::abs(point.x - expected[i].x),
+                                                                     std::abs(point.y - expected[i].y))));
+    }
+}
+
+bool UndistortionMap::matches(const CameraParams& params) const
+{
+    return sameValues(params.intrinsics, mIntrinsics) && sameValues(params.distortion, mDistortion);
+}
+
+cv::Point2f UndistortionMap::undistort(const cv::Point2f& pixel) const
+{
+    const float scale = 1.f / mCellSize;
+    cv::Point2f result;
+    if (interpolateGrid(mGridX.data(), mGridY.data(), mColumns, mRows, pixel.x * scale, pixel.y * scale,
+                        result.x, result.y))
+    {
+        return result;
+    }
+
+    std::vector<cv::Point2f> undistorted;
+    cv::undistortPoints(std::vector<cv::Point2f>{pixel}, undistorted, mIntrinsics, mDistortion);
+    return undistorted[0];
+}
+
+cv::Rect2f UndistortionMap::computePixelsToMeterPlane(const cv::Rect2f& bbox) const
+{
+    const cv::Point2f topLeft = undistort(cv::Point2f(bbox.x, bbox.y));
+    const cv::Point2f bottomRight = undistort(cv::Point2f(bbox.x + bbox.width, bbox.y + bbox.height));
+    return cv::Rect2f(topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y);
+}
+
+std::vector<cv::Rect2f> UndistortionMap::computePixelsToMeterPlane(const std::vector<cv::Rect2f>& bboxes) const
+{
+    static_assert(sizeof(cv::Rect2f) == 4 * sizeof(float), "cv::Rect2f must be laid out as four floats");
+
+    std::vector<cv::Rect2f> results(bboxes.size());
+    computePixelsToMeterPlane(reinterpret_cast<const float*>(bboxes.data()), reinterpret_cast<float*>(results.data()),
+                              bboxes.size());
+    return results;
+}
+
+void UndistortionMap::computePixelsToMeterPlane(const float* boxes, float* result, std::size_t count) const
+{
+    const float scale = 1.f / mCellSize;
+    const float* gridX = mGridX.data();
+    const float* gridY = mGridY.data();
+    const int columns = mColumns;
+    const int rows = mRows;
+    std::vector<uint8_t> outside(count);
+
+    #pragma omp simd
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* box = boxes + 4 * i;
+        float x0, y0, x1, y1;
+        const bool inside0 = interpolateGrid(gridX, gridY, columns, rows, box[0] * scale, box[1] * scale, x0, y0);
+        const bool inside1 = interpolateGrid(gridX, gridY, columns, rows, (box[0] + box[2]) * scale,
+                                             (box[1] + box[3]) * scale, x1, y1);
+        result[4 * i] = x0;
+        result[4 * i + 1] = y0;
+        result[4 * i + 2] = x1 - x0;
+        result[4 * i + 3] = y1 - y0;
+        outside[i] = !(inside0 & inside1);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (outside[i])
+        {
+            const float* box = boxes + 4 * i;
+            const cv::Rect2f converted = computePixelsToMeterPlane(cv::Rect2f(box[0], box[1], box[2], box[3]));
+            result[4 * i] = converted.x;
+            result[4 * i + 1] = converted.y;
+            result[4 * i + 2] = converted.width;
+            result[4 * i + 3] = converted.height;
+        }
+    }
+}
+
+CameraProjection::CameraProjection(const cv::Mat& poseMatrix, const CameraParams& params, double viewAngle,
+                                   double groundHeight)
+    : mViewAngle(viewAngle), mGroundHeight(groundHeight)
+{
+    cv::Mat pose;
+    poseMatrix.convertTo(pose, CV_64F);
+    if ((pose.rows != 3 && pose.rows != 4) || pose.cols != 4)
+    {
+        throw std::runtime_error("The camera pose must be a 3x4 or 4x4 matrix");
+    }
+    params.intrinsics.convertTo(mIntrinsics, CV_64F);
+    params.distortion.convertTo(mDistortion, CV_64F);
+    if (mIntrinsics.rows != 3 || mIntrinsics.cols != 3)
+    {
+        throw std::runtime_error("The camera intrinsics must be a 3x3 matrix");
+    }
+
+    cv::Mat full = cv::Mat::eye(4, 4, CV_64F);
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            mPose[4 * r + c] = pose.at<double>(r, c);
+            full.at<double>(r, c) = mPose[4 * r + c];
+        }
+    }
+    mTranslation = cv::Point3d(mPose[3], mPose[7], mPose[11]);
+
+    // world to camera transform, the rotation vector comes from the inverted pose as in CameraPose.setPose
+    const cv::Mat inverted = full.inv();
+    cv::Rodrigues(inverted(cv::Rect(0, 0, 3, 3)).clone(), mRotationVector);
+    mTranslationVector = inverted(cv::Rect(3, 0, 1, 3)).clone();
+
+    const double cameraHeight = std::abs(mTranslation.z - mGroundHeight);
+    mHorizonDistance = cameraHeight > 0.1 ? std::sqrt(2. * EarthRadius * cameraHeight) : FallbackHorizonDistance;
+}
+
+bool CameraProjection::matches(const cv::Mat& poseMatrix, const CameraParams& params) const
+{
+    cv::Mat pose;
+    poseMatrix.convertTo(pose, CV_64F);
+    if ((pose.rows != 3 && pose.rows != 4) || pose.cols != 4)
+    {
+        return false;
+    }
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            if (pose.at<double>(r, c) != mPose[4 * r + c])
+            {
+                return false;
+            }
+        }
+    }
+    return sameValues(params.intrinsics, mIntrinsics) && sameValues(params.distortion, mDistortion);
+}
+
+cv::Point3d CameraProjection::cameraPointToWorldPoint(const cv::Point2d& point) const
+{
+    const cv::Point3d ray(mPose[0] * point.x + mPose[1] * point.y + mPose[2],
+                          mPose[4] * point.x + mPose[5] * point.y + mPose[6],
+                          mPose[8] * point.x + mPose[9] * point.y + mPose[10]);
+    if (ray.z < -1e-6)
+    {
+        // the ray points down, intersect it with the ground plane
+        const double scale = (mGroundHeight - mTranslation.z) / ray.z;
+        return mTranslation + ray * scale;
+    }
+
+    // the ray does not hit the ground in front of the camera, cull it at the horizon
+    const double xyLength = std::sqrt(ray.x * ray.x + ray.y * ray.y);
+    if (xyLength > 1e-6)
+    {
+        return cv::Point3d(mTranslation.x + ray.x / xyLength * mHorizonDistance,
+                           mTranslation.y + ray.y / xyLength * mHorizonDistance, mGroundHeight);
+    }
+    return cv::Point3d(mTranslation.x, mTranslation.y, mGroundHeight);
+}
+
+cv::Point3d CameraProjection::cameraPointToWorldPoint(const cv::Point3d& point) const
+{
+    return cv::Point3d(mPose[0] * point.x + mPose[1] * point.y + mPose[2] * point.z + mPose[3],
+                       mPose[4] * point.x + mPose[5] * point.y + mPose[6] * point.z + mPose[7],
+                       mPose[8] * point.x + mPose[9] * point.y + mPose[10] * point.z + mPose[11]);
+}
+
+GroundProjection CameraProjection::projectBox(const cv::Rect2d& box, bool baseAngleShift,
+                                              const cv::Vec2d& objectSize) const
+{
+    const double x1 = box.x;
+    const double y1 = box.y;
+    const double x2 = box.x + box.width;
+    const double y2 = box.y + box.height;
+    const cv::Point3d bottomLeft = cameraPointToWorldPoint(cv::Point2d(x1, y2));
+    const cv::Point3d bottomRight = cameraPointToWorldPoint(cv::Point2d(x2, y2));
+    const cv::Point3d farLeft = cameraPointToWorldPoint(cv::Point2d(x1, y1));
+    const cv::Point3d farRight = cameraPointToWorldPoint(cv::Point2d(x2, y1));
+
+    GroundProjection projection;
+    const double elevation = std::atan2(mTranslation.z, cv::norm(mTranslation - farLeft));
+    projection.bounds = cv::Size2d(cv::norm(bottomLeft - bottomRight), std::sin(elevation) * cv::norm(bottomLeft - farLeft));
+    projection.shadow = {{farLeft, farRight, bottomRight, bottomLeft}};
+
+    const cv::Point3d basePoint = (bottomLeft + bottomRight) * 0.5;
+    const double baseLength = cv::norm(cv::Point3d(mTranslation.x, mTranslation.y, 0.) - basePoint);
+    projection.baseAngle = std::atan2(mTranslation.z, baseLength) * 180. / M_PI;
+
+    const double u = box.x + box.width / 2.;
+    const double v = baseAngleShift ? box.y + box.height - (box.height / 2.) * (projection.baseAngle / 90.)
+                                    : box.y + box.height;
+    projection.position = cameraPointToWorldPoint(cv::Point2d(u, v));
+
+    // the box covers the near side of the object, move the position to its center
+    const double length = std::isnan(objectSize[0]) ? projection.bounds.width : objectSize[0];
+    const double width = std::isnan(objectSize[1]) ? projection.bounds.width : objectSize[1];
+    const double shift = (length + width) / 4.;
+    const double azimuth = std::atan2(projection.position.y - mTranslation.y, projection.position.x - mTranslation.x);
+    projection.position.x += shift * std::cos(azimuth);
+    projection.position.y += shift * std::sin(azimuth);
+    return projection;
+}
+
+std::vector<GroundProjection> CameraProjection::projectBoxes(const std::vector<cv::Rect2d>& boxes,
+                                                             const std::vector<uint8_t>& baseAngleShift,
+                                                             const std::vector<cv::Vec2d>& objectSizes) const
+{
+    if ((!baseAngleShift.empty() && baseAngleShift.size() != boxes.size())
+        || (!objectSizes.empty() && objectSizes.size() != boxes.size()))
+    {
+        throw std::runtime_error("The shift flags and object sizes must be empty or match the number of boxes");
+    }
+
+    std::vector<GroundProjection> projections(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        projections[i] = projectBox(boxes[i], !baseAngleShift.empty() && baseAngleShift[i],
+                                    objectSizes.empty() ? cv::Vec2d(NAN, NAN) : objectSizes[i]);
+    }
+    return projections;
+}
+
+cv::Rect2d CameraProjection::projectEstimatedBounds(const cv::Point3d& point, const cv::Size2d& size) const
+{
+    return projectEstimatedBounds(std::vector<cv::Point3d>{point}, std::vector<cv::Size2d>{size})[0];
+}
+
+std::vector<cv::Rect2d> CameraProjection::projectEstimatedBounds(const std::vector<cv::Point3d>& points,
+                                                                 const std::vector<cv::Size2d>& sizes) const
+{
+    if (points.size() != sizes.size())
+    {
+        throw std::runtime_error("The number of points and sizes must match");
+    }
+    if (points.empty())
+    {
+        return std::vector<cv::Rect2d>();
+    }
+
+    // the object point, the point half the width to the left of the view direction and the point at the object height
+    std::vector<cv::Point3d> worldPoints;
+    worldPoints.reserve(3 * points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        worldPoints.push_back(points[i]);
+        worldPoints.push_back(points[i] + polarOffset(sizes[i].width / 2., mViewAngle - 90., 0.));
+        worldPoints.push_back(points[i] + polarOffset(sizes[i].height, 0., 90.));
+    }
+
+    std::vector<cv::Point2d> pixels;
+    cv::projectPoints(worldPoints, mRotationVector, mTranslationVector, mIntrinsics, mDistortion, pixels);
+
+    std::vector<cv::Rect2d> bounds(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const cv::Point2d& pixel = pixels[3 * i];
+        const cv::Point2d& left = pixels[3 * i + 1];
+        const cv::Point2d& top = pixels[3 * i + 2];
+        bounds[i] = cv::Rect2d(left.x, top.y, (pixel.x - left.x) * 2., pixel.y - top.y);
+    }
+    return bounds;
+}
+
 } // namespace rv
@@ -7,7 +7,7 @@ namespace rv {
 namespace tracking {
 
 namespace classification {
-  Classification combine(const Classification & classificationA, const Classification & classificationB)
+  Classification combine(const ClassificationRef & classificationA, const ClassificationRef & classificationB)
   {
     if (classificationA.size() != classificationB.size())
     {
@@ -24,20 +24,18 @@ namespace classification {
   }
 
 
-  double distance(const Classification & classificationA, const Classification & classificationB)
+  double distance(const ClassificationRef & classificationA, const ClassificationRef & classificationB)
   {
     if (classificationA.size() != classificationB.size())
     {
       throw std::runtime_error("The vectors should be of the same size");
     }
 
-    Classification residual = (classificationA - classificationB);
-
-    return std::sqrt(0.5 * residual.transpose() * residual);
+    return std::sqrt(0.5 * (classificationA - classificationB).squaredNorm());
   }
 
 
-  double similarity(const Classification & classificationA, const Classification & classificationB)
+  double similarity(const ClassificationRef & classificationA, const ClassificationRef & classificationB)
   {
     return 1.0 - distance(classificationA, classificationB);
   }
@@ -54,6 +52,10 @@ namespace classification {
 
   void ClassificationData::setClasses(std::vector<std::string> &classes_)
   {
+    if (classes_.size() > static_cast<std::size_t>(MaxClassificationSize))
+    {
+      throw std::runtime_error("The number of classes exceeds the maximum classification size");
+    }
     classes = classes_;
   }
 
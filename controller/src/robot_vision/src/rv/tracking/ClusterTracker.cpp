@@ -0,0 +1,396 @@
+// SPDX-FileCopyrightText: 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rv/tracking/ClusterTracker.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "rv/Utils.hpp"
+#include "rv/tracking/Measurement.hpp"
+#include "rv/tracking/ObjectMatching.hpp"
+
+namespace rv {
+namespace tracking {
+
+namespace {
+
+std::chrono::system_clock::time_point toTimePoint(double seconds)
+{
+  return addSecondsToTimestamp(std::chrono::system_clock::time_point(), std::chrono::duration<double>(seconds));
+}
+
+Measurement toMeasurement(const ClusterMeasurement &cluster, Id id)
+{
+  Measurement measurement;
+  measurement.id = id;
+  measurement.x = cluster.x;
+  measurement.y = cluster.y;
+  return measurement;
+}
+
+// Population variance, as numpy.var
+template <class Values> double variance(const Values &values)
+{
+  double mean = 0.;
+  for (auto value : values)
+  {
+    mean += value;
+  }
+  mean /= values.size();
+
+  double sum = 0.;
+  for (auto value : values)
+  {
+    sum += (value - mean) * (value - mean);
+  }
+  return sum / values.size();
+}
+
+} // namespace
+
+std::string ClusterTrackerConfig::toString() const
+{
+  return "ClusterTrackerConfig( matching_distance:" + std::to_string(mMatchingDistance)
+    + ", frames_to_activate:" + std::to_string(mFramesToActivate) + ", frames_to_stable:"
+    + std::to_string(mFramesToStable) + ", frames_to_fade:" + std::to_string(mFramesToFade) + ", frames_to_lost:"
+    + std::to_string(mFramesToLost) + ", activation_threshold:" + std::to_string(mActivationThreshold)
+    + ", stability_threshold:" + std::to_string(mStabilityThreshold) + ", archive_time:"
+    + std::to_string(mArchiveTime) + ", process_noise:" + std::to_string(mProcessNoise) + ", measurement_noise:"
+    + std::to_string(mMeasurementNoise) + ")";
+}
+
+ClusterTracker::ClusterTracker(const ClusterTrackerConfig &config) : mConfig(config)
+{
+}
+
+TrackManager &ClusterTracker::trackManager(const std::string &category)
+{
+  auto it = mTrackManagers.find(category);
+  if (it == mTrackManagers.end())
+  {
+    TrackManagerConfig config;
+    config.mMotionModels = {MotionModel::CV};
+    config.mDefaultProcessNoise = mConfig.mProcessNoise;
+    config.mDefaultMeasurementNoise = mConfig.mMeasurementNoise;
+    config.mInitStateCovariance = mConfig.mInitStateCovariance;
+    // the creation is the first detection, the track manager counts the corrections
+    config.mMaxNumberOfUnreliableFrames = mConfig.mFramesToActivate > 0u ? mConfig.mFramesToActivate - 1u : 0u;
+    // the track is dropped once the cluster missed mFramesToFade + mFramesToLost frames
+    uint32_t const nonMeasurementFrames = std::max(mConfig.mFramesToFade + mConfig.mFramesToLost, 1u) - 1u;
+    config.mNonMeasurementFramesDynamic = nonMeasurementFrames;
+    config.mNonMeasurementFramesStatic = nonMeasurementFrames;
+    it = mTrackManagers.emplace(category, TrackManager(config, false)).first;
+  }
+  return it->second;
+}
+
+void ClusterTracker::track(const std::vector<ClusterMeasurement> &measurements, double timestamp)
+{
+  mLastDeltaT = mHasTimestamp ? timestamp - mLastTimestamp : 0.;
+  mLastTimestamp = timestamp;
+  mHasTimestamp = true;
+  auto const timePoint = toTimePoint(timestamp);
+
+  // categories in the order of their first measurement, then the ones which were not measured
+  std::vector<std::string> categories;
+  std::unordered_map<std::string, std::vector<std::size_t>> byCategory;
+  for (std::size_t i = 0; i < measurements.size(); ++i)
+  {
+    auto &indices = byCategory[measurements[i].category];
+    if (indices.empty())
+    {
+      categories.push_back(measurements[i].category);
+    }
+    indices.push_back(i);
+  }
+  for (auto const &element : mTrackManagers)
+  {
+    if (byCategory.count(element.first) == 0)
+    {
+      categories.push_back(element.first);
+    }
+  }
+
+  for (auto const &category : categories)
+  {
+    auto &manager = trackManager(category);
+    auto const &indices = byCategory[category];
+
+    manager.predict(timePoint);
+    std::vector<TrackedObject> tracks = manager.getTracks();
+
+    std::vector<Measurement> categoryMeasurements;
+    categoryMeasurements.reserve(indices.size());
+    for (auto index : indices)
+    {
+      categoryMeasurements.push_back(toMeasurement(measurements[index], InvalidObjectId));
+    }
+
+    std::vector<std::pair<size_t, size_t>> assignments;
+    std::vector<size_t> unassignedTracks;
+    std::vector<size_t> unassignedMeasurements;
+    match(tracks, categoryMeasurements, assignments, unassignedTracks, unassignedMeasurements, DistanceType::Euclidean,
+          mConfig.mMatchingDistance);
+
+    std::unordered_map<Id, std::size_t> measured;
+    for (auto const &assignment : assignments)
+    {
+      auto const id = tracks[assignment.first].id;
+      manager.setMeasurement(id, categoryMeasurements[assignment.second]);
+      measured[id] = indices[assignment.second];
+    }
+    manager.correct();
+
+    // clusters are dropped rather than suspended
+    for (auto const &track : manager.getSuspendedTracks())
+    {
+      manager.deleteTrack(track.id);
+    }
+
+    for (auto &element : mClusters)
+    {
+      auto &cluster = element.second;
+      if (cluster.state.category != category || cluster.state.state == ClusterState::Lost)
+      {
+        continue;
+      }
+
+      auto const id = element.first;
+      if (!manager.hasId(id))
+      {
+        cluster.state.state = ClusterState::Lost;
+        cluster.state.framesMissed++;
+        cluster.state.totalFrames++;
+        cluster.state.lastUpdated = timestamp;
+        cluster.state.measurementIndex = -1;
+        continue;
+      }
+
+      auto const it = measured.find(id);
+      if (it != measured.end())
+      {
+        updateCluster(cluster, manager.getTrack(id), &measurements[it->second], static_cast<int64_t>(it->second),
+                      timestamp, manager.isReliable(id));
+      }
+      else
+      {
+        updateCluster(cluster, manager.getTrack(id), nullptr, -1, timestamp, manager.isReliable(id));
+      }
+    }
+
+    for (auto index : unassignedMeasurements)
+    {
+      createCluster(manager, measurements[indices[index]], static_cast<int64_t>(indices[index]), timestamp);
+    }
+  }
+
+  // archive the clusters lost for a while
+  std::vector<Id> order;
+  order.reserve(mOrder.size());
+  for (auto id : mOrder)
+  {
+    auto const &cluster = mClusters.at(id).state;
+    if (cluster.state == ClusterState::Lost && timestamp - cluster.lastSeen > mConfig.mArchiveTime)
+    {
+      mClusters.erase(id);
+    }
+    else
+    {
+      order.push_back(id);
+    }
+  }
+  mOrder.swap(order);
+}
+
+void ClusterTracker::createCluster(TrackManager &manager, const ClusterMeasurement &measurement, int64_t index,
+                                   double timestamp)
+{
+  Id const id = ++mLastId;
+  manager.createTrack(toMeasurement(measurement, id), toTimePoint(timestamp));
+
+  Cluster cluster;
+  auto &state = cluster.state;
+  state.id = id;
+  state.category = measurement.category;
+  state.state = ClusterState::New;
+  state.x = state.predictedX = measurement.x;
+  state.y = state.predictedY = measurement.y;
+  state.objectCount = measurement.objectCount;
+  state.shape = measurement.shape;
+  state.confidence = mConfig.mInitialConfidence;
+  state.framesDetected = 1u;
+  state.totalFrames = 1u;
+  state.firstSeen = state.lastSeen = state.lastUpdated = timestamp;
+  state.measurementIndex = index;
+  cluster.history.push_back({measurement.x, measurement.y, measurement.objectCount, measurement.shape});
+
+  mClusters.emplace(id, std::move(cluster));
+  mOrder.push_back(id);
+}
+
+void ClusterTracker::updateCluster(Cluster &cluster, const TrackedObject &track, const ClusterMeasurement *measurement,
+                                   int64_t index, double timestamp, bool reliable)
+{
+  auto &state = cluster.state;
+  state.x = track.x;
+  state.y = track.y;
+  state.vx = track.vx;
+  state.vy = track.vy;
+  state.predictedX = track.x + track.vx * mLastDeltaT;
+  state.predictedY = track.y + track.vy * mLastDeltaT;
+  state.totalFrames++;
+  state.lastUpdated = timestamp;
+  state.measurementIndex = index;
+
+  if (measurement != nullptr)
+  {
+    state.objectCount = measurement->objectCount;
+    state.shape = measurement->shape;
+    state.framesDetected++;
+    state.framesMissed = 0u;
+    state.lastSeen = timestamp;
+
+    cluster.history.push_back({measurement->x, measurement->y, measurement->objectCount, measurement->shape});
+    while (cluster.history.size() > std::max(mConfig.mStabilityWindow, 1u))
+    {
+      cluster.history.pop_front();
+    }
+    updateConfidence(state);
+    updateStabilityScore(cluster);
+  }
+  else
+  {
+    state.framesMissed++;
+    updateConfidence(state);
+  }
+
+  switch (state.state)
+  {
+    case ClusterState::New:
+      if (reliable && state.framesDetected >= mConfig.mFramesToActivate
+          && state.confidence > mConfig.mActivationThreshold)
+      {
+        state.state = ClusterState::Active;
+      }
+      break;
+    case ClusterState::Active:
+      if (state.framesDetected >= mConfig.mFramesToStable && state.stabilityScore > mConfig.mStabilityThreshold)
+      {
+        state.state = ClusterState::Stable;
+      }
+      else if (state.framesMissed >= mConfig.mFramesToFade)
+      {
+        state.state = ClusterState::Fading;
+      }
+      break;
+    case ClusterState::Stable:
+      if (state.framesMissed >= mConfig.mFramesToFade)
+      {
+        state.state = ClusterState::Fading;
+      }
+      break;
+    case ClusterState::Fading:
+      if (state.framesMissed == 0u)
+      {
+        state.state = ClusterState::Active;
+      }
+      break;
+    case ClusterState::Lost:
+      break;
+  }
+}
+
+void ClusterTracker::updateConfidence(TrackedCluster &cluster) const
+{
+  double const detectionRatio = static_cast<double>(cluster.framesDetected) / std::max(cluster.totalFrames, 1u);
+  double const missPenalty
+    = std::min(cluster.framesMissed * mConfig.mConfidenceMissPenalty, mConfig.mConfidenceMaxMissPenalty);
+  double const longevityBonus = std::min(
+    static_cast<double>(cluster.framesDetected) / std::max(mConfig.mConfidenceLongevityFrames, 1u),
+    mConfig.mConfidenceLongevityBonus);
+  cluster.confidence = rv::clamp(detectionRatio - missPenalty + longevityBonus, 0., 1.);
+}
+
+void ClusterTracker::updateStabilityScore(Cluster &cluster) const
+{
+  auto const &history = cluster.history;
+  if (history.size() < 3u)
+  {
+    cluster.state.stabilityScore = 0.;
+    return;
+  }
+
+  std::vector<double> xs, ys, sizes;
+  std::unordered_map<std::string, std::size_t> shapes;
+  std::size_t mostCommonShape = 0u;
+  for (auto const &observation : history)
+  {
+    xs.push_back(observation.x);
+    ys.push_back(observation.y);
+    sizes.push_back(observation.objectCount);
+    mostCommonShape = std::max(mostCommonShape, ++shapes[observation.shape]);
+  }
+
+  double const positionStability = 1. / (1. + 0.5 * (variance(xs) + variance(ys)));
+  double const sizeStability = 1. / (1. + variance(sizes));
+  double const shapeConsistency = static_cast<double>(mostCommonShape) / history.size();
+
+  cluster.state.stabilityScore = 0.4 * positionStability + 0.3 * sizeStability + 0.3 * shapeConsistency;
+}
+
+std::vector<TrackedCluster> ClusterTracker::getClusters() const
+{
+  std::vector<TrackedCluster> clusters;
+  clusters.reserve(mOrder.size());
+  for (auto id : mOrder)
+  {
+    clusters.push_back(mClusters.at(id).state);
+  }
+  return clusters;
+}
+
+TrackedCluster ClusterTracker::getCluster(Id id) const
+{
+  auto const it = mClusters.find(id);
+  if (it == mClusters.end())
+  {
+    throw std::runtime_error("The given id is not registered in this ClusterTracker.");
+  }
+  return it->second.state;
+}
+
+std::size_t ClusterTracker::clearCategory(const std::string &category)
+{
+  std::size_t cleared = 0u;
+  std::vector<Id> order;
+  order.reserve(mOrder.size());
+  for (auto id : mOrder)
+  {
+    auto const &cluster = mClusters.at(id).state;
+    if (cluster.category == category)
+    {
+      cleared += cluster.state != ClusterState::Lost ? 1u : 0u;
+      mClusters.erase(id);
+    }
+    else
+    {
+      order.push_back(id);
+    }
+  }
+  mOrder.swap(order);
+  mTrackManagers.erase(category);
+  return cleared;
+}
+
+void ClusterTracker::reset()
+{
+  mTrackManagers.clear();
+  mClusters.clear();
+  mOrder.clear();
+  mHasTimestamp = false;
+  mLastDeltaT = 0.;
+}
+
+} // namespace tracking
+} // namespace rv
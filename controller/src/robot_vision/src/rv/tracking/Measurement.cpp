@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rv/tracking/Measurement.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace rv {
+namespace tracking {
+
+static_assert(std::is_trivially_copyable<Measurement>::value, "Measurement must stay trivially copyable");
+
+void Measurement::setClassification(const ClassificationRef &probabilities)
+{
+  if (probabilities.size() < 1 || probabilities.size() > MaxClasses)
+  {
+    throw std::runtime_error("The number of classes of a Measurement must be between 1 and "
+                             + std::to_string(MaxClasses));
+  }
+
+  numClasses = static_cast<int32_t>(probabilities.size());
+  Eigen::Map<Eigen::VectorXd>(classification, numClasses) = probabilities;
+  score = probabilities.maxCoeff();
+}
+
+cv::Mat Measurement::measurementVector() const
+{
+  cv::Mat vector(TrackedObject::MeasurementSize, 1, CV_64F);
+  vector.at<double>(0, 0) = x;
+  vector.at<double>(1, 0) = y;
+  vector.at<double>(2, 0) = z;
+  vector.at<double>(3, 0) = length;
+  vector.at<double>(4, 0) = width;
+  vector.at<double>(5, 0) = height;
+  vector.at<double>(6, 0) = yaw;
+
+  return vector;
+}
+
+TrackedObject Measurement::toTrackedObject() const
+{
+  TrackedObject object;
+  object.id = id;
+  object.x = x;
+  object.y = y;
+  object.z = z;
+  object.yaw = yaw;
+  object.length = length;
+  object.width = width;
+  object.height = height;
+  object.classification = classificationVector();
+  object.userData = userData;
+
+  return object;
+}
+
+Measurement Measurement::fromTrackedObject(const TrackedObject &object)
+{
+  Measurement measurement;
+  measurement.id = object.id;
+  measurement.x = object.x;
+  measurement.y = object.y;
+  measurement.z = object.z;
+  measurement.yaw = object.yaw;
+  measurement.length = object.length;
+  measurement.width = object.width;
+  measurement.height = object.height;
+  measurement.setClassification(object.classification);
+  measurement.userData = object.userData;
+
+  return measurement;
+}
+
+} // namespace tracking
+} // namespace rv
@@ -7,10 +7,59 @@
 #include "rv/tracking/CVModel.hpp"
 #include "rv/tracking/CPModel.hpp"
 #include "rv/tracking/Classification.hpp"
+#include <algorithm>
 
 namespace rv {
 namespace tracking {
 
+namespace {
+// the filters may run in single precision while the tracked objects and the model probabilities stay in double
+cv::Mat toDataType(const cv::Mat &matrix, int dataType)
+{
+  if (matrix.empty() || matrix.type() == dataType)
+  {
+    return matrix;
+  }
+  cv::Mat converted;
+  matrix.convertTo(converted, dataType);
+  return converted;
+}
+
+// the tracked objects hold fixed size Eigen blocks while the filters work on cv::Mat
+template <class Derived> void copyToEigen(const cv::Mat &matrix, Eigen::MatrixBase<Derived> &values)
+{
+  cv::Mat converted = toDataType(matrix, CV_64F);
+  for (int r = 0; r < values.rows(); ++r)
+  {
+    for (int c = 0; c < values.cols(); ++c)
+    {
+      values(r, c) = converted.at<double>(r, c);
+    }
+  }
+}
+
+template <class Derived> cv::Mat toMat(const Eigen::MatrixBase<Derived> &values, int dataType)
+{
+  cv::Mat matrix(static_cast<int>(values.rows()), static_cast<int>(values.cols()), CV_64F);
+  for (int r = 0; r < values.rows(); ++r)
+  {
+    for (int c = 0; c < values.cols(); ++c)
+    {
+      matrix.at<double>(r, c) = values(r, c);
+    }
+  }
+  return toDataType(matrix, dataType);
+}
+
+// the association uses the inverse of the predicted measurement covariance, it is refreshed with the covariance
+void setMeasurementCovariance(const cv::Mat &covariance, TrackedObject &state)
+{
+  cv::Mat doubleCovariance = toDataType(covariance, CV_64F);
+  copyToEigen(doubleCovariance, state.predictedMeasurementCov);
+  copyToEigen(doubleCovariance.inv(cv::DECOMP_SVD), state.predictedMeasurementCovInv);
+}
+} // namespace
+
 MultiModelKalmanEstimator::MultiModelKalmanEstimator(double alpha, double beta)
   : mAlpha(alpha)
   , mBeta(beta)
@@ -21,17 +70,20 @@ MultiModelKalmanEstimator::MultiModelKalmanEstimator(double alpha, double beta)
   mKappa = 3.0 - mDP; // 3 - state_size
 }
 
-void MultiModelKalmanEstimator::initialize(TrackedObject track, const std::chrono::system_clock::time_point &timestamp, double processNoise, double measurementNoise, double initStateCovariance, const std::vector<MotionModel> &motionModels)
+void MultiModelKalmanEstimator::initialize(TrackedObject track, const std::chrono::system_clock::time_point &timestamp, double processNoise, double measurementNoise, double initStateCovariance, const std::vector<MotionModel> &motionModels, bool useSquareRootFilter, int dataType)
 {
   mLastTimestamp = timestamp;
+  mDataType = dataType;
 
   mSystemModels.clear();
+  mMotionModels.clear();
 
   if (motionModels.empty())
   {
     mSystemModels.push_back(cv::makePtr<tracking::CTRVModel>());
     mSystemModels.push_back(cv::makePtr<tracking::CVModel>());
     mSystemModels.push_back(cv::makePtr<tracking::CAModel>());
+    mMotionModels = {MotionModel::CTRV, MotionModel::CV, MotionModel::CA};
   }
   else
   {
@@ -52,8 +104,9 @@ void MultiModelKalmanEstimator::initialize(TrackedObject track, const std::chron
           mSystemModels.push_back(cv::makePtr<tracking::CTRVModel>());
           break;
         default:
-          break;
+          continue;
       }
+      mMotionModels.push_back(motionModel);
     }
   }
 
@@ -72,50 +125,66 @@ void MultiModelKalmanEstimator::initialize(TrackedObject track, const std::chron
   mTransitionProbability = cv::Mat(mNumberOfModels, mNumberOfModels, CV_64F, cv::Scalar(pxOtherModels));
   mTransitionProbability += cv::Mat::eye(mNumberOfModels, mNumberOfModels, CV_64F) * pxSameModel;
 
+  // All filters of the estimator are run sequentially, so they can share the sigma point scratch buffers
+  mWorkspace = cv::makePtr<cv::detail::tracking::UkfWorkspace>();
+
   for (auto &model : mSystemModels)
   {
     cv::detail::tracking::UnscentedKalmanFilterParams modelParams;
-    modelParams = cv::detail::tracking::UnscentedKalmanFilterParams(mDP, mMP, mCP, 0, 0, model);
-    modelParams.stateInit = track.stateVector().clone();
-    modelParams.errorCovInit = cv::Mat::eye(mDP, mDP, CV_64F) * initStateCovariance;
-    modelParams.measurementNoiseCov = cv::Mat::eye(mMP, mMP, CV_64F) * measurementNoise;
-    modelParams.processNoiseCov = cv::Mat::eye(mDP, mDP, CV_64F) * processNoise;
+    modelParams = cv::detail::tracking::UnscentedKalmanFilterParams(mDP, mMP, mCP, 0, 0, model, mDataType);
+    modelParams.stateInit = toDataType(track.stateVector(), mDataType);
+    modelParams.errorCovInit = cv::Mat::eye(mDP, mDP, mDataType) * initStateCovariance;
+    modelParams.measurementNoiseCov = cv::Mat::eye(mMP, mMP, mDataType) * measurementNoise;
+    modelParams.processNoiseCov = cv::Mat::eye(mDP, mDP, mDataType) * processNoise;
     modelParams.alpha = mAlpha;
     modelParams.beta = mBeta;
     modelParams.k = mKappa;
-    mKalmanFilters.push_back(createUnscentedKalmanFilterMod(modelParams));
+    mKalmanFilters.push_back(createUnscentedKalmanFilterMod(modelParams, mWorkspace, useSquareRootFilter));
     mSystemModelStates.push_back(track);
   }
 
+  mActiveModels.clear();
+  for (std::size_t i = 0; i < mNumberOfModels; ++i)
+  {
+    mActiveModels.push_back(i);
+  }
+  mPinnedFrames.assign(mNumberOfModels, 0u);
+
   mCurrentState = std::move(track);
 }
 
+void MultiModelKalmanEstimator::setModelPruning(bool enabled, uint32_t pruningFrames, double reactivationThreshold)
+{
+  mModelPruning = enabled;
+  mModelPruningFrames = pruningFrames;
+  mModelReactivationThreshold = reactivationThreshold;
+}
+
 
-void MultiModelKalmanEstimator::singleModelPredict(double deltaT)
+void MultiModelKalmanEstimator::singleModelPredict(double deltaT, std::size_t model)
 {
-  cv::Mat deltaTVector = cv::Mat(mCP, 1, CV_64F, cv::Scalar(deltaT));
-  cv::Mat noiseVector = cv::Mat::zeros(mMP, 1, CV_64F);
+  cv::Mat deltaTVector = cv::Mat(mCP, 1, mDataType, cv::Scalar(deltaT));
+  cv::Mat noiseVector = cv::Mat::zeros(mMP, 1, mDataType);
+  cv::Mat predictedMeasurement = cv::Mat::zeros(mMP, 1, mDataType);
 
-  auto predictedState = mKalmanFilters[0]->predict(deltaTVector);
+  auto predictedState = mKalmanFilters[model]->predict(deltaTVector);
 
   mCurrentState.previousYaw = mCurrentState.yaw;
-  mCurrentState.setStateVector(predictedState); // combined current state
-  mCurrentState.errorCovariance = mKalmanFilters[0]->getErrorCov();
-  mCurrentState.predictedMeasurementMean = cv::Mat::zeros(mMP, 1, CV_64F);
+  mCurrentState.setStateVector(toDataType(predictedState, CV_64F)); // combined current state
+  copyToEigen(mKalmanFilters[model]->getErrorCov(), mCurrentState.errorCovariance);
 
-  mSystemModels[0]->measurementFunction(predictedState, noiseVector, mCurrentState.predictedMeasurementMean);
+  mSystemModels[model]->measurementFunction(predictedState, noiseVector, predictedMeasurement);
+  copyToEigen(predictedMeasurement, mCurrentState.predictedMeasurementMean);
 
-  if (mKalmanFilters[0]->getMeasurementCov().empty())
+  if (mKalmanFilters[model]->getMeasurementCov().empty())
   {
-    mCurrentState.predictedMeasurementCov = mKalmanFilters[0]->getMeasurementNoiseCov();
+    setMeasurementCovariance(mKalmanFilters[model]->getMeasurementNoiseCov(), mCurrentState);
   }
   else
   {
-    mCurrentState.predictedMeasurementCov = mKalmanFilters[0]->getMeasurementCov();
+    setMeasurementCovariance(mKalmanFilters[model]->getMeasurementCov(), mCurrentState);
   }
 
-  mCurrentState.predictedMeasurementCovInv = mCurrentState.predictedMeasurementCov.inv(cv::DECOMP_SVD);
-
   if (deltaT >= 1e-3)
   {
     mCurrentState.corrected = false;
@@ -136,71 +205,137 @@ void MultiModelKalmanEstimator::predict(const double deltaT)
   mLastTimestamp = addSecondsToTimestamp(mLastTimestamp, std::chrono::duration<double>(deltaT));
 }
 
-void MultiModelKalmanEstimator::predictState(const double deltaT)
+void MultiModelKalmanEstimator::deferPrediction(const std::chrono::system_clock::time_point &timestamp)
 {
-  if (mNumberOfModels == 1)
+  deferPrediction(rv::toSeconds(timestamp - mLastTimestamp));
+}
+
+void MultiModelKalmanEstimator::deferPrediction(const double deltaT)
+{
+  mPendingDeltaT += deltaT;
+  mPendingPredictionFrames++;
+
+  auto &state = mCurrentState;
+  state.x += (state.vx + 0.5 * state.ax * deltaT) * deltaT;
+  state.y += (state.vy + 0.5 * state.ay * deltaT) * deltaT;
+  state.vx += state.ax * deltaT;
+  state.vy += state.ay * deltaT;
+
+  state.predictedMeasurementMean(0) = state.x;
+  state.predictedMeasurementMean(1) = state.y;
+
+  if (deltaT >= 1e-3)
   {
-    return singleModelPredict(deltaT);
+    state.corrected = false;
   }
 
-  cv::Mat deltaTVector = cv::Mat(mCP, 1, CV_64F, cv::Scalar(deltaT));
-  cv::Mat noiseVector = cv::Mat::zeros(mMP, 1, CV_64F);
-  cv::Mat conditionalProbability = cv::Mat::zeros(mNumberOfModels, mNumberOfModels, CV_64F);
+  mLastTimestamp = addSecondsToTimestamp(mLastTimestamp, std::chrono::duration<double>(deltaT));
+}
 
-  combiningProbability(mTransitionProbability, mModelProbability, conditionalProbability);
+void MultiModelKalmanEstimator::completePrediction()
+{
+  if (mPendingPredictionFrames == 0u)
+  {
+    return;
+  }
 
-  std::vector<cv::Mat> states;
-  std::vector<cv::Mat> covariances;
+  // the filters still hold the state of the last full prediction, the extrapolated mean is replaced
+  predictState(0.);
+}
+
+void MultiModelKalmanEstimator::predictState(double deltaT)
+{
+  deltaT += mPendingDeltaT;
+  mPendingDeltaT = 0.;
+  mPendingPredictionFrames = 0u;
 
-  for (auto const &state : mSystemModelStates)
+  if (mActiveModels.size() == 1)
   {
-    states.push_back(state.stateVector());
+    return singleModelPredict(deltaT, mActiveModels[0]);
   }
-  for (auto const &kalmanFilter : mKalmanFilters)
+
+  cv::Mat deltaTVector = cv::Mat(mCP, 1, mDataType, cv::Scalar(deltaT));
+  cv::Mat noiseVector = cv::Mat::zeros(mMP, 1, mDataType);
+  cv::Mat conditionalProbability = cv::Mat::zeros(mActiveModels.size(), mActiveModels.size(), CV_64F);
+  cv::Mat transitionProbability;
+  cv::Mat modelProbability;
+
+  activeModelProbabilities(transitionProbability, modelProbability);
+  combiningProbability(transitionProbability, modelProbability, conditionalProbability);
+
+  // the square-root filters are mixed through the cholesky factors of their covariances, which are not formed
+  bool const squareRoot = mKalmanFilters[mActiveModels[0]]->isSquareRoot();
+
+  std::vector<cv::Mat> states;
+  std::vector<cv::Mat> covariances;
+
+  for (auto const i : mActiveModels)
   {
-    covariances.push_back(kalmanFilter->getErrorCov());
+    states.push_back(toDataType(mSystemModelStates[i].stateVector(), mDataType));
+    covariances.push_back(squareRoot ? mKalmanFilters[i]->errorCovFactorRef() : mKalmanFilters[i]->getErrorCov());
   }
 
   std::vector<cv::Mat> covarianceEstimate;
   std::vector<cv::Mat> stateEstimate;
 
-  interaction(states, covariances, conditionalProbability, covarianceEstimate, stateEstimate);
+  if (squareRoot)
+  {
+    interactionFactors(states, covariances, conditionalProbability, covarianceEstimate, stateEstimate);
+  }
+  else
+  {
+    interaction(states, covariances, conditionalProbability, covarianceEstimate, stateEstimate);
+  }
 
   std::vector<cv::Mat> predictedStates;
   std::vector<cv::Mat> predictedStateCovariances;
+  std::vector<cv::Mat> measurements;
 
-  for (std::size_t i = 0; i < mNumberOfModels; ++i)
+  for (std::size_t j = 0; j < mActiveModels.size(); ++j)
   {
-    mKalmanFilters[i]->setStateAndCovariance(stateEstimate[i], covarianceEstimate[i]);
-    mSystemModelStates[i].predictedMeasurementMean = cv::Mat::zeros(mMP, 1, CV_64F);
+    auto const i = mActiveModels[j];
+    if (squareRoot)
+    {
+      mKalmanFilters[i]->setStateAndCovarianceFactor(stateEstimate[j], covarianceEstimate[j]);
+    }
+    else
+    {
+      mKalmanFilters[i]->setStateAndCovariance(stateEstimate[j], covarianceEstimate[j]);
+    }
+    cv::Mat predictedMeasurement = cv::Mat::zeros(mMP, 1, mDataType);
     auto predictedState = mKalmanFilters[i]->predict(deltaTVector);
     predictedStates.push_back(predictedState);
-    predictedStateCovariances.push_back(mKalmanFilters[i]->getErrorCov());
-    mSystemModelStates[i].setStateVector(predictedState);
-    mSystemModels[i]->measurementFunction(predictedState, noiseVector, mSystemModelStates[i].predictedMeasurementMean);
+    predictedStateCovariances.push_back(squareRoot ? mKalmanFilters[i]->errorCovFactorRef() : mKalmanFilters[i]->getErrorCov());
+    mSystemModelStates[i].setStateVector(toDataType(predictedState, CV_64F));
+    mSystemModels[i]->measurementFunction(predictedState, noiseVector, predictedMeasurement);
+    copyToEigen(predictedMeasurement, mSystemModelStates[i].predictedMeasurementMean);
+    measurements.push_back(predictedMeasurement);
   }
 
   cv::Mat combinedState;
   cv::Mat combinedCovariance;
-  combineStatesAndCovariances(
-    predictedStates, predictedStateCovariances, mModelProbability, combinedState, combinedCovariance);
+  if (squareRoot)
+  {
+    combineStatesAndCovarianceFactors(
+      predictedStates, predictedStateCovariances, modelProbability, combinedState, combinedCovariance);
+  }
+  else
+  {
+    combineStatesAndCovariances(
+      predictedStates, predictedStateCovariances, modelProbability, combinedState, combinedCovariance);
+  }
 
   // save yaw before it is replaced by the predicted one
   mCurrentState.previousYaw = mCurrentState.yaw;
-  mCurrentState.setStateVector(combinedState); // combined current state
-  mCurrentState.errorCovariance = combinedCovariance;
+  mCurrentState.setStateVector(toDataType(combinedState, CV_64F)); // combined current state
+  copyToEigen(combinedCovariance, mCurrentState.errorCovariance);
 
   // calculate combined measurement mean and covariance necessary for association
-  std::vector<cv::Mat> measurements;
   std::vector<cv::Mat> measurementCovariances;
 
-  for (auto const &state : mSystemModelStates)
-  {
-    measurements.push_back(state.predictedMeasurementMean);
-  }
-
-  for (auto const &kalmanFilter : mKalmanFilters)
+  for (auto const i : mActiveModels)
   {
+    auto const &kalmanFilter = mKalmanFilters[i];
     if (kalmanFilter->getMeasurementCov().empty())
     {
       measurementCovariances.push_back(kalmanFilter->getMeasurementNoiseCov());
@@ -214,11 +349,10 @@ void MultiModelKalmanEstimator::predictState(const double deltaT)
   cv::Mat combinedMeasurement;
   cv::Mat combinedMeasurementCovariance;
   combineStatesAndCovariances(
-    measurements, measurementCovariances, mModelProbability, combinedMeasurement, combinedMeasurementCovariance);
+    measurements, measurementCovariances, modelProbability, combinedMeasurement, combinedMeasurementCovariance);
 
-  mCurrentState.predictedMeasurementMean = combinedMeasurement;
-  mCurrentState.predictedMeasurementCov = combinedMeasurementCovariance;
-  mCurrentState.predictedMeasurementCovInv = combinedMeasurementCovariance.inv(cv::DECOMP_SVD);
+  copyToEigen(combinedMeasurement, mCurrentState.predictedMeasurementMean);
+  setMeasurementCovariance(combinedMeasurementCovariance, mCurrentState);
 
   if (deltaT >= 1e-3)
   {
@@ -227,25 +361,62 @@ void MultiModelKalmanEstimator::predictState(const double deltaT)
 }
 
 
-void MultiModelKalmanEstimator::singleModelCorrect(const TrackedObject &measurement)
+void MultiModelKalmanEstimator::singleModelCorrect(const Measurement &measurement, std::size_t model)
 {
   auto newMeasurement = measurement;
   newMeasurement.yaw = mCurrentState.previousYaw - rv::deltaTheta(measurement.yaw, mCurrentState.previousYaw);
-  auto correctedState = mKalmanFilters[0]->correct(newMeasurement.measurementVector());
+  auto correctedState = mKalmanFilters[model]->correct(toDataType(newMeasurement.measurementVector(), mDataType));
 
-  mCurrentState.errorCovariance = mKalmanFilters[0]->getErrorCov();
-  mCurrentState.setStateVector(correctedState);
+  copyToEigen(mKalmanFilters[model]->getErrorCov(), mCurrentState.errorCovariance);
+  mCurrentState.setStateVector(toDataType(correctedState, CV_64F));
 
-  mCurrentState.classification = rv::tracking::classification::combine(mCurrentState.classification , measurement.classification);
-  mCurrentState.attributes = measurement.attributes;
+  mCurrentState.classification = rv::tracking::classification::combine(mCurrentState.classification , measurement.classificationVector());
   mCurrentState.corrected = true;
 }
 
 void MultiModelKalmanEstimator::correct(const TrackedObject &measurement)
 {
-  if (mNumberOfModels == 1)
+  correct(Measurement::fromTrackedObject(measurement), measurement.attributes);
+}
+
+void MultiModelKalmanEstimator::correct(const Measurement &measurement, std::shared_ptr<const Attributes> attributes)
+{
+  correct(measurement);
+  mCurrentState.attributes = std::move(attributes);
+}
+
+void MultiModelKalmanEstimator::correct(const Measurement &measurement)
+{
+  completePrediction();
+
+  // the innovation is measured against the prediction, so before the state is corrected
+  bool hasFrozenModels = mModelPruning && mActiveModels.size() < mNumberOfModels;
+  double innovationStatistic = hasFrozenModels ? normalizedInnovationSquared(measurement) : 0.;
+
+  correctState(measurement);
+  mCurrentState.userData = measurement.userData;
+
+  // a maneuver shows as a jump of the innovation with respect to its running average while the models are frozen,
+  // the absolute value is not used as the noise parameters are not tuned for a consistent filter
+  if (hasFrozenModels && mInnovationAverage > 0. && innovationStatistic > mModelReactivationThreshold * mInnovationAverage)
+  {
+    reactivateModels(innovationStatistic);
+  }
+  else if (hasFrozenModels)
+  {
+    mInnovationAverage = mInnovationAverage > 0. ? 0.9 * mInnovationAverage + 0.1 * innovationStatistic : innovationStatistic;
+  }
+  else if (mModelPruning)
   {
-    return singleModelCorrect(measurement);
+    updateModelPruning();
+  }
+}
+
+void MultiModelKalmanEstimator::correctState(const Measurement &measurement)
+{
+  if (mActiveModels.size() == 1)
+  {
+    return singleModelCorrect(measurement, mActiveModels[0]);
   }
 
   auto newMeasurement = measurement;
@@ -255,38 +426,224 @@ void MultiModelKalmanEstimator::correct(const TrackedObject &measurement)
   std::vector<cv::Mat> covariances;
   std::vector<cv::Mat> predictedMeasurements;
   std::vector<cv::Mat> measurementCovariances;
+  cv::Mat measurementVector = toDataType(newMeasurement.measurementVector(), mDataType);
+  bool const squareRoot = mKalmanFilters[mActiveModels[0]]->isSquareRoot();
 
-  for (std::size_t i = 0; i < mNumberOfModels; ++i)
+  for (auto const i : mActiveModels)
   {
-    auto correctedState = mKalmanFilters[i]->correct(newMeasurement.measurementVector());
-    mSystemModelStates[i].setStateVector(correctedState);
+    auto correctedState = mKalmanFilters[i]->correct(measurementVector);
+    mSystemModelStates[i].setStateVector(toDataType(correctedState, CV_64F));
 
     states.push_back(correctedState);
-    covariances.push_back(mKalmanFilters[i]->getErrorCov());
-    predictedMeasurements.push_back(mSystemModelStates[i].predictedMeasurementMean);
-    measurementCovariances.push_back(mKalmanFilters[i]->getMeasurementCov());
+    covariances.push_back(squareRoot ? mKalmanFilters[i]->errorCovFactorRef() : mKalmanFilters[i]->getErrorCov());
+    predictedMeasurements.push_back(toMat(mSystemModelStates[i].predictedMeasurementMean, CV_64F));
+    // the model likelihood needs the log-determinant, it is evaluated in double
+    measurementCovariances.push_back(toDataType(mKalmanFilters[i]->getMeasurementCov(), CV_64F));
   }
 
   cv::Mat combinedState;
   cv::Mat combinedCovariance;
+  cv::Mat transitionProbability;
+  cv::Mat modelProbability;
 
+  activeModelProbabilities(transitionProbability, modelProbability);
   updateModelProbability(newMeasurement.measurementVector(),
                          predictedMeasurements,
                          measurementCovariances,
-                         mModelProbability,
+                         modelProbability,
                          mMaxProbability,
                          mMinProbability);
-  combineStatesAndCovariances(states, covariances, mModelProbability, combinedState, combinedCovariance);
+  if (squareRoot)
+  {
+    combineStatesAndCovarianceFactors(states, covariances, modelProbability, combinedState, combinedCovariance);
+  }
+  else
+  {
+    combineStatesAndCovariances(states, covariances, modelProbability, combinedState, combinedCovariance);
+  }
 
-  mCurrentState.errorCovariance = combinedCovariance;
-  mCurrentState.setStateVector(combinedState);
+  // with frozen models the probabilities are a copy of the active subset
+  for (std::size_t j = 0; modelProbability.data != mModelProbability.data && j < mActiveModels.size(); ++j)
+  {
+    mModelProbability.at<double>(mActiveModels[j], 0) = modelProbability.at<double>(j, 0);
+  }
 
-  mCurrentState.classification = rv::tracking::classification::combine(mCurrentState.classification , measurement.classification);
-  mCurrentState.attributes = measurement.attributes;
+  copyToEigen(combinedCovariance, mCurrentState.errorCovariance);
+  mCurrentState.setStateVector(toDataType(combinedState, CV_64F));
+
+  mCurrentState.classification = rv::tracking::classification::combine(mCurrentState.classification , measurement.classificationVector());
 
   mCurrentState.corrected = true;
 }
 
+void MultiModelKalmanEstimator::activeModelProbabilities(cv::Mat &transitionProbability,
+                                                         cv::Mat &modelProbability) const
+{
+  if (mActiveModels.size() == mNumberOfModels)
+  {
+    transitionProbability = mTransitionProbability;
+    modelProbability = mModelProbability;
+    return;
+  }
+
+  auto const nActive = static_cast<int>(mActiveModels.size());
+  transitionProbability = cv::Mat(nActive, nActive, CV_64F);
+  modelProbability = cv::Mat(nActive, 1, CV_64F);
+
+  for (int a = 0; a < nActive; ++a)
+  {
+    // the transitions to the frozen models are redistributed to the active ones
+    double rowSum = 0.;
+    for (int b = 0; b < nActive; ++b)
+    {
+      transitionProbability.at<double>(a, b) = mTransitionProbability.at<double>(mActiveModels[a], mActiveModels[b]);
+      rowSum += transitionProbability.at<double>(a, b);
+    }
+    for (int b = 0; b < nActive; ++b)
+    {
+      transitionProbability.at<double>(a, b) /= rowSum;
+    }
+
+    modelProbability.at<double>(a, 0) = mModelProbability.at<double>(mActiveModels[a], 0);
+  }
+}
+
+double MultiModelKalmanEstimator::normalizedInnovationSquared(const Measurement &measurement) const
+{
+  MeasurementVector innovation;
+  innovation << measurement.x, measurement.y, measurement.z, measurement.length, measurement.width, measurement.height,
+    mCurrentState.previousYaw - rv::deltaTheta(measurement.yaw, mCurrentState.previousYaw);
+  innovation -= mCurrentState.predictedMeasurementMean;
+
+  return innovation.dot(mCurrentState.predictedMeasurementCovInv * innovation);
+}
+
+void MultiModelKalmanEstimator::updateModelPruning()
+{
+  if (mActiveModels.size() < 2)
+  {
+    return;
+  }
+
+  // a model is pinned when its probability before the [min,max] rescaling is below 1%
+  double const pinnedProbability = mMinProbability + 0.01 * (mMaxProbability - mMinProbability);
+
+  std::size_t mostLikelyModel = mActiveModels[0];
+  for (auto const i : mActiveModels)
+  {
+    if (mModelProbability.at<double>(i, 0) > mModelProbability.at<double>(mostLikelyModel, 0))
+    {
+      mostLikelyModel = i;
+    }
+  }
+
+  std::vector<std::size_t> prunedModels;
+  for (auto const i : mActiveModels)
+  {
+    if (i != mostLikelyModel && mModelProbability.at<double>(i, 0) <= pinnedProbability)
+    {
+      mPinnedFrames[i]++;
+    }
+    else
+    {
+      mPinnedFrames[i] = 0u;
+    }
+
+    if (mPinnedFrames[i] >= mModelPruningFrames)
+    {
+      prunedModels.push_back(i);
+    }
+  }
+
+  if (prunedModels.empty())
+  {
+    return;
+  }
+
+  for (auto const i : prunedModels)
+  {
+    mActiveModels.erase(std::remove(mActiveModels.begin(), mActiveModels.end(), i), mActiveModels.end());
+    mPinnedFrames[i] = 0u;
+    mModelProbability.at<double>(i, 0) = 0.;
+
+    ModelPruningEvent event;
+    event.type = ModelPruningEvent::Type::Pruned;
+    event.id = mCurrentState.id;
+    event.model = i;
+    event.motionModel = mMotionModels[i];
+    event.timestamp = mLastTimestamp;
+    mModelPruningEvents.push_back(event);
+  }
+
+  // the probability of the frozen models is given to the remaining ones
+  mModelProbability /= cv::sum(mModelProbability)[0];
+  mInnovationAverage = 0.;
+}
+
+void MultiModelKalmanEstimator::reactivateModels(double innovationStatistic)
+{
+  // the frozen filters kept a stale state, they are restarted from the combined estimate
+  cv::Mat state = mCurrentState.stateVector();
+  double reactivatedProbability = 0.;
+
+  for (std::size_t i = 0; i < mNumberOfModels; ++i)
+  {
+    mSystemModelStates[i].setStateVector(state);
+
+    if (isModelActive(i))
+    {
+      continue;
+    }
+
+    auto const &previousFilter = mKalmanFilters[i];
+    cv::detail::tracking::UnscentedKalmanFilterParams modelParams(mDP, mMP, mCP, 0, 0, mSystemModels[i], mDataType);
+    modelParams.stateInit = toDataType(state, mDataType).clone();
+    modelParams.errorCovInit = toMat(mCurrentState.errorCovariance, mDataType);
+    modelParams.measurementNoiseCov = previousFilter->getMeasurementNoiseCov();
+    modelParams.processNoiseCov = previousFilter->getProcessNoiseCov();
+    modelParams.alpha = mAlpha;
+    modelParams.beta = mBeta;
+    modelParams.k = mKappa;
+    mKalmanFilters[i] = createUnscentedKalmanFilterMod(modelParams, mWorkspace, previousFilter->isSquareRoot());
+
+    mModelProbability.at<double>(i, 0) = mMinProbability;
+    reactivatedProbability += mMinProbability;
+
+    ModelPruningEvent event;
+    event.type = ModelPruningEvent::Type::Reactivated;
+    event.id = mCurrentState.id;
+    event.model = i;
+    event.motionModel = mMotionModels[i];
+    event.timestamp = mLastTimestamp;
+    event.innovationStatistic = innovationStatistic;
+    mModelPruningEvents.push_back(event);
+  }
+
+  // keep the probabilities of the models which stayed active in proportion
+  for (auto const i : mActiveModels)
+  {
+    mModelProbability.at<double>(i, 0) *= (1. - reactivatedProbability);
+  }
+
+  mActiveModels.clear();
+  for (std::size_t i = 0; i < mNumberOfModels; ++i)
+  {
+    mActiveModels.push_back(i);
+  }
+}
+
+bool MultiModelKalmanEstimator::isModelActive(std::size_t j) const
+{
+  return std::find(mActiveModels.begin(), mActiveModels.end(), j) != mActiveModels.end();
+}
+
+std::vector<ModelPruningEvent> MultiModelKalmanEstimator::popModelPruningEvents()
+{
+  std::vector<ModelPruningEvent> events;
+  events.swap(mModelPruningEvents);
+  return events;
+}
+
 void MultiModelKalmanEstimator::combiningProbability(cv::Mat const &transitionProbability,
                                                      cv::Mat const &modelProbability,
                                                      cv::Mat &conditionalProbablity)
@@ -325,9 +682,9 @@ void MultiModelKalmanEstimator::interaction(std::vector<cv::Mat> const &states,
 
   for (int j = 0; j < nModels; j++)
   {
-    stateEstimates.push_back(cv::Mat::zeros(stateSize, 1, CV_64F));
+    stateEstimates.push_back(cv::Mat::zeros(stateSize, 1, states[0].type()));
 
-    covarianceEstimate.push_back(cv::Mat::zeros(stateSize, stateSize, CV_64F));
+    covarianceEstimate.push_back(cv::Mat::zeros(stateSize, stateSize, states[0].type()));
   }
 
   for (std::size_t j = 0; j < nModels; ++j)
@@ -348,6 +705,33 @@ void MultiModelKalmanEstimator::interaction(std::vector<cv::Mat> const &states,
   }
 }
 
+void MultiModelKalmanEstimator::interactionFactors(std::vector<cv::Mat> const &states,
+                                                   std::vector<cv::Mat> const &covarianceFactors,
+                                                   cv::Mat const &conditionalProbablity,
+                                                   std::vector<cv::Mat> &covarianceFactorEstimate,
+                                                   std::vector<cv::Mat> &stateEstimates)
+{
+  auto nModels = conditionalProbablity.size[0];
+  auto stateSize = states[0].size[0];
+
+  covarianceFactorEstimate.resize(nModels);
+  stateEstimates.clear();
+
+  std::vector<double> weights(nModels);
+  for (std::size_t j = 0; j < nModels; ++j)
+  {
+    stateEstimates.push_back(cv::Mat::zeros(stateSize, 1, states[0].type()));
+    for (std::size_t i = 0; i < nModels; ++i)
+    {
+      weights[i] = conditionalProbablity.at<double>(i, j);
+      stateEstimates[j] += states[i] * weights[i];
+    }
+
+    cv::detail::tracking::mixCovarianceFactors(
+      states, covarianceFactors, weights, stateEstimates[j], covarianceFactorEstimate[j]);
+  }
+}
+
 void inline expNormalize(const std::vector<double> &values, std::vector<double> &normalizedValues)
 {
   normalizedValues.clear();
@@ -443,8 +827,8 @@ void MultiModelKalmanEstimator::combineStatesAndCovariances(std::vector<cv::Mat>
   auto nModels = modelProbability.size[0];
   auto stateSize = states[0].size[0];
 
-  combinedState = cv::Mat::zeros(stateSize, 1, CV_64F);
-  combinedCovariance = cv::Mat::zeros(stateSize, stateSize, CV_64F);
+  combinedState = cv::Mat::zeros(stateSize, 1, states[0].type());
+  combinedCovariance = cv::Mat::zeros(stateSize, stateSize, states[0].type());
 
   // First calculate the mean (combined state)
   for (std::size_t i = 0; i < nModels; ++i)
@@ -459,6 +843,27 @@ void MultiModelKalmanEstimator::combineStatesAndCovariances(std::vector<cv::Mat>
   }
 }
 
+void MultiModelKalmanEstimator::combineStatesAndCovarianceFactors(std::vector<cv::Mat> const &states,
+                                                                  std::vector<cv::Mat> const &covarianceFactors,
+                                                                  cv::Mat const &modelProbability,
+                                                                  cv::Mat &combinedState,
+                                                                  cv::Mat &combinedCovariance)
+{
+  auto nModels = modelProbability.size[0];
+  auto stateSize = states[0].size[0];
+
+  combinedState = cv::Mat::zeros(stateSize, 1, states[0].type());
+
+  std::vector<double> weights(nModels);
+  for (std::size_t i = 0; i < nModels; ++i)
+  {
+    weights[i] = modelProbability.at<double>(i, 0);
+    combinedState += states[i] * weights[i];
+  }
+
+  cv::detail::tracking::combineCovarianceFactors(states, covarianceFactors, weights, combinedState, combinedCovariance);
+}
+
 cv::Mat MultiModelKalmanEstimator::getModelProbability() const
 {
   return mModelProbability;
@@ -479,11 +884,11 @@ cv::Mat MultiModelKalmanEstimator::getConditionalProbability() const
 
 cv::Mat MultiModelKalmanEstimator::getKalmanFilterMeasurementCovariance(std::size_t j) const
 {
-  return mKalmanFilters[j]->getErrorCov();
+  return mKalmanFilters[j]->getMeasurementCov();
 }
 cv::Mat MultiModelKalmanEstimator::getKalmanFilterErrorCovariance(std::size_t j) const
 {
-  return mKalmanFilters[j]->getMeasurementCov();
+  return mKalmanFilters[j]->getErrorCov();
 }
 
 } // namespace tracking
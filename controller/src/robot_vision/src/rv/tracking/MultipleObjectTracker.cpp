@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <numeric>
 #include "rv/Utils.hpp"
 #include "rv/tracking/MultipleObjectTracker.hpp"
 #include "rv/tracking/Classification.hpp"
@@ -21,26 +22,61 @@ template <class ElementType> std::vector<ElementType> filterByIndex(const std::v
   return filtered;
 }
 
-void splitByThreshold(std::vector<tracking::TrackedObject> &objects,
-                      std::vector<tracking::TrackedObject> &lowScoreObjects,
+double objectScore(const tracking::TrackedObject &object)
+{
+  return object.classification.maxCoeff();
+}
+
+double objectScore(const tracking::Measurement &measurement)
+{
+  return measurement.score;
+}
+
+// the deferred tracks only have their mean extrapolated, the covariance based distances would use a stale covariance
+bool usesPredictedCovariance(const DistanceType &distanceType)
+{
+  return distanceType == DistanceType::Mahalanobis || distanceType == DistanceType::MCEMahalanobis;
+}
+
+void appendAssignedTracks(const std::vector<std::pair<size_t, size_t>> &assignments, std::vector<size_t> &assignedTracks)
+{
+  for (auto const &assignment : assignments)
+  {
+    assignedTracks.push_back(assignment.first);
+  }
+}
+
+template <class MeasurementType>
+void splitByThreshold(std::vector<MeasurementType> &objects,
+                      std::vector<MeasurementType> &lowScoreObjects,
+                      std::vector<size_t> &inputIndices,
+                      std::vector<size_t> &lowScoreInputIndices,
                       double scoreThreshold)
 {
-  lowScoreObjects.clear();
+  // the objects are partitioned through their positions so the input indices follow them
+  std::vector<size_t> order(objects.size());
+  std::iota(order.begin(), order.end(), 0u);
 
-  auto divider = [scoreThreshold](const tracking::TrackedObject &object) {
-    double score = object.classification.maxCoeff();
-    return score >= scoreThreshold;
+  auto divider = [&objects, scoreThreshold](size_t index) {
+    return objectScore(objects[index]) >= scoreThreshold;
   };
 
-  auto it = std::partition(objects.begin(), objects.end(), divider);
+  auto it = std::partition(order.begin(), order.end(), divider);
+
+  std::vector<size_t> lowScoreOrder(it, order.end());
+  order.erase(it, order.end());
 
-  std::move(it, objects.end(), std::back_inserter(lowScoreObjects));
-  objects.erase(it, objects.end());
+  lowScoreObjects = filterByIndex(objects, lowScoreOrder);
+  lowScoreInputIndices = filterByIndex(inputIndices, lowScoreOrder);
+  objects = filterByIndex(objects, order);
+  inputIndices = filterByIndex(inputIndices, order);
 }
 
+template <class MeasurementType>
 std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasurements(
-    const std::vector<tracking::TrackedObject> &tracks,
-    const std::vector<tracking::TrackedObject> &objects,
+    std::vector<tracking::TrackedObject> tracks,
+    const std::vector<MeasurementType> &objects,
+    const std::vector<size_t> &inputIndices,
     const DistanceType &distanceType,
     double distanceThreshold,
     std::vector<size_t> &unassignedObjects)
@@ -48,7 +84,21 @@ std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasur
   std::vector<std::pair<size_t, size_t>> assignments;
   std::vector<size_t> unassignedTracks;
 
-  match(tracks, objects, assignments, unassignedTracks, unassignedObjects, distanceType, distanceThreshold);
+  match(tracks, objects, assignments, unassignedTracks, unassignedObjects, distanceType, distanceThreshold, mSinglePrecision);
+
+  // the deferred tracks matched through their stale covariance get their full prediction and the matching is repeated,
+  // every round completes at least one prediction
+  std::vector<size_t> assignedTracks;
+  while (usesPredictedCovariance(distanceType))
+  {
+    assignedTracks.clear();
+    appendAssignedTracks(assignments, assignedTracks);
+    if (!mTrackManager.completePredictions(tracks, assignedTracks))
+    {
+      break;
+    }
+    match(tracks, objects, assignments, unassignedTracks, unassignedObjects, distanceType, distanceThreshold, mSinglePrecision);
+  }
 
   // Update measurements - set measurement
   for (const auto &assignment : assignments)
@@ -56,6 +106,7 @@ std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasur
     auto const &track = tracks[assignment.first];
     auto const &object = objects[assignment.second];
     mTrackManager.setMeasurement(track.id, object);
+    mMeasurementIndices.emplace(track.id, static_cast<int64_t>(inputIndices[assignment.second]));
   }
 
   // Remove tracks already assigned
@@ -71,6 +122,30 @@ void MultipleObjectTracker::track(std::vector<tracking::TrackedObject> objects,
 void MultipleObjectTracker::track(std::vector<tracking::TrackedObject> objects, const std::chrono::system_clock::time_point &timestamp,
                                   const DistanceType & distanceType, double distanceThreshold, double scoreThreshold)
 {
+  waitForPendingTracking();
+  trackObjects(std::move(objects), timestamp, distanceType, distanceThreshold, scoreThreshold);
+}
+
+void MultipleObjectTracker::track(std::vector<Measurement> measurements, const std::chrono::system_clock::time_point &timestamp,
+                                  double scoreThreshold)
+{
+  waitForPendingTracking();
+  trackObjects(std::move(measurements), timestamp, mDistanceType, mDistanceThreshold, scoreThreshold);
+}
+
+void MultipleObjectTracker::track(std::vector<Measurement> measurements, const std::chrono::system_clock::time_point &timestamp,
+                                  const DistanceType & distanceType, double distanceThreshold, double scoreThreshold)
+{
+  waitForPendingTracking();
+  trackObjects(std::move(measurements), timestamp, distanceType, distanceThreshold, scoreThreshold);
+}
+
+template <class MeasurementType>
+void MultipleObjectTracker::trackObjects(std::vector<MeasurementType> objects, const std::chrono::system_clock::time_point &timestamp,
+                                         const DistanceType & distanceType, double distanceThreshold, double scoreThreshold)
+{
+  mMeasurementIndices.clear();
+
   if (objects.empty())
   {
     mTrackManager.predict(timestamp);
@@ -79,33 +154,41 @@ void MultipleObjectTracker::track(std::vector<tracking::TrackedObject> objects,
     return;
   }
 
-  std::vector<tracking::TrackedObject> lowScoreObjects;
-  splitByThreshold(objects, lowScoreObjects, scoreThreshold);
+  std::vector<size_t> inputIndices(objects.size());
+  std::iota(inputIndices.begin(), inputIndices.end(), 0u);
+
+  std::vector<MeasurementType> lowScoreObjects;
+  std::vector<size_t> lowScoreInputIndices;
+  splitByThreshold(objects, lowScoreObjects, inputIndices, lowScoreInputIndices, scoreThreshold);
 
   // 1. - Predict
   mTrackManager.predict(rv::toSeconds(timestamp - mLastTimestamp));
+  mTrackManager.predictGatingCandidates(objects);
+  mTrackManager.predictGatingCandidates(lowScoreObjects);
 
   // 2.- Associate with the reliable states first
-  auto tracks = mTrackManager.getReliableTracks();
+  auto tracks = mTrackManager.getDeferredReliableTracks();
 
   std::vector<size_t> unassignedObjects;
-  tracks = matchAndAssignMeasurements(tracks, objects, distanceType, distanceThreshold, unassignedObjects);
+  tracks = matchAndAssignMeasurements(tracks, objects, inputIndices, distanceType, distanceThreshold, unassignedObjects);
 
   std::vector<size_t> unassignedLowScoreObjects;
-  tracks = matchAndAssignMeasurements(tracks, lowScoreObjects, distanceType, distanceThreshold, unassignedLowScoreObjects);
+  tracks = matchAndAssignMeasurements(tracks, lowScoreObjects, lowScoreInputIndices, distanceType, distanceThreshold, unassignedLowScoreObjects);
 
   // 3.1 Update measurements - Match to unreliable objects first and then suspended tracks.
   // Remove objects already assigned to tracks
   objects = filterByIndex(objects, unassignedObjects);
+  inputIndices = filterByIndex(inputIndices, unassignedObjects);
 
-  auto unreliableTracks = mTrackManager.getUnreliableTracks();
-  matchAndAssignMeasurements(unreliableTracks, objects, distanceType, distanceThreshold, unassignedObjects);
+  auto unreliableTracks = mTrackManager.getDeferredUnreliableTracks();
+  matchAndAssignMeasurements(unreliableTracks, objects, inputIndices, distanceType, distanceThreshold, unassignedObjects);
 
   // Remove objects already assigned to Unreliable tracks
   objects = filterByIndex(objects, unassignedObjects);
+  inputIndices = filterByIndex(inputIndices, unassignedObjects);
 
   auto suspendedTracks = mTrackManager.getSuspendedTracks();
-  matchAndAssignMeasurements(suspendedTracks, objects, distanceType, distanceThreshold, unassignedObjects);
+  matchAndAssignMeasurements(suspendedTracks, objects, inputIndices, distanceType, distanceThreshold, unassignedObjects);
 
   // 3.2 Update measurements - Correct measurements
   mTrackManager.correct();
@@ -115,15 +198,18 @@ void MultipleObjectTracker::track(std::vector<tracking::TrackedObject> objects,
   {
     auto const newTrack = objects[id];
 
-    mTrackManager.createTrack(newTrack, timestamp);
+    Id newTrackId = mTrackManager.createTrack(newTrack, timestamp);
+    mMeasurementIndices.emplace(newTrackId, static_cast<int64_t>(inputIndices[id]));
   }
 
   mLastTimestamp = timestamp;
 }
 
+template <class MeasurementType>
 std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasurements(
-    const std::vector<tracking::TrackedObject> &tracks,
-    std::vector<std::vector<tracking::TrackedObject>> &objectsPerCamera,
+    std::vector<tracking::TrackedObject> tracks,
+    std::vector<std::vector<MeasurementType>> &objectsPerCamera,
+    std::vector<std::vector<size_t>> &inputIndicesPerCamera,
     const DistanceType &distanceType,
     double distanceThreshold)
 {
@@ -140,13 +226,23 @@ std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasur
   std::vector<std::vector<std::pair<size_t, size_t>>> assignments(numCameras);
   std::vector<std::vector<size_t>> unassignedObjectsPerCamera(numCameras);
 
-  // Parallelizable matching phase
-  #pragma omp parallel for
-  for (size_t i = 0; i < numCameras; ++i)
+  // Parallelizable matching phase, repeated while deferred tracks are matched through their stale covariance
+  std::vector<size_t> assignedTracks;
+  do
   {
-    std::vector<size_t> unassignedTracks;
-    match(tracks, objectsPerCamera[i], assignments[i], unassignedTracks, unassignedObjectsPerCamera[i], distanceType, distanceThreshold);
-  }
+    #pragma omp parallel for
+    for (size_t i = 0; i < numCameras; ++i)
+    {
+      std::vector<size_t> unassignedTracks;
+      match(tracks, objectsPerCamera[i], assignments[i], unassignedTracks, unassignedObjectsPerCamera[i], distanceType, distanceThreshold, mSinglePrecision);
+    }
+
+    assignedTracks.clear();
+    for (auto const &cameraAssignments : assignments)
+    {
+      appendAssignedTracks(cameraAssignments, assignedTracks);
+    }
+  } while (usesPredictedCovariance(distanceType) && mTrackManager.completePredictions(tracks, assignedTracks));
 
   // Sequential assignment phase to avoid race conditions
   for (size_t i = 0; i < numCameras; ++i)
@@ -156,6 +252,7 @@ std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasur
       const auto &track = tracks[assignment.first];
       const auto &object = objectsPerCamera[i][assignment.second];
       mTrackManager.setMeasurement(track.id, object);
+      mMeasurementIndices[track.id] = static_cast<int64_t>(inputIndicesPerCamera[i][assignment.second]);
 
       // Mark track as assigned
       isTrackAssigned[assignment.first] = true;
@@ -167,6 +264,7 @@ std::vector<tracking::TrackedObject> MultipleObjectTracker::matchAndAssignMeasur
   {
     // Use the unassigned objects from the matching phase
     objectsPerCamera[i] = filterByIndex(objectsPerCamera[i], unassignedObjectsPerCamera[i]);
+    inputIndicesPerCamera[i] = filterByIndex(inputIndicesPerCamera[i], unassignedObjectsPerCamera[i]);
   }
 
   // Filter unassigned tracks
@@ -196,6 +294,35 @@ void MultipleObjectTracker::track(std::vector<std::vector<tracking::TrackedObjec
                                   const DistanceType & distanceType, double distanceThreshold,
                                   double scoreThreshold)
 {
+  waitForPendingTracking();
+  trackObjects(std::move(objectsPerCamera), timestamp, distanceType, distanceThreshold, scoreThreshold);
+}
+
+void MultipleObjectTracker::track(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                  const std::chrono::system_clock::time_point &timestamp,
+                                  double scoreThreshold)
+{
+  waitForPendingTracking();
+  trackObjects(std::move(measurementsPerCamera), timestamp, mDistanceType, mDistanceThreshold, scoreThreshold);
+}
+
+void MultipleObjectTracker::track(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                  const std::chrono::system_clock::time_point &timestamp,
+                                  const DistanceType & distanceType, double distanceThreshold,
+                                  double scoreThreshold)
+{
+  waitForPendingTracking();
+  trackObjects(std::move(measurementsPerCamera), timestamp, distanceType, distanceThreshold, scoreThreshold);
+}
+
+template <class MeasurementType>
+void MultipleObjectTracker::trackObjects(std::vector<std::vector<MeasurementType>> objectsPerCamera,
+                                         const std::chrono::system_clock::time_point &timestamp,
+                                         const DistanceType & distanceType, double distanceThreshold,
+                                         double scoreThreshold)
+{
+  mMeasurementIndices.clear();
+
   if (objectsPerCamera.empty())
   {
     mTrackManager.predict(timestamp);
@@ -204,31 +331,50 @@ void MultipleObjectTracker::track(std::vector<std::vector<tracking::TrackedObjec
     return;
   }
 
-  std::vector<std::vector<tracking::TrackedObject>> lowScoreObjectsPerCamera;
+  std::vector<std::vector<MeasurementType>> lowScoreObjectsPerCamera;
+  std::vector<std::vector<size_t>> inputIndicesPerCamera;
+  std::vector<std::vector<size_t>> lowScoreInputIndicesPerCamera;
   lowScoreObjectsPerCamera.reserve(objectsPerCamera.size());
+  inputIndicesPerCamera.reserve(objectsPerCamera.size());
+  lowScoreInputIndicesPerCamera.reserve(objectsPerCamera.size());
+
+  size_t cameraOffset = 0;
   for (auto &objects : objectsPerCamera)
   {
-    std::vector<tracking::TrackedObject> lowScoreObjects;
-    splitByThreshold(objects, lowScoreObjects, scoreThreshold);
+    // the input indices run over the concatenation of the camera lists
+    std::vector<size_t> inputIndices(objects.size());
+    std::iota(inputIndices.begin(), inputIndices.end(), cameraOffset);
+    cameraOffset += objects.size();
+
+    std::vector<MeasurementType> lowScoreObjects;
+    std::vector<size_t> lowScoreInputIndices;
+    splitByThreshold(objects, lowScoreObjects, inputIndices, lowScoreInputIndices, scoreThreshold);
     lowScoreObjectsPerCamera.push_back(std::move(lowScoreObjects));
+    inputIndicesPerCamera.push_back(std::move(inputIndices));
+    lowScoreInputIndicesPerCamera.push_back(std::move(lowScoreInputIndices));
   }
 
   // 1. - Predict
   mTrackManager.predict(rv::toSeconds(timestamp - mLastTimestamp));
+  for (size_t i = 0; i < objectsPerCamera.size(); ++i)
+  {
+    mTrackManager.predictGatingCandidates(objectsPerCamera[i]);
+    mTrackManager.predictGatingCandidates(lowScoreObjectsPerCamera[i]);
+  }
 
   // 2.- Associate with the reliable states first
-  auto tracks = mTrackManager.getReliableTracks();
+  auto tracks = mTrackManager.getDeferredReliableTracks();
 
-  tracks = matchAndAssignMeasurements(tracks, objectsPerCamera, distanceType, distanceThreshold);
+  tracks = matchAndAssignMeasurements(tracks, objectsPerCamera, inputIndicesPerCamera, distanceType, distanceThreshold);
 
-  tracks = matchAndAssignMeasurements(tracks, lowScoreObjectsPerCamera, distanceType, distanceThreshold);
+  tracks = matchAndAssignMeasurements(tracks, lowScoreObjectsPerCamera, lowScoreInputIndicesPerCamera, distanceType, distanceThreshold);
 
   // 3.1 Update measurements - Match to unreliable objects first and then suspended tracks.
-  auto unreliableTracks = mTrackManager.getUnreliableTracks();
-  matchAndAssignMeasurements(unreliableTracks, objectsPerCamera, distanceType, distanceThreshold);
+  auto unreliableTracks = mTrackManager.getDeferredUnreliableTracks();
+  matchAndAssignMeasurements(unreliableTracks, objectsPerCamera, inputIndicesPerCamera, distanceType, distanceThreshold);
 
   auto suspendedTracks = mTrackManager.getSuspendedTracks();
-  matchAndAssignMeasurements(suspendedTracks, objectsPerCamera, distanceType, distanceThreshold);
+  matchAndAssignMeasurements(suspendedTracks, objectsPerCamera, inputIndicesPerCamera, distanceType, distanceThreshold);
 
   // 3.2 Update measurements - Correct measurements
   mTrackManager.correct();
@@ -243,27 +389,120 @@ void MultipleObjectTracker::track(std::vector<std::vector<tracking::TrackedObjec
   newTracks.reserve(totalUnassignedObjects);
 
   // Process cameras in reverse order to prioritize latest camera's objects for accuracy
-  for (auto it = objectsPerCamera.rbegin(); it != objectsPerCamera.rend(); ++it)
+  for (size_t camera = objectsPerCamera.size(); camera-- > 0;)
   {
-    auto &cameraObjects = *it;
+    auto &cameraObjects = objectsPerCamera[camera];
+    auto &cameraInputIndices = inputIndicesPerCamera[camera];
     // first assign objects to already created new tracks (in case multiple cameras see the same new object)
     if (!newTracks.empty())
     {
       std::vector<size_t> unassignedObjects;
       // the goal of this step is to filter out objects matching existing new tracks, the assignment will be skipped
-      matchAndAssignMeasurements(newTracks, cameraObjects, distanceType, distanceThreshold, unassignedObjects);
+      matchAndAssignMeasurements(newTracks, cameraObjects, cameraInputIndices, distanceType, distanceThreshold, unassignedObjects);
       cameraObjects = filterByIndex(cameraObjects, unassignedObjects);
+      cameraInputIndices = filterByIndex(cameraInputIndices, unassignedObjects);
     }
 
     // Create new tracks for remaining unmatched objects
-    for (const auto &object : cameraObjects)
+    for (size_t i = 0; i < cameraObjects.size(); ++i)
     {
-      Id newTrackId = mTrackManager.createTrack(object, timestamp);
+      Id newTrackId = mTrackManager.createTrack(cameraObjects[i], timestamp);
+      mMeasurementIndices.emplace(newTrackId, static_cast<int64_t>(cameraInputIndices[i]));
       newTracks.push_back(mTrackManager.getTrack(newTrackId));
     }
   }
 
   mLastTimestamp = timestamp;
 }
+
+MultipleObjectTracker::~MultipleObjectTracker()
+{
+  // the queued steps are run before the worker stops, their errors stay in their futures
+  {
+    std::lock_guard<std::mutex> lock(mTrackingMutex);
+    mStopTracking = true;
+  }
+  mTrackingCondition.notify_one();
+  if (mTrackingWorker.joinable())
+  {
+    mTrackingWorker.join();
+  }
+}
+
+void MultipleObjectTracker::pushTracking(std::packaged_task<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mTrackingMutex);
+    mTrackingQueue.push_back(std::move(task));
+  }
+
+  if (mTrackingWorker.joinable())
+  {
+    mTrackingCondition.notify_one();
+  }
+  else
+  {
+    mTrackingWorker = std::thread(&MultipleObjectTracker::runTrackingWorker, this);
+  }
+}
+
+void MultipleObjectTracker::runTrackingWorker()
+{
+  std::unique_lock<std::mutex> lock(mTrackingMutex);
+  while (true)
+  {
+    mTrackingCondition.wait(lock, [this]() { return mStopTracking || !mTrackingQueue.empty(); });
+    if (mTrackingQueue.empty())
+    {
+      return;
+    }
+
+    std::packaged_task<void()> task = std::move(mTrackingQueue.front());
+    mTrackingQueue.pop_front();
+    lock.unlock();
+
+    // an exception thrown by the step is stored in its future
+    task();
+    task = std::packaged_task<void()>();
+
+    lock.lock();
+  }
+}
+
+std::shared_future<void> MultipleObjectTracker::trackAsync(std::vector<Measurement> measurements,
+                                                           const std::chrono::system_clock::time_point &timestamp,
+                                                           double scoreThreshold)
+{
+  return trackAsync(std::move(measurements), timestamp, mDistanceType, mDistanceThreshold, scoreThreshold);
+}
+
+std::shared_future<void> MultipleObjectTracker::trackAsync(std::vector<Measurement> measurements,
+                                                           const std::chrono::system_clock::time_point &timestamp,
+                                                           const DistanceType & distanceType, double distanceThreshold,
+                                                           double scoreThreshold)
+{
+  return enqueueTracking(
+    [this, measurements = std::move(measurements), timestamp, distanceType, distanceThreshold, scoreThreshold]() mutable {
+      trackObjects(std::move(measurements), timestamp, distanceType, distanceThreshold, scoreThreshold);
+    });
+}
+
+std::shared_future<void> MultipleObjectTracker::trackAsync(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                                           const std::chrono::system_clock::time_point &timestamp,
+                                                           double scoreThreshold)
+{
+  return trackAsync(std::move(measurementsPerCamera), timestamp, mDistanceType, mDistanceThreshold, scoreThreshold);
+}
+
+std::shared_future<void> MultipleObjectTracker::trackAsync(std::vector<std::vector<Measurement>> measurementsPerCamera,
+                                                           const std::chrono::system_clock::time_point &timestamp,
+                                                           const DistanceType & distanceType, double distanceThreshold,
+                                                           double scoreThreshold)
+{
+  return enqueueTracking([this, measurementsPerCamera = std::move(measurementsPerCamera), timestamp, distanceType,
+                          distanceThreshold, scoreThreshold]() mutable {
+    trackObjects(std::move(measurementsPerCamera), timestamp, distanceType, distanceThreshold, scoreThreshold);
+  });
+}
 } // namespace tracking
 } // namespace rv
@@ -7,7 +7,8 @@
 #include <omp.h>
 
 #include "rv/tracking/ObjectMatching.hpp"
-#include "rv/apollo/multi_hm_bipartite_graph_matcher.hpp"
+#include "rv/apollo/base_bipartite_graph_matcher.hpp"
+#include "rv/apollo/gated_hungarian_bigraph_matcher.hpp"
 #include "rv/apollo/secure_matrix.hpp"
 #include "rv/tracking/Classification.hpp"
 
@@ -18,33 +19,46 @@ namespace tracking {
 
 constexpr double kDefaultClassBoundValue = 1000.;
 
-double calculateMulticlassScaledDistance(const TrackedObject &measurement, const TrackedObject &track)
+double calculateMulticlassScaledDistance(const Measurement &measurement, const TrackedObject &track)
 {
-  auto conflict = rv::tracking::classification::distance(measurement.classification, track.classification);
+  auto conflict = rv::tracking::classification::distance(measurement.classificationVector(), track.classification);
 
   double distance = sqrt(pow(measurement.x - track.x, 2) + pow(measurement.y - track.y, 2));
 
   return distance * (1.0 + conflict);
 }
 
-double calculateEuclideanDistance(const TrackedObject &measurement, const TrackedObject &track)
+double calculateEuclideanDistance(const Measurement &measurement, const TrackedObject &track)
 {
   return sqrt(pow(measurement.x - track.x, 2) + pow(measurement.y - track.y, 2));
 }
 
-double calculateMahalanobisDistance(const TrackedObject &measurement, const TrackedObject &track)
+double calculateMahalanobisDistance(const Measurement &measurement, const TrackedObject &track)
 {
-  cv::Mat innovation = measurement.measurementVector() - (track.predictedMeasurementMean);
-
   // ignore yaw, 2D detectors cannot detect orientation
-  innovation.at<double>(6, 0) = 0.;
+  constexpr int kInnovationSize = 6;
+  double const values[kInnovationSize]
+    = {measurement.x, measurement.y, measurement.z, measurement.length, measurement.width, measurement.height};
 
-  cv::Mat mahalanobisDistance = innovation.t() * (track.predictedMeasurementCovInv) * innovation;
+  double innovation[kInnovationSize];
+  for (int i = 0; i < kInnovationSize; ++i)
+  {
+    innovation[i] = values[i] - track.predictedMeasurementMean(i);
+  }
+
+  double mahalanobisDistance = 0.;
+  for (int r = 0; r < kInnovationSize; ++r)
+  {
+    for (int c = 0; c < kInnovationSize; ++c)
+    {
+      mahalanobisDistance += innovation[r] * track.predictedMeasurementCovInv(r, c) * innovation[c];
+    }
+  }
 
-  return 0.5 * std::sqrt(mahalanobisDistance.at<double>(0, 0));
+  return 0.5 * std::sqrt(mahalanobisDistance);
 }
 
-double calculateCompundDistance(const TrackedObject &measurement, const TrackedObject &track)
+double calculateCompundDistance(const Measurement &measurement, const TrackedObject &track)
 {
   double euclideanDist = calculateMulticlassScaledDistance(measurement, track);
   double mahalanobisDist = calculateMahalanobisDistance(measurement, track);
@@ -52,17 +66,45 @@ double calculateCompundDistance(const TrackedObject &measurement, const TrackedO
   return 0.5 * euclideanDist + 0.5 * mahalanobisDist;
 }
 
+template <typename T>
+void solveAssignment(const std::vector<TrackedObject> &tracks,
+                     const std::vector<Measurement> &measurements,
+                     const std::function<double(const Measurement &, const TrackedObject &)> &distanceFunction,
+                     const apollo::perception::lidar::BipartiteGraphMatcherOptions &matcherOptions,
+                     std::vector<std::pair<size_t, size_t>> &assignments,
+                     std::vector<size_t> &unassignedTracks,
+                     std::vector<size_t> &unassignedMeasurements)
+{
+  apollo::perception::common::GatedHungarianMatcher<T> optimizer;
+
+  apollo::perception::common::SecureMat<T> *costMatrix = optimizer.mutable_global_costs();
+  costMatrix->Resize(tracks.size(), measurements.size());
+
+  // Parallelize the cost matrix computation
+  #pragma omp parallel for collapse(2)
+  for (size_t i = 0; i < tracks.size(); ++i)
+  {
+    for (size_t j = 0; j < measurements.size(); ++j)
+    {
+      (*costMatrix)(i, j) = static_cast<T>(distanceFunction(measurements[j], tracks[i]));
+    }
+  }
+
+  optimizer.Match(static_cast<T>(matcherOptions.cost_thresh),
+                  static_cast<T>(matcherOptions.bound_value),
+                  apollo::perception::common::GatedHungarianMatcher<T>::OptimizeFlag::OPTMIN,
+                  &assignments,
+                  &unassignedTracks,
+                  &unassignedMeasurements);
+}
+
 void match(const std::vector<TrackedObject> &tracks,
-                          const std::vector<TrackedObject> &measurements,
+                          const std::vector<Measurement> &measurements,
                           std::vector<std::pair<size_t, size_t>> &assignments,
                           std::vector<size_t> &unassignedTracks,
                           std::vector<size_t> &unassignedMeasurements,
-                          const DistanceType &distanceType, double threshold)
+                          const DistanceType &distanceType, double threshold, bool singlePrecision)
 {
-  apollo::perception::lidar::MultiHmBipartiteGraphMatcher matcher;
-
-  matcher.cost_matrix()->Reserve(tracks.size(), measurements.size());
-
   assignments.clear();
   unassignedTracks.clear();
   unassignedMeasurements.clear();
@@ -77,7 +119,7 @@ void match(const std::vector<TrackedObject> &tracks,
   }
 
   apollo::perception::lidar::BipartiteGraphMatcherOptions matcherOptions;
-  std::function<double(const TrackedObject &, const TrackedObject &)> distanceFunction;
+  std::function<double(const Measurement &, const TrackedObject &)> distanceFunction;
   switch (distanceType)
   {
     case DistanceType::MCEMahalanobis:
@@ -103,20 +145,32 @@ void match(const std::vector<TrackedObject> &tracks,
       break;
   }
 
-  apollo::perception::common::SecureMat<double> *costMatrix = matcher.cost_matrix();
-  costMatrix->Resize(tracks.size(), measurements.size());
+  if (singlePrecision)
+  {
+    solveAssignment<float>(tracks, measurements, distanceFunction, matcherOptions, assignments, unassignedTracks, unassignedMeasurements);
+  }
+  else
+  {
+    solveAssignment<double>(tracks, measurements, distanceFunction, matcherOptions, assignments, unassignedTracks, unassignedMeasurements);
+  }
+}
 
-  // Parallelize the cost matrix computation
-  #pragma omp parallel for collapse(2)
-  for (size_t i = 0; i < tracks.size(); ++i)
+void match(const std::vector<TrackedObject> &tracks,
+           const std::vector<TrackedObject> &measurements,
+           std::vector<std::pair<size_t, size_t>> &assignments,
+           std::vector<size_t> &unassignedTracks,
+           std::vector<size_t> &unassignedMeasurements,
+           const DistanceType &distanceType, double threshold, bool singlePrecision)
+{
+  std::vector<Measurement> compactMeasurements;
+  compactMeasurements.reserve(measurements.size());
+  for (auto const &measurement : measurements)
   {
-    for (size_t j = 0; j < measurements.size(); ++j)
-    {
-      (*costMatrix)(i, j) = distanceFunction(measurements[j], tracks[i]);
-    }
+    compactMeasurements.push_back(Measurement::fromTrackedObject(measurement));
   }
 
-  matcher.Match(matcherOptions, &assignments, &unassignedTracks, &unassignedMeasurements);
+  match(tracks, compactMeasurements, assignments, unassignedTracks, unassignedMeasurements, distanceType, threshold,
+        singlePrecision);
 }
 
 } // namespace tracking
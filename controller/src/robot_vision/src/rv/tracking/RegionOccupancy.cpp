@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rv/tracking/RegionOccupancy.hpp"
+
+#include <cmath>
+
+namespace rv {
+namespace tracking {
+
+RegionOccupancy::RegionOccupancy(double debounce) : mDebounce(debounce)
+{
+}
+
+std::vector<RegionEvent> RegionOccupancy::update(const std::string &category,
+                                                 double timestamp,
+                                                 const std::vector<std::string> &regions,
+                                                 const std::vector<std::string> &tracks,
+                                                 const uint8_t *membership)
+{
+  std::vector<RegionEvent> events;
+  std::vector<std::size_t> inside;
+  inside.reserve(tracks.size());
+
+  for (std::size_t r = 0; r < regions.size(); ++r)
+  {
+    RegionState &state = mRegions[regions[r]];
+    std::unordered_set<std::string> &published = state.published[category];
+    std::unordered_map<std::string, double> &entered = state.entered[category];
+
+    const uint8_t *row = membership + r * tracks.size();
+    inside.clear();
+    for (std::size_t t = 0; t < tracks.size(); ++t)
+    {
+      if (row[t])
+      {
+        inside.push_back(t);
+      }
+    }
+
+    RegionEvent event;
+    event.region = regions[r];
+    for (auto t : inside)
+    {
+      if (published.count(tracks[t]) == 0)
+      {
+        event.arrived.push_back(tracks[t]);
+        if (entered.emplace(tracks[t], timestamp).second)
+        {
+          event.marked.push_back(tracks[t]);
+        }
+      }
+    }
+
+    // the published tracks are all inside unless some of them departed
+    const std::size_t stayed = inside.size() - event.arrived.size();
+    const bool departed = stayed != published.size();
+
+    if ((!event.arrived.empty() || departed) && timestamp - state.lastPublished > mDebounce)
+    {
+      event.fired = true;
+      event.entered = event.arrived;
+
+      std::unordered_set<std::string> current;
+      current.reserve(inside.size());
+      for (auto t : inside)
+      {
+        current.insert(tracks[t]);
+      }
+      for (const auto &track : published)
+      {
+        if (current.count(track) == 0)
+        {
+          auto entry = entered.find(track);
+          if (entry != entered.end())
+          {
+            event.exited.emplace_back(track, timestamp - entry->second);
+            entered.erase(entry);
+          }
+        }
+      }
+
+      event.countChanged = current.size() != published.size();
+      event.count = current.size();
+      published = std::move(current);
+      state.lastPublished = timestamp;
+    }
+
+    // the tracks which arrived and left again before their arrival was published keep no entry timestamp
+    const std::size_t pending = event.fired ? 0u : event.arrived.size();
+    if (entered.size() > published.size() + pending)
+    {
+      std::unordered_set<std::string> arrived(event.arrived.begin(), event.arrived.begin() + pending);
+      for (auto entry = entered.begin(); entry != entered.end();)
+      {
+        if (published.count(entry->first) == 0 && arrived.count(entry->first) == 0)
+        {
+          entry = entered.erase(entry);
+        }
+        else
+        {
+          ++entry;
+        }
+      }
+    }
+
+    if (event.fired || !event.arrived.empty())
+    {
+      events.push_back(std::move(event));
+    }
+  }
+
+  return events;
+}
+
+void RegionOccupancy::removeRegion(const std::string &region)
+{
+  mRegions.erase(region);
+}
+
+std::size_t RegionOccupancy::count(const std::string &region, const std::string &category) const
+{
+  auto found = mRegions.find(region);
+  if (found == mRegions.end())
+  {
+    return 0u;
+  }
+  auto published = found->second.published.find(category);
+  return published == found->second.published.end() ? 0u : published->second.size();
+}
+
+double RegionOccupancy::enteredAt(const std::string &region, const std::string &track) const
+{
+  auto found = mRegions.find(region);
+  if (found == mRegions.end())
+  {
+    return std::nan("");
+  }
+  for (const auto &category : found->second.entered)
+  {
+    auto entry = category.second.find(track);
+    if (entry != category.second.end())
+    {
+      return entry->second;
+    }
+  }
+  return std::nan("");
+}
+
+} // namespace tracking
+} // namespace rv
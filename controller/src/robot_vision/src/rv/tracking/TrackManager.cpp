@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: (C) 2017 - 2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cmath>
 #include "rv/Utils.hpp"
 #include "rv/tracking/TrackManager.hpp"
 #include <iostream>
@@ -17,7 +19,8 @@ Id TrackManager::createTrack(TrackedObject object, const std::chrono::system_clo
     object.id = mCurrentId;
   }
 
-  mKalmanEstimators[object.id].initialize(object, timestamp, mConfig.mDefaultProcessNoise, mConfig.mDefaultMeasurementNoise, mConfig.mInitStateCovariance, mConfig.mMotionModels);
+  mKalmanEstimators[object.id].initialize(object, timestamp, mConfig.mDefaultProcessNoise, mConfig.mDefaultMeasurementNoise, mConfig.mInitStateCovariance, mConfig.mMotionModels, mConfig.mUseSquareRootFilter, mConfig.mUseSinglePrecision ? CV_32F : CV_64F);
+  mKalmanEstimators[object.id].setModelPruning(mConfig.mAdaptiveModelPruning, mConfig.mModelPruningFrames, mConfig.mModelReactivationThreshold);
 
   // Initialize non measurement and tracked frames counters
   mNonMeasurementFrames[object.id] = 0;
@@ -25,6 +28,11 @@ Id TrackManager::createTrack(TrackedObject object, const std::chrono::system_clo
   return object.id;
 }
 
+Id TrackManager::createTrack(const Measurement &measurement, const std::chrono::system_clock::time_point &timestamp)
+{
+  return createTrack(measurement.toTrackedObject(), timestamp);
+}
+
 void TrackManager::deleteTrack(const Id &id)
 {
   if (isSuspended(id))
@@ -39,6 +47,8 @@ void TrackManager::deleteTrack(const Id &id)
 
 void TrackManager::suspendTrack(const Id &id)
 {
+  // suspended tracks are not predicted any more, they keep a complete state
+  mKalmanEstimators.at(id).completePrediction();
   mSuspendedKalmanEstimators[id] = std::move(mKalmanEstimators.at(id));
   mKalmanEstimators.erase(id);
   mNonMeasurementFrames.erase(id);
@@ -70,9 +80,18 @@ void TrackManager::predict(const std::chrono::system_clock::time_point &timestam
   #pragma omp parallel for
   for (size_t i = 0; i < estimators.size(); ++i)
   {
-    estimators[i].get().predict(timestamp);
+    auto &estimator = estimators[i].get();
+    if (isPredictionDeferred(estimator))
+    {
+      estimator.deferPrediction(timestamp);
+    }
+    else
+    {
+      estimator.predict(timestamp);
+    }
   }
   mMeasurementMap.clear();
+  mMeasurementAttributes.clear();
 }
 
 
@@ -91,10 +110,135 @@ void TrackManager::predict(double deltaT)
   #pragma omp parallel for
   for (size_t i = 0; i < estimators.size(); ++i)
   {
-    estimators[i].get().predict(deltaT);
+    auto &estimator = estimators[i].get();
+    if (isPredictionDeferred(estimator))
+    {
+      estimator.deferPrediction(deltaT);
+    }
+    else
+    {
+      estimator.predict(deltaT);
+    }
   }
 
   mMeasurementMap.clear();
+  mMeasurementAttributes.clear();
+}
+
+bool TrackManager::isPredictionDeferred(const MultiModelKalmanEstimator &estimator) const
+{
+  return mConfig.mLazyPrediction && estimator.getPendingPredictionFrames() + 1 < mConfig.mLazyPredictionRefreshFrames;
+}
+
+void TrackManager::predictGatingCandidates(const std::vector<TrackedObject> &measurements)
+{
+  predictCandidates(measurements);
+}
+
+void TrackManager::predictGatingCandidates(const std::vector<Measurement> &measurements)
+{
+  predictCandidates(measurements);
+}
+
+template <class MeasurementType> void TrackManager::predictCandidates(const std::vector<MeasurementType> &measurements)
+{
+  std::vector<std::reference_wrapper<MultiModelKalmanEstimator>> estimators;
+  estimators.reserve(mKalmanEstimators.size());
+
+  for (auto &element : mKalmanEstimators)
+  {
+    if (element.second.getPendingPredictionFrames() > 0u)
+    {
+      estimators.push_back(std::ref(element.second));
+    }
+  }
+
+  if (estimators.empty() || measurements.empty())
+  {
+    return;
+  }
+
+  // bucket the measurements on a grid with the gating distance as cell size, a track only checks the 3x3 cells
+  // around its own
+  double const gatingDistance = mConfig.mLazyPredictionGatingDistance;
+  double const gatingDistanceSquared = gatingDistance * gatingDistance;
+  double const cellSize = gatingDistance > 0. ? gatingDistance : 1.;
+
+  using Cell = std::pair<int64_t, int64_t>;
+  auto cellOf = [cellSize](double x, double y) {
+    return Cell(static_cast<int64_t>(std::floor(x / cellSize)), static_cast<int64_t>(std::floor(y / cellSize)));
+  };
+  auto isGridable = [cellSize](double x, double y) {
+    constexpr double kMaxCell = 1e15;
+    return std::isfinite(x) && std::isfinite(y) && std::abs(x / cellSize) < kMaxCell
+      && std::abs(y / cellSize) < kMaxCell;
+  };
+
+  std::vector<std::pair<Cell, size_t>> grid;
+  grid.reserve(measurements.size());
+  for (size_t j = 0; j < measurements.size(); ++j)
+  {
+    if (isGridable(measurements[j].x, measurements[j].y))
+    {
+      grid.emplace_back(cellOf(measurements[j].x, measurements[j].y), j);
+    }
+  }
+  std::sort(grid.begin(), grid.end());
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < estimators.size(); ++i)
+  {
+    auto &estimator = estimators[i].get();
+    auto const &state = estimator.currentState();
+    if (!isGridable(state.x, state.y))
+    {
+      continue;
+    }
+
+    Cell const center = cellOf(state.x, state.y);
+    bool isCandidate = false;
+    for (int64_t cx = center.first - 1; cx <= center.first + 1 && !isCandidate; ++cx)
+    {
+      for (int64_t cy = center.second - 1; cy <= center.second + 1 && !isCandidate; ++cy)
+      {
+        auto const first = std::lower_bound(grid.begin(), grid.end(), std::make_pair(Cell(cx, cy), size_t(0)));
+        for (auto it = first; it != grid.end() && it->first == Cell(cx, cy); ++it)
+        {
+          auto const &measurement = measurements[it->second];
+          double dx = measurement.x - state.x;
+          double dy = measurement.y - state.y;
+          if (dx * dx + dy * dy <= gatingDistanceSquared)
+          {
+            isCandidate = true;
+            break;
+          }
+        }
+      }
+    }
+
+    if (isCandidate)
+    {
+      estimator.completePrediction();
+    }
+  }
+}
+
+bool TrackManager::completePredictions(std::vector<TrackedObject> &tracks, const std::vector<size_t> &indices)
+{
+  bool completed = false;
+  for (auto const &index : indices)
+  {
+    auto element = mKalmanEstimators.find(tracks[index].id);
+    if (element == mKalmanEstimators.end() || element->second.getPendingPredictionFrames() == 0u)
+    {
+      continue;
+    }
+
+    element->second.completePrediction();
+    tracks[index] = element->second.currentState();
+    completed = true;
+  }
+  return completed;
 }
 
 void TrackManager::correct()
@@ -117,8 +261,7 @@ void TrackManager::correct()
 
     if (mMeasurementMap.count(id))
     {
-      auto const measurement = mMeasurementMap.find(id);
-      estimator.correct(measurement->second);
+      correctWithMeasurement(id, estimator);
     }
   }
 
@@ -149,7 +292,7 @@ void TrackManager::correct()
   for (const auto &id : reactivationList)
   {
     reactivateTrack(id);
-    mKalmanEstimators[id].correct(mMeasurementMap[id]);
+    correctWithMeasurement(id, mKalmanEstimators[id]);
   }
 
   std::vector<Id> deletionList;
@@ -196,10 +339,41 @@ void TrackManager::correct()
   {
     suspendTrack(id);
   }
+
+  mSkippedPredictions = 0;
+  for (const auto &element : mKalmanEstimators)
+  {
+    if (element.second.getPendingPredictionFrames() > 0u)
+    {
+      mSkippedPredictions++;
+    }
+  }
+}
+
+void TrackManager::completePendingPredictions(bool reliable)
+{
+  std::vector<std::reference_wrapper<MultiModelKalmanEstimator>> estimators;
+
+  for (auto &element : mKalmanEstimators)
+  {
+    if (element.second.getPendingPredictionFrames() > 0u && isReliable(element.first) == reliable)
+    {
+      estimators.push_back(std::ref(element.second));
+    }
+  }
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < estimators.size(); ++i)
+  {
+    estimators[i].get().completePrediction();
+  }
 }
 
 std::vector<TrackedObject> TrackManager::getTracks()
 {
+  completePendingPredictions(true);
+  completePendingPredictions(false);
+
   std::vector<TrackedObject> tracks;
 
   for (const auto &element : mKalmanEstimators)
@@ -215,6 +389,18 @@ std::vector<TrackedObject> TrackManager::getTracks()
 }
 
 std::vector<TrackedObject> TrackManager::getReliableTracks()
+{
+  completePendingPredictions(true);
+  return getDeferredReliableTracks();
+}
+
+std::vector<TrackedObject> TrackManager::getUnreliableTracks()
+{
+  completePendingPredictions(false);
+  return getDeferredUnreliableTracks();
+}
+
+std::vector<TrackedObject> TrackManager::getDeferredReliableTracks()
 {
   std::vector<TrackedObject> tracks;
 
@@ -230,7 +416,7 @@ std::vector<TrackedObject> TrackManager::getReliableTracks()
 }
 
 
-std::vector<TrackedObject> TrackManager::getUnreliableTracks()
+std::vector<TrackedObject> TrackManager::getDeferredUnreliableTracks()
 {
   std::vector<TrackedObject> tracks;
 
@@ -274,15 +460,46 @@ std::vector<TrackedObject> TrackManager::getDriftingTracks()
 
 void TrackManager::setMeasurement(const Id &id, const TrackedObject &measurement)
 {
-  auto previousMeasurement = mMeasurementMap.find(id);
-  if (previousMeasurement != mMeasurementMap.end())
+  setMeasurement(id, Measurement::fromTrackedObject(measurement));
+  mMeasurementAttributes[id] = measurement.attributes;
+}
+
+void TrackManager::setMeasurement(const Id &id, const Measurement &measurement)
+{
+  mMeasurementMap[id] = measurement;
+  mMeasurementAttributes.erase(id);
+}
+
+void TrackManager::correctWithMeasurement(const Id &id, MultiModelKalmanEstimator &estimator) const
+{
+  auto const &measurement = mMeasurementMap.at(id);
+  auto const attributes = mMeasurementAttributes.find(id);
+  if (attributes != mMeasurementAttributes.end())
   {
-    mMeasurementMap[id] = measurement;
+    estimator.correct(measurement, attributes->second);
   }
   else
   {
-    mMeasurementMap.insert(std::make_pair(id, measurement));
+    estimator.correct(measurement);
+  }
+}
+
+std::vector<ModelPruningEvent> TrackManager::popModelPruningEvents()
+{
+  std::vector<ModelPruningEvent> events;
+
+  for (auto &element : mKalmanEstimators)
+  {
+    auto trackEvents = element.second.popModelPruningEvents();
+    events.insert(events.end(), trackEvents.begin(), trackEvents.end());
   }
+  for (auto &element : mSuspendedKalmanEstimators)
+  {
+    auto trackEvents = element.second.popModelPruningEvents();
+    events.insert(events.end(), trackEvents.begin(), trackEvents.end());
+  }
+
+  return events;
 }
 
 TrackedObject TrackManager::getTrack(const Id &id)
@@ -294,6 +511,7 @@ MultiModelKalmanEstimator TrackManager::getKalmanEstimator(const Id &id)
 {
   if (mKalmanEstimators.count(id) > 0)
   {
+    mKalmanEstimators[id].completePrediction();
     return mKalmanEstimators[id];
   }
   else if(mSuspendedKalmanEstimators.count(id) > 0)
@@ -3,20 +3,22 @@
 
 #include "rv/tracking/TrackedObject.hpp"
 
+#include <algorithm>
+
 namespace rv {
 namespace tracking {
 
-const int TrackedObject::StateSize = 12;
-const int TrackedObject::MeasurementSize = 7;
+const int TrackedObject::StateSize = TrackedObjectStateSize;
+const int TrackedObject::MeasurementSize = TrackedObjectMeasurementSize;
 
 TrackedObject::TrackedObject()
 {
   classification = Classification::Constant(1,1.0);
 
-  predictedMeasurementMean = cv::Mat::zeros(TrackedObject::MeasurementSize, 1, CV_64F);
-  predictedMeasurementCov = 1e-4 * cv::Mat::eye(TrackedObject::MeasurementSize, TrackedObject::MeasurementSize, CV_64F);
-  predictedMeasurementCovInv = 1e4 * cv::Mat::eye(TrackedObject::MeasurementSize, TrackedObject::MeasurementSize, CV_64F);
-  errorCovariance = 1e-4 * cv::Mat::eye(TrackedObject::StateSize, TrackedObject::StateSize, CV_64F);
+  predictedMeasurementMean.setZero();
+  predictedMeasurementCov = 1e-4 * MeasurementCovariance::Identity();
+  predictedMeasurementCovInv = 1e4 * MeasurementCovariance::Identity();
+  errorCovariance = 1e-4 * StateCovariance::Identity();
 }
 
 std::string TrackedObject::toString() const
@@ -35,37 +37,12 @@ bool TrackedObject::isDynamic() const
 
 Eigen::VectorXf TrackedObject::getVectorXf() const
 {
-  Eigen::VectorXf vector(StateSize);
-  vector(0) = x;
-  vector(1) = y;
-  vector(2) = vx;
-  vector(3) = vy;
-  vector(4) = ax;
-  vector(5) = ay;
-  vector(6) = z;
-  vector(7) = length;
-  vector(8) = width;
-  vector(9) = height;
-  vector(10) = yaw;
-  vector(11) = w;
-
-  return vector;
+  return state().cast<float>();
 }
 
 void TrackedObject::setVectorXf(const Eigen::VectorXf &vector)
 {
-  x = vector(0);
-  y = vector(1);
-  vx = vector(2);
-  vy = vector(3);
-  ax = vector(4);
-  ay = vector(5);
-  z = vector(6);
-  length = vector(7);
-  width = vector(8);
-  height = vector(9);
-  yaw = vector(10);
-  w = vector(11);
+  state() = vector.head<TrackedObjectStateSize>().cast<double>();
 }
 
 /**
@@ -74,18 +51,7 @@ void TrackedObject::setVectorXf(const Eigen::VectorXf &vector)
 cv::Mat TrackedObject::stateVector() const
 {
   cv::Mat vector(StateSize, 1, CV_64F);
-  vector.at<double>(0, 0) = x;
-  vector.at<double>(1, 0) = y;
-  vector.at<double>(2, 0) = vx;
-  vector.at<double>(3, 0) = vy;
-  vector.at<double>(4, 0) = ax;
-  vector.at<double>(5, 0) = ay;
-  vector.at<double>(6, 0) = z;
-  vector.at<double>(7, 0) = length;
-  vector.at<double>(8, 0) = width;
-  vector.at<double>(9, 0) = height;
-  vector.at<double>(10, 0) = yaw;
-  vector.at<double>(11, 0) = w;
+  std::copy_n(state().data(), StateSize, vector.ptr<double>(0));
 
   return vector;
 }
@@ -95,18 +61,11 @@ cv::Mat TrackedObject::stateVector() const
  */
 void TrackedObject::setStateVector(const cv::Mat &vector)
 {
-  x = vector.at<double>(0, 0);
-  y = vector.at<double>(1, 0);
-  vx = vector.at<double>(2, 0);
-  vy = vector.at<double>(3, 0);
-  ax = vector.at<double>(4, 0);
-  ay = vector.at<double>(5, 0);
-  z = vector.at<double>(6, 0);
-  length = vector.at<double>(7, 0);
-  width = vector.at<double>(8, 0);
-  height = vector.at<double>(9, 0);
-  yaw = vector.at<double>(10, 0);
-  w = vector.at<double>(11, 0);
+  auto values = state();
+  for (int i = 0; i < StateSize; ++i)
+  {
+    values(i) = vector.at<double>(i, 0);
+  }
 }
 
 /**
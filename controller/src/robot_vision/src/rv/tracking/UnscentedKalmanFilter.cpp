@@ -5,6 +5,7 @@
 
 #include "rv/tracking/UnscentedKalmanFilter.hpp"
 
+#include <Eigen/Dense>
 #include <opencv2/core.hpp>
 #include <opencv2/tracking/kalman_filters.hpp>
 
@@ -12,7 +13,208 @@ namespace cv {
 namespace detail {
 namespace tracking {
 
+namespace {
+
+template <typename _Tp>
+using RowMajorMatrix = Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+template <typename _Tp> using MatMap = Eigen::Map<RowMajorMatrix<_Tp>, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+template <typename _Tp>
+using ConstMatMap = Eigen::Map<const RowMajorMatrix<_Tp>, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+// Wrap the data of a 2D cv::Mat as an Eigen matrix, no data is copied
+template <typename _Tp> MatMap<_Tp> asEigen(Mat &mat)
+{
+  return MatMap<_Tp>(mat.ptr<_Tp>(), mat.rows, mat.cols, Eigen::OuterStride<>(mat.step1()));
+}
+
+template <typename _Tp> ConstMatMap<_Tp> asConstEigen(const Mat &mat)
+{
+  return ConstMatMap<_Tp>(mat.ptr<_Tp>(), mat.rows, mat.cols, Eigen::OuterStride<>(mat.step1()));
+}
+
+// covL = cholesky( cov ), falls back to the square root of the diagonal if cov is not positive definite
+template <typename _Tp> void factorCovariance(const Mat &cov, Mat &covL)
+{
+  if (!choleskyDecomposition<_Tp>(cov.ptr<_Tp>(), cov.step, cov.rows, covL.ptr<_Tp>(), covL.step))
+  {
+    auto L = asEigen<_Tp>(covL);
+    L.setZero();
+    L.diagonal() = asConstEigen<_Tp>(cov).diagonal().cwiseMax(_Tp(0)).cwiseSqrt();
+  }
+}
+
+// Householder triangularization of A in place, A = Q*R. The transposed upper triangle R.t is stored in L with a
+// non-negative diagonal, so that L*L.t = A.t*A. workspace must hold at least A.cols elements.
+template <typename _Tp> void triangularFactor(MatMap<_Tp> A, MatMap<_Tp> L, _Tp *workspace)
+{
+  const Eigen::Index m = A.rows();
+  const Eigen::Index n = A.cols();
+
+  for (Eigen::Index k = 0; k < n; ++k)
+  {
+    _Tp tau;
+    _Tp beta;
+    auto column = A.col(k).tail(m - k);
+    column.makeHouseholderInPlace(tau, beta);
+    A.bottomRightCorner(m - k, n - k - 1).applyHouseholderOnTheLeft(column.tail(m - k - 1), tau, workspace);
+    A(k, k) = beta;
+  }
+
+  L.setZero();
+  for (Eigen::Index k = 0; k < n; ++k)
+  {
+    _Tp sign = A(k, k) < 0 ? _Tp(-1) : _Tp(1);
+    L.col(k).tail(n - k) = sign * A.row(k).segment(k, n - k).transpose();
+  }
+}
+
+// Rank-1 update of a lower triangular cholesky factor in place, L*L.t = L*L.t + sigma*x*x.t, x is overwritten.
+// Returns false if the result is not positive definite, L is then left partially updated.
+template <typename MatrixL, typename VectorX>
+bool choleskyRankUpdate(MatrixL L, VectorX x, typename MatrixL::Scalar sigma)
+{
+  using _Tp = typename MatrixL::Scalar;
+  const Eigen::Index n = L.rows();
+
+  for (Eigen::Index k = 0; k < n; ++k)
+  {
+    _Tp Lkk = L(k, k);
+    _Tp r2 = Lkk * Lkk + sigma * x(k) * x(k);
+
+    if (!(Lkk > 0) || !(r2 > 0))
+    {
+      return false;
+    }
+
+    _Tp rkk = std::sqrt(r2);
+    _Tp c = rkk / Lkk;
+    _Tp s = x(k) / Lkk;
+    L(k, k) = rkk;
+
+    const Eigen::Index tail = n - k - 1;
+    L.col(k).tail(tail) = (L.col(k).tail(tail) + sigma * s * x.tail(tail)) / c;
+    x.tail(tail) = c * x.tail(tail) - s * L.col(k).tail(tail);
+  }
+
+  return true;
+}
+
+// A = [ sqrt(w_i)*S_i.t ; sqrt(w_i)*(x_i - x).t ], i = 1..count, so that A.t*A is the mixed covariance
+template <typename _Tp>
+void stackFactors(const std::vector<Mat> &states,
+                  const std::vector<Mat> &factors,
+                  const std::vector<double> &weights,
+                  const Mat &mixedState,
+                  Mat &compound)
+{
+  const int n = mixedState.rows;
+  const int count = static_cast<int>(states.size());
+
+  compound.create(count * (n + 1), n, mixedState.type());
+  auto A = asEigen<_Tp>(compound);
+  auto x = asConstEigen<_Tp>(mixedState).col(0);
+  for (int i = 0; i < count; ++i)
+  {
+    const _Tp w = std::sqrt(std::max(static_cast<_Tp>(weights[i]), _Tp(0)));
+    A.middleRows(i * (n + 1), n) = w * asConstEigen<_Tp>(factors[i]).transpose();
+    A.row(i * (n + 1) + n) = w * (asConstEigen<_Tp>(states[i]).col(0) - x).transpose();
+  }
+}
+
+template <typename _Tp>
+void mixFactors(const std::vector<Mat> &states,
+                const std::vector<Mat> &factors,
+                const std::vector<double> &weights,
+                const Mat &mixedState,
+                Mat &mixedFactor)
+{
+  const int n = mixedState.rows;
+
+  Mat compound;
+  stackFactors<_Tp>(states, factors, weights, mixedState, compound);
+
+  mixedFactor.create(n, n, mixedState.type());
+  std::vector<_Tp> householderWorkspace(n);
+  triangularFactor<_Tp>(asEigen<_Tp>(compound), asEigen<_Tp>(mixedFactor), householderWorkspace.data());
+}
+
+template <typename _Tp>
+void combineFactors(const std::vector<Mat> &states,
+                    const std::vector<Mat> &factors,
+                    const std::vector<double> &weights,
+                    const Mat &combinedState,
+                    Mat &combinedCovariance)
+{
+  const int n = combinedState.rows;
+
+  Mat compound;
+  stackFactors<_Tp>(states, factors, weights, combinedState, compound);
+
+  auto A = asConstEigen<_Tp>(compound);
+  combinedCovariance.create(n, n, combinedState.type());
+  asEigen<_Tp>(combinedCovariance).noalias() = A.transpose() * A;
+}
+
+} // namespace
+
+void mixCovarianceFactors(const std::vector<Mat> &states,
+                          const std::vector<Mat> &factors,
+                          const std::vector<double> &weights,
+                          const Mat &mixedState,
+                          Mat &mixedFactor)
+{
+  CV_Assert(!states.empty() && states.size() == factors.size() && states.size() == weights.size());
+
+  if (mixedState.type() == CV_64F)
+    mixFactors<double>(states, factors, weights, mixedState, mixedFactor);
+  else
+    mixFactors<float>(states, factors, weights, mixedState, mixedFactor);
+}
+
+void combineCovarianceFactors(const std::vector<Mat> &states,
+                              const std::vector<Mat> &factors,
+                              const std::vector<double> &weights,
+                              const Mat &combinedState,
+                              Mat &combinedCovariance)
+{
+  CV_Assert(!states.empty() && states.size() == factors.size() && states.size() == weights.size());
+
+  if (combinedState.type() == CV_64F)
+    combineFactors<double>(states, factors, weights, combinedState, combinedCovariance);
+  else
+    combineFactors<float>(states, factors, weights, combinedState, combinedCovariance);
+}
+
+void UkfWorkspace::create(int DP, int MP, int dataType)
+{
+  sigmaPoints.create(DP, 2 * DP + 1, dataType);
+  covarianceL.create(DP, DP, dataType);
+
+  transitionSPFuncVals.create(DP, 2 * DP + 1, dataType);
+  transitionSPFuncValsCenter.create(DP, 2 * DP + 1, dataType);
+  transitionSPFuncValsWeighted.create(DP, 2 * DP + 1, dataType);
+
+  measurementSPFuncVals.create(MP, 2 * DP + 1, dataType);
+  measurementSPFuncValsCenter.create(MP, 2 * DP + 1, dataType);
+  measurementSPFuncValsWeighted.create(MP, 2 * DP + 1, dataType);
+
+  stateCompound.create(3 * DP, DP, dataType);
+  measurementCompound.create(2 * DP + MP, MP, dataType);
+  correctionFactor.create(DP, MP, dataType);
+  rankUpdateVector.create(std::max(DP, MP), 1, dataType);
+  householderWorkspace.create(1, std::max(DP, MP), dataType);
+}
+
 UnscentedKalmanFilterMod::UnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params)
+  : UnscentedKalmanFilterMod(params, makePtr<UkfWorkspace>())
+{
+}
+
+UnscentedKalmanFilterMod::UnscentedKalmanFilterMod(const UnscentedKalmanFilterParams &params,
+                                                   const Ptr<UkfWorkspace> &_workspace,
+                                                   bool _squareRoot)
 {
   alpha = params.alpha;
   beta = params.beta;
@@ -38,20 +240,40 @@ UnscentedKalmanFilterMod::UnscentedKalmanFilterMod(const UnscentedKalmanFilterPa
   measurementNoiseCov = params.measurementNoiseCov.clone();
 
   measurementEstimate = Mat::zeros(MP, 1, dataType);
+  innovation = Mat::zeros(MP, 1, dataType);
 
   q = Mat::zeros(DP, 1, dataType);
   r = Mat::zeros(MP, 1, dataType);
 
-  gain = Mat::zeros(DP, DP, dataType);
-
-  transitionSPFuncVals = Mat::zeros(DP, 2 * DP + 1, dataType);
-  measurementSPFuncVals = Mat::zeros(MP, 2 * DP + 1, dataType);
+  gain = Mat::zeros(DP, MP, dataType);
+  xyCov = Mat::zeros(DP, MP, dataType);
+  yyCovL = Mat::zeros(MP, MP, dataType);
 
-  transitionSPFuncValsCenter = Mat::zeros(DP, 2 * DP + 1, dataType);
-  measurementSPFuncValsCenter = Mat::zeros(MP, 2 * DP + 1, dataType);
+  setWorkspace(_workspace);
 
   lambda = alpha * alpha * (DP + k) - DP;
   tmpLambda = lambda + DP;
+  CV_Assert(tmpLambda > 0);
+
+  squareRoot = _squareRoot;
+  errorCovStale = false;
+  errorCovL = Mat::zeros(DP, DP, dataType);
+  processNoiseCovL = Mat::zeros(DP, DP, dataType);
+  measurementNoiseCovL = Mat::zeros(MP, MP, dataType);
+
+  // the only full factorizations of the square-root variant, the factors are propagated afterwards
+  if (squareRoot && dataType == CV_64F)
+  {
+    factorCovariance<double>(errorCov, errorCovL);
+    factorCovariance<double>(processNoiseCov, processNoiseCovL);
+    factorCovariance<double>(measurementNoiseCov, measurementNoiseCovL);
+  }
+  else if (squareRoot)
+  {
+    factorCovariance<float>(errorCov, errorCovL);
+    factorCovariance<float>(processNoiseCov, processNoiseCovL);
+    factorCovariance<float>(measurementNoiseCov, measurementNoiseCovL);
+  }
 
   double tmp2Lambda = 0.5 / tmpLambda;
 
@@ -79,14 +301,9 @@ UnscentedKalmanFilterMod::~UnscentedKalmanFilterMod()
   measurementNoiseCov.release();
 
   measurementEstimate.release();
+  innovation.release();
 
-  sigmaPoints.release();
-
-  transitionSPFuncVals.release();
-  measurementSPFuncVals.release();
-
-  transitionSPFuncValsCenter.release();
-  measurementSPFuncValsCenter.release();
+  workspace.release();
 
   Wm.release();
   Wc.release();
@@ -94,21 +311,82 @@ UnscentedKalmanFilterMod::~UnscentedKalmanFilterMod()
   gain.release();
   xyCov.release();
   yyCov.release();
+  yyCovL.release();
 
   r.release();
   q.release();
+
+  errorCovL.release();
+  processNoiseCovL.release();
+  measurementNoiseCovL.release();
+}
+
+void UnscentedKalmanFilterMod::setWorkspace(const Ptr<UkfWorkspace> &_workspace)
+{
+  CV_Assert(!_workspace.empty());
+  workspace = _workspace;
+  workspace->create(DP, MP, dataType);
+}
+
+void UnscentedKalmanFilterMod::setStateAndCovariance(const Mat &newState, const Mat &newErrorCov)
+{
+  CV_Assert(newState.rows == DP && newState.cols == 1);
+  CV_Assert(newErrorCov.rows == DP && newErrorCov.cols == DP);
+
+  newState.convertTo(state, dataType);
+  newErrorCov.convertTo(errorCov, dataType);
+  errorCovStale = false;
+
+  if (squareRoot && dataType == CV_64F)
+  {
+    factorCovariance<double>(errorCov, errorCovL);
+  }
+  else if (squareRoot)
+  {
+    factorCovariance<float>(errorCov, errorCovL);
+  }
+}
+
+void UnscentedKalmanFilterMod::setStateAndCovarianceFactor(const Mat &newState, const Mat &newErrorCovL)
+{
+  CV_Assert(squareRoot);
+  CV_Assert(newState.rows == DP && newState.cols == 1);
+  CV_Assert(newErrorCovL.rows == DP && newErrorCovL.cols == DP);
+
+  newState.convertTo(state, dataType);
+  newErrorCovL.convertTo(errorCovL, dataType);
+  errorCovStale = true;
+}
+
+void UnscentedKalmanFilterMod::formErrorCov() const
+{
+  if (!errorCovStale)
+  {
+    return;
+  }
+
+  if (dataType == CV_64F)
+  {
+    auto S = asConstEigen<double>(errorCovL);
+    asEigen<double>(errorCov).noalias() = S * S.transpose();
+  }
+  else
+  {
+    auto S = asConstEigen<float>(errorCovL);
+    asEigen<float>(errorCov).noalias() = S * S.transpose();
+  }
+  errorCovStale = false;
 }
 
-Mat UnscentedKalmanFilterMod::getSigmaPoints(const Mat &mean, const Mat &covMatrix, double coef)
+void UnscentedKalmanFilterMod::computeSigmaPoints(const Mat &mean, const Mat &covMatrix, double coef, Mat &points)
 {
   // x_0 = mean
   // x_i = mean + coef * cholesky( covMatrix ), i = 1..n
   // x_(i+n) = mean - coef * cholesky( covMatrix ), i = 1..n
 
-  int n = mean.rows;
-  Mat points = repeat(mean, 1, 2 * n + 1);
+  Mat &covMatrixL = workspace->covarianceL;
 
-  Mat covMatrixL = covMatrix.clone();
+  covMatrix.copyTo(covMatrixL);
 
   // covMatrixL = cholesky( covMatrix )
   if (dataType == CV_64F)
@@ -118,92 +396,350 @@ Mat UnscentedKalmanFilterMod::getSigmaPoints(const Mat &mean, const Mat &covMatr
     choleskyDecomposition<float>(
       covMatrix.ptr<float>(), covMatrix.step, covMatrix.rows, covMatrixL.ptr<float>(), covMatrixL.step);
 
-  covMatrixL = coef * covMatrixL;
+  spreadSigmaPoints(mean, covMatrixL, coef, points);
+}
+
+void UnscentedKalmanFilterMod::spreadSigmaPoints(const Mat &mean, const Mat &covMatrixL, double coef, Mat &points)
+{
+  int n = mean.rows;
+
+  for (int i = 0; i < 2 * n + 1; i++)
+  {
+    mean.copyTo(points.col(i));
+  }
 
   Mat p_plus = points(Rect(1, 0, n, n));
   Mat p_minus = points(Rect(n + 1, 0, n, n));
 
-  add(p_plus, covMatrixL, p_plus);
-  subtract(p_minus, covMatrixL, p_minus);
-
-  return points;
+  scaleAdd(covMatrixL, coef, p_plus, p_plus);
+  scaleAdd(covMatrixL, -coef, p_minus, p_minus);
 }
 
-Mat UnscentedKalmanFilterMod::predict(InputArray _control)
+template <typename _Tp> void UnscentedKalmanFilterMod::predictImpl(const Mat &control)
 {
-  Mat control = _control.getMat();
+  UkfWorkspace &ws = *workspace;
+  ws.create(DP, MP, dataType);
+  yyCov.create(MP, MP, dataType);
+
+  auto wm = asConstEigen<_Tp>(Wm).col(0);
+  auto wc = asConstEigen<_Tp>(Wc).diagonal();
+
   // get sigma points from x* and P
-  sigmaPoints = getSigmaPoints(state, errorCov, sqrt(tmpLambda));
+  computeSigmaPoints(state, errorCov, sqrt(tmpLambda), ws.sigmaPoints);
 
   // compute f-function values at sigma points
   // f_i = f(x_i, control, 0), i = 0..2*DP
-  Mat x, fx;
   for (int i = 0; i < 2 * DP + 1; i++)
   {
-    x = sigmaPoints(Rect(i, 0, 1, DP));
-    fx = transitionSPFuncVals(Rect(i, 0, 1, DP));
-    model->stateConversionFunction(x, control, q, fx);
+    Mat xi = ws.sigmaPoints.col(i);
+    Mat fx = ws.transitionSPFuncVals.col(i);
+    model->stateConversionFunction(xi, control, q, fx);
   }
+
+  auto x = asEigen<_Tp>(state);
+  auto P = asEigen<_Tp>(errorCov);
+  auto f = asEigen<_Tp>(ws.transitionSPFuncVals);
+  auto fc = asEigen<_Tp>(ws.transitionSPFuncValsCenter);
+  auto fcWeighted = asEigen<_Tp>(ws.transitionSPFuncValsWeighted);
+
   // compute the estimate of state as mean f-function value at sigma point
   // x* = SUM_{i=0}^{2*DP}( Wm[i]*f_i )
-  state = transitionSPFuncVals * Wm;
+  x.col(0).noalias() = f * wm;
 
   // compute f-function values at sigma points minus estimate of state
   // fc_i = f_i - x*, i = 0..2*DP
-  subtract(transitionSPFuncVals, repeat(state, 1, 2 * DP + 1), transitionSPFuncValsCenter);
+  fc = f.colwise() - x.col(0);
 
   // compute the estimate of the state cross-covariance matrix
   // P = SUM_{i=0}^{2*DP}( Wc[i]*fc_i*fc_i.t ) + Q
-  errorCov = transitionSPFuncValsCenter * Wc * transitionSPFuncValsCenter.t() + processNoiseCov;
+  fcWeighted = fc * wc.asDiagonal();
+  P.noalias() = fcWeighted * fc.transpose();
+  P += asConstEigen<_Tp>(processNoiseCov);
 
-  // This poart has been moved from the predict function to allow the calculation of the yyCov matrix (measurement covariance)
-  // get sigma points from x* and P
-  sigmaPoints = getSigmaPoints(state, errorCov, sqrt(tmpLambda));
+  // Resample sigma points around the predicted state x* and P, they are needed for both the predicted measurement
+  // covariance yyCov and the cross-covariance xyCov used by correct()
+  computeSigmaPoints(state, errorCov, sqrt(tmpLambda), ws.sigmaPoints);
 
   // compute h-function values at sigma points
   // h_i = h(x_i, 0), i = 0..2*DP
-  Mat hx;
   for (int i = 0; i < 2 * DP + 1; i++)
   {
-    x = sigmaPoints(Rect(i, 0, 1, DP));
-    hx = measurementSPFuncVals(Rect(i, 0, 1, MP));
-    model->measurementFunction(x, r, hx);
+    Mat xi = ws.sigmaPoints.col(i);
+    Mat hx = ws.measurementSPFuncVals.col(i);
+    model->measurementFunction(xi, r, hx);
   }
 
+  auto y = asEigen<_Tp>(measurementEstimate);
+  auto h = asEigen<_Tp>(ws.measurementSPFuncVals);
+  auto hc = asEigen<_Tp>(ws.measurementSPFuncValsCenter);
+  auto hcWeighted = asEigen<_Tp>(ws.measurementSPFuncValsWeighted);
+
   // compute the estimate of measurement as mean h-function value at sigma point
   // y* = SUM_{i=0}^{2*DP}( Wm[i]*h_i )
-  measurementEstimate = measurementSPFuncVals * Wm;
+  y.col(0).noalias() = h * wm;
 
-  // compute h-function values at sigma points minus estimate of state
+  // compute h-function values at sigma points minus estimate of measurement
   // hc_i = h_i - y*, i = 0..2*DP
-  subtract(measurementSPFuncVals, repeat(measurementEstimate, 1, 2 * DP + 1), measurementSPFuncValsCenter);
+  hc = h.colwise() - y.col(0);
+  hcWeighted = hc * wc.asDiagonal();
 
   // compute the estimate of the y* cross-covariance matrix
   // Syy = SUM_{i=0}^{2*DP}( Wc[i]*hc_i*hc_i.t ) + R
-  yyCov = measurementSPFuncValsCenter * Wc * measurementSPFuncValsCenter.t() + measurementNoiseCov;
-
-
-  return state.clone();
+  auto Syy = asEigen<_Tp>(yyCov);
+  Syy.noalias() = hcWeighted * hc.transpose();
+  Syy += asConstEigen<_Tp>(measurementNoiseCov);
+
+  // compute the estimate of the covariance between x* and y* while the sigma points used for Syy are available, the
+  // workspace may be reused by other filters before correct() is called
+  // xc_i = x_i - x*, i = 0..2*DP
+  // Sxy = SUM_{i=0}^{2*DP}( Wc[i]*xc_i*hc_i.t )
+  auto xc = asEigen<_Tp>(ws.transitionSPFuncValsCenter);
+  xc = asEigen<_Tp>(ws.sigmaPoints).colwise() - x.col(0);
+  asEigen<_Tp>(xyCov).noalias() = xc * hcWeighted.transpose();
 }
 
-Mat UnscentedKalmanFilterMod::correct(InputArray _measurement)
+template <typename _Tp> void UnscentedKalmanFilterMod::correctImpl(const Mat &measurement)
 {
-  Mat measurement = _measurement.getMat();
-  // compute the estimate of the covariance between x* and y*
-  // Sxy = SUM_{i=0}^{2*DP}( Wc[i]*fc_i*hc_i.t )
-  xyCov = transitionSPFuncValsCenter * Wc * measurementSPFuncValsCenter.t();
+  auto Sxy = asConstEigen<_Tp>(xyCov);
 
   // compute the Kalman gain matrix
-  // K = Sxy * Syy^(-1)
-  gain = xyCov * yyCov.inv(DECOMP_SVD);
+  // K = Sxy * Syy^(-1) = Sxy * (L * L.t)^(-1)
+  if (choleskyDecomposition<_Tp>(yyCov.ptr<_Tp>(), yyCov.step, MP, yyCovL.ptr<_Tp>(), yyCovL.step))
+  {
+    auto K = asEigen<_Tp>(gain);
+    auto L = asConstEigen<_Tp>(yyCovL);
+    K = Sxy;
+    L.transpose().template triangularView<Eigen::Upper>().template solveInPlace<Eigen::OnTheRight>(K);
+    L.template triangularView<Eigen::Lower>().template solveInPlace<Eigen::OnTheRight>(K);
+  }
+  else
+  {
+    // Syy is not positive definite, fall back to the pseudo-inverse
+    gemm(xyCov, yyCov.inv(DECOMP_SVD), 1.0, noArray(), 0.0, gain);
+  }
+
+  auto K = asConstEigen<_Tp>(gain);
 
   // compute the corrected estimate of state
   // x* = x* + K*(y - y*), y - current measurement
-  state = state + gain * (measurement - measurementEstimate);
+  auto v = asEigen<_Tp>(innovation);
+  v = asConstEigen<_Tp>(measurement) - asConstEigen<_Tp>(measurementEstimate);
+  asEigen<_Tp>(state).noalias() += K * v;
 
   // compute the corrected estimate of the state cross-covariance matrix
   // P = P - K*Sxy.t
-  errorCov = errorCov - gain * xyCov.t();
+  asEigen<_Tp>(errorCov).noalias() -= K * Sxy.transpose();
+}
+
+template <typename _Tp> void UnscentedKalmanFilterMod::predictSquareRootImpl(const Mat &control)
+{
+  UkfWorkspace &ws = *workspace;
+  ws.create(DP, MP, dataType);
+  yyCov.create(MP, MP, dataType);
+
+  auto wm = asConstEigen<_Tp>(Wm).col(0);
+  auto wc = asConstEigen<_Tp>(Wc).diagonal();
+  const _Tp sqrtWc = std::sqrt(wc(1)); // Wc[i] is the same positive value for i = 1..2*DP
+  const _Tp sqrtWc0 = std::sqrt(std::abs(wc(0)));
+  const _Tp signWc0 = wc(0) < 0 ? _Tp(-1) : _Tp(1);
+  _Tp *householderWorkspace = ws.householderWorkspace.ptr<_Tp>();
+
+  // get sigma points from x* and S, the factor is already available
+  spreadSigmaPoints(state, errorCovL, sqrt(tmpLambda), ws.sigmaPoints);
+
+  // compute f-function values at sigma points
+  // f_i = f(x_i, control, 0), i = 0..2*DP
+  for (int i = 0; i < 2 * DP + 1; i++)
+  {
+    Mat xi = ws.sigmaPoints.col(i);
+    Mat fx = ws.transitionSPFuncVals.col(i);
+    model->stateConversionFunction(xi, control, q, fx);
+  }
+
+  auto x = asEigen<_Tp>(state);
+  auto P = asEigen<_Tp>(errorCov);
+  auto S = asEigen<_Tp>(errorCovL);
+  auto f = asEigen<_Tp>(ws.transitionSPFuncVals);
+  auto fc = asEigen<_Tp>(ws.transitionSPFuncValsCenter);
+  auto u = asEigen<_Tp>(ws.rankUpdateVector).col(0);
+
+  // x* = SUM_{i=0}^{2*DP}( Wm[i]*f_i )
+  x.col(0).noalias() = f * wm;
+
+  // fc_i = f_i - x*, i = 0..2*DP
+  fc = f.colwise() - x.col(0);
+
+  // compute the factor of the state cross-covariance matrix
+  // S = qr( [ sqrt(Wc[i])*fc_i, i = 1..2*DP | sqrt(Q) ].t ).t
+  // S = cholupdate( S, sqrt(|Wc[0]|)*fc_0, sign(Wc[0]) )
+  auto A = asEigen<_Tp>(ws.stateCompound);
+  A.topRows(2 * DP) = sqrtWc * fc.rightCols(2 * DP).transpose();
+  A.bottomRows(DP) = asConstEigen<_Tp>(processNoiseCovL).transpose();
+  triangularFactor<_Tp>(A, S, householderWorkspace);
+
+  u.head(DP) = sqrtWc0 * fc.col(0);
+  if (choleskyRankUpdate(S, u.head(DP), signWc0))
+  {
+    errorCovStale = true;
+  }
+  else
+  {
+    // the downdate lost positive definiteness, rebuild the factor from the full covariance
+    // P = SUM_{i=0}^{2*DP}( Wc[i]*fc_i*fc_i.t ) + Q
+    auto fcWeighted = asEigen<_Tp>(ws.transitionSPFuncValsWeighted);
+    fcWeighted = fc * wc.asDiagonal();
+    P.noalias() = fcWeighted * fc.transpose();
+    P += asConstEigen<_Tp>(processNoiseCov);
+    factorCovariance<_Tp>(errorCov, errorCovL);
+    errorCovStale = false;
+  }
+
+  // Resample sigma points around the predicted state x* and S
+  spreadSigmaPoints(state, errorCovL, sqrt(tmpLambda), ws.sigmaPoints);
+
+  // compute h-function values at sigma points
+  // h_i = h(x_i, 0), i = 0..2*DP
+  for (int i = 0; i < 2 * DP + 1; i++)
+  {
+    Mat xi = ws.sigmaPoints.col(i);
+    Mat hx = ws.measurementSPFuncVals.col(i);
+    model->measurementFunction(xi, r, hx);
+  }
+
+  auto y = asEigen<_Tp>(measurementEstimate);
+  auto h = asEigen<_Tp>(ws.measurementSPFuncVals);
+  auto hc = asEigen<_Tp>(ws.measurementSPFuncValsCenter);
+  auto hcWeighted = asEigen<_Tp>(ws.measurementSPFuncValsWeighted);
+  auto Syy = asEigen<_Tp>(yyCov);
+  auto Sy = asEigen<_Tp>(yyCovL);
+
+  // y* = SUM_{i=0}^{2*DP}( Wm[i]*h_i )
+  y.col(0).noalias() = h * wm;
+
+  // hc_i = h_i - y*, i = 0..2*DP
+  hc = h.colwise() - y.col(0);
+  hcWeighted = hc * wc.asDiagonal();
+
+  // compute the factor of the y* cross-covariance matrix
+  // Sy = qr( [ sqrt(Wc[i])*hc_i, i = 1..2*DP | sqrt(R) ].t ).t
+  // Sy = cholupdate( Sy, sqrt(|Wc[0]|)*hc_0, sign(Wc[0]) )
+  auto B = asEigen<_Tp>(ws.measurementCompound);
+  B.topRows(2 * DP) = sqrtWc * hc.rightCols(2 * DP).transpose();
+  B.bottomRows(MP) = asConstEigen<_Tp>(measurementNoiseCovL).transpose();
+  triangularFactor<_Tp>(B, Sy, householderWorkspace);
+
+  u.head(MP) = sqrtWc0 * hc.col(0);
+  if (choleskyRankUpdate(Sy, u.head(MP), signWc0))
+  {
+    Syy.noalias() = Sy * Sy.transpose();
+  }
+  else
+  {
+    // Syy = SUM_{i=0}^{2*DP}( Wc[i]*hc_i*hc_i.t ) + R
+    Syy.noalias() = hcWeighted * hc.transpose();
+    Syy += asConstEigen<_Tp>(measurementNoiseCov);
+    factorCovariance<_Tp>(yyCov, yyCovL);
+  }
+
+  // xc_i = x_i - x*, i = 0..2*DP
+  // Sxy = SUM_{i=0}^{2*DP}( Wc[i]*xc_i*hc_i.t )
+  auto xc = asEigen<_Tp>(ws.transitionSPFuncValsCenter);
+  xc = asEigen<_Tp>(ws.sigmaPoints).colwise() - x.col(0);
+  asEigen<_Tp>(xyCov).noalias() = xc * hcWeighted.transpose();
+}
+
+template <typename _Tp> void UnscentedKalmanFilterMod::correctSquareRootImpl(const Mat &measurement)
+{
+  UkfWorkspace &ws = *workspace;
+
+  auto Sxy = asConstEigen<_Tp>(xyCov);
+  auto Sy = asConstEigen<_Tp>(yyCovL);
+  auto K = asEigen<_Tp>(gain);
+
+  // compute the Kalman gain matrix with the factor of Syy from predict
+  // K = Sxy * (Sy * Sy.t)^(-1)
+  K = Sxy;
+  Sy.transpose().template triangularView<Eigen::Upper>().template solveInPlace<Eigen::OnTheRight>(K);
+  Sy.template triangularView<Eigen::Lower>().template solveInPlace<Eigen::OnTheRight>(K);
+
+  // x* = x* + K*(y - y*), y - current measurement
+  auto v = asEigen<_Tp>(innovation);
+  v = asConstEigen<_Tp>(measurement) - asConstEigen<_Tp>(measurementEstimate);
+  asEigen<_Tp>(state).noalias() += K * v;
+
+  // compute the corrected factor of the state cross-covariance matrix
+  // U = K*Sy
+  // S = cholupdate( S, U_j, -1 ), j = 1..MP
+  auto U = asEigen<_Tp>(ws.correctionFactor);
+  auto S = asEigen<_Tp>(errorCovL);
+  auto u = asEigen<_Tp>(ws.rankUpdateVector).col(0).head(DP);
+  U.noalias() = K * Sy;
+
+  // the downdates may fail half way, the covariance is then rebuilt from this copy of the factor
+  auto previousS = asEigen<_Tp>(ws.covarianceL);
+  previousS = S;
+
+  bool success = true;
+  for (int j = 0; j < MP && success; j++)
+  {
+    u = U.col(j);
+    success = choleskyRankUpdate(S, u, _Tp(-1));
+  }
+
+  auto P = asEigen<_Tp>(errorCov);
+  if (success)
+  {
+    errorCovStale = true;
+  }
+  else
+  {
+    // P = P - K*Sxy.t
+    if (errorCovStale)
+    {
+      P.noalias() = previousS * previousS.transpose();
+    }
+    P.noalias() -= K * Sxy.transpose();
+    factorCovariance<_Tp>(errorCov, errorCovL);
+    errorCovStale = false;
+  }
+}
+
+void UnscentedKalmanFilterMod::predictStep(const Mat &control)
+{
+  if (squareRoot && dataType == CV_64F)
+    predictSquareRootImpl<double>(control);
+  else if (squareRoot)
+    predictSquareRootImpl<float>(control);
+  else if (dataType == CV_64F)
+    predictImpl<double>(control);
+  else
+    predictImpl<float>(control);
+}
+
+void UnscentedKalmanFilterMod::correctStep(const Mat &measurement)
+{
+  CV_Assert(measurement.rows == MP && measurement.cols == 1 && measurement.type() == dataType);
+
+  if (squareRoot && dataType == CV_64F)
+    correctSquareRootImpl<double>(measurement);
+  else if (squareRoot)
+    correctSquareRootImpl<float>(measurement);
+  else if (dataType == CV_64F)
+    correctImpl<double>(measurement);
+  else
+    correctImpl<float>(measurement);
+}
+
+Mat UnscentedKalmanFilterMod::predict(InputArray _control)
+{
+  predictStep(_control.getMat());
+
+  return state.clone();
+}
+
+Mat UnscentedKalmanFilterMod::correct(InputArray _measurement)
+{
+  correctStep(_measurement.getMat());
 
   return state.clone();
 }
@@ -225,6 +761,7 @@ Mat UnscentedKalmanFilterMod::getMeasurementCov() const
 
 Mat UnscentedKalmanFilterMod::getErrorCov() const
 {
+  formErrorCov();
   return errorCov.clone();
 }
 
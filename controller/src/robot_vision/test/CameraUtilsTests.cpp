@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <rv/tracking/CameraUtils.hpp>
+
+namespace {
+
+cv::Mat testIntrinsics()
+{
+  cv::Mat intrinsics = cv::Mat::zeros(3, 3, CV_64F);
+  intrinsics.at<double>(0, 0) = 1000.;
+  intrinsics.at<double>(1, 1) = 1000.;
+  intrinsics.at<double>(0, 2) = 960.;
+  intrinsics.at<double>(1, 2) = 540.;
+  intrinsics.at<double>(2, 2) = 1.;
+  return intrinsics;
+}
+
+cv::Mat testDistortion()
+{
+  cv::Mat distortion = cv::Mat::zeros(1, 5, CV_64F);
+  distortion.at<double>(0, 0) = -0.3;
+  distortion.at<double>(0, 1) = 0.1;
+  distortion.at<double>(0, 2) = 0.001;
+  distortion.at<double>(0, 3) = -0.001;
+  return distortion;
+}
+
+} // namespace
+
+TEST(UndistortionMapTest, MatchesUndistortPointsWithinTheErrorBound)
+{
+  const cv::Mat intrinsics = testIntrinsics();
+  const cv::Mat distortion = testDistortion();
+  const rv::CameraParams params{intrinsics, distortion};
+  const double maxError = 1e-4;
+  const rv::UndistortionMap map(params, cv::Size(1920, 1080), maxError);
+
+  EXPECT_LE(map.getMaxError(), maxError);
+  EXPECT_GE(map.getCellSize(), 1);
+
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<float> x(0.f, 1800.f);
+  std::uniform_real_distribution<float> y(0.f, 1000.f);
+  std::uniform_real_distribution<float> size(1.f, 100.f);
+  std::vector<cv::Rect2f> boxes;
+  for (int i = 0; i < 1000; ++i)
+  {
+    boxes.emplace_back(x(generator), y(generator), size(generator), size(generator));
+  }
+  // corners outside the image use the exact undistortion
+  boxes.emplace_back(-50.f, -20.f, 100.f, 100.f);
+  boxes.emplace_back(1900.f, 1050.f, 100.f, 100.f);
+
+  const auto expected = rv::computePixelsToMeterPlane(boxes, params);
+  const auto actual = map.computePixelsToMeterPlane(boxes);
+  ASSERT_EQ(actual.size(), expected.size());
+  // the width and height combine the errors of both corners
+  const double tolerance = 2. * maxError + 1e-5;
+  for (size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_NEAR(actual[i].x, expected[i].x, tolerance);
+    EXPECT_NEAR(actual[i].y, expected[i].y, tolerance);
+    EXPECT_NEAR(actual[i].width, expected[i].width, 2. * tolerance);
+    EXPECT_NEAR(actual[i].height, expected[i].height, 2. * tolerance);
+  }
+  // the top left corner of the first border box is outside the grid
+  EXPECT_FLOAT_EQ(actual[boxes.size() - 2].x, expected[boxes.size() - 2].x);
+  EXPECT_FLOAT_EQ(actual[boxes.size() - 2].y, expected[boxes.size() - 2].y);
+
+  const cv::Rect2f single = map.computePixelsToMeterPlane(boxes[0]);
+  EXPECT_FLOAT_EQ(single.x, actual[0].x);
+  EXPECT_FLOAT_EQ(single.width, actual[0].width);
+}
+
+TEST(UndistortionMapTest, DetectsCalibrationChanges)
+{
+  const cv::Mat intrinsics = testIntrinsics();
+  const cv::Mat distortion = testDistortion();
+  const rv::UndistortionMap map(rv::CameraParams{intrinsics, distortion});
+
+  cv::Mat singlePrecision;
+  intrinsics.convertTo(singlePrecision, CV_32F);
+  EXPECT_TRUE(map.matches(rv::CameraParams{singlePrecision, distortion}));
+
+  cv::Mat changed = distortion.clone();
+  changed.at<double>(0, 0) = -0.25;
+  EXPECT_FALSE(map.matches(rv::CameraParams{intrinsics, changed}));
+  const cv::Mat noDistortion;
+  EXPECT_FALSE(map.matches(rv::CameraParams{intrinsics, noDistortion}));
+}
+
+TEST(CameraProjectionTest, ProjectsBoxesOntoTheGroundPlane)
+{
+  // camera 10m above the origin looking straight down
+  cv::Mat pose = cv::Mat::eye(4, 4, CV_64F);
+  pose.at<double>(1, 1) = -1.;
+  pose.at<double>(2, 2) = -1.;
+  pose.at<double>(2, 3) = 10.;
+  const cv::Mat intrinsics = testIntrinsics();
+  const cv::Mat distortion = cv::Mat::zeros(1, 5, CV_64F);
+  const rv::CameraProjection projection(pose, rv::CameraParams{intrinsics, distortion});
+  EXPECT_TRUE(projection.matches(pose, rv::CameraParams{intrinsics, distortion}));
+
+  const cv::Point3d ground = projection.cameraPointToWorldPoint(cv::Point2d(0.1, 0.2));
+  EXPECT_NEAR(ground.x, 1., 1e-9);
+  EXPECT_NEAR(ground.y, -2., 1e-9);
+  EXPECT_NEAR(ground.z, 0., 1e-9);
+
+  const rv::GroundProjection box = projection.projectBox(cv::Rect2d(-0.1, -0.1, 0.2, 0.2));
+  EXPECT_NEAR(box.bounds.width, 2., 1e-9);
+  EXPECT_NEAR(box.bounds.height, 2. * std::sin(std::atan2(10., std::sqrt(102.))), 1e-9);
+  EXPECT_NEAR(box.baseAngle, std::atan2(10., 1.) * 180. / M_PI, 1e-9);
+  EXPECT_NEAR(box.shadow[0].x, -1., 1e-9);
+  EXPECT_NEAR(box.shadow[0].y, 1., 1e-9);
+  // the bottom center is at (0, -1), it is pushed away from the camera by half the box width
+  EXPECT_NEAR(box.position.x, 0., 1e-9);
+  EXPECT_NEAR(box.position.y, -2., 1e-9);
+
+  const auto boxes = projection.projectBoxes({cv::Rect2d(-0.1, -0.1, 0.2, 0.2)}, {1}, {cv::Vec2d(4., 4.)});
+  ASSERT_EQ(boxes.size(), 1u);
+  // TYPE_2 objects are raised by the base angle, the given size sets the shift
+  EXPECT_NEAR(boxes[0].position.y, -10. * (0.1 - 0.1 * box.baseAngle / 90.) - 2., 1e-9);
+
+  // a point on the ground is reprojected onto the pixel it came from
+  const cv::Rect2d bounds = projection.projectEstimatedBounds(ground, cv::Size2d(0., 0.));
+  EXPECT_NEAR(bounds.x, 1000. * 0.1 + 960., 1e-6);
+  EXPECT_NEAR(bounds.y, 1000. * 0.2 + 540., 1e-6);
+}
+
+TEST(CameraProjectionTest, CullsRaysAtTheHorizon)
+{
+  // camera 4m above the origin looking along the world x axis
+  cv::Mat pose = cv::Mat::zeros(4, 4, CV_64F);
+  pose.at<double>(0, 2) = 1.;
+  pose.at<double>(1, 0) = -1.;
+  pose.at<double>(2, 1) = -1.;
+  pose.at<double>(2, 3) = 4.;
+  pose.at<double>(3, 3) = 1.;
+  const cv::Mat intrinsics = testIntrinsics();
+  const cv::Mat distortion = cv::Mat::zeros(1, 5, CV_64F);
+  const rv::CameraProjection projection(pose, rv::CameraParams{intrinsics, distortion});
+
+  const cv::Point3d horizon = projection.cameraPointToWorldPoint(cv::Point2d(0., -0.1));
+  EXPECT_NEAR(horizon.x, std::sqrt(2. * 6371000. * 4.), 1e-6);
+  EXPECT_NEAR(horizon.y, 0., 1e-6);
+  EXPECT_NEAR(horizon.z, 0., 1e-9);
+
+  const cv::Point3d ground = projection.cameraPointToWorldPoint(cv::Point2d(0., 0.5));
+  EXPECT_NEAR(ground.x, 8., 1e-9);
+  EXPECT_NEAR(ground.z, 0., 1e-9);
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <rv/tracking/ClusterTracker.hpp>
+
+using rv::tracking::ClusterMeasurement;
+using rv::tracking::ClusterState;
+using rv::tracking::ClusterTracker;
+using rv::tracking::ClusterTrackerConfig;
+using rv::tracking::TrackedCluster;
+
+namespace {
+
+ClusterMeasurement cluster(const std::string &category, double x, double y, uint32_t objectCount = 4u)
+{
+  ClusterMeasurement measurement;
+  measurement.category = category;
+  measurement.x = x;
+  measurement.y = y;
+  measurement.objectCount = objectCount;
+  measurement.shape = "circle";
+  return measurement;
+}
+
+ClusterTrackerConfig config()
+{
+  ClusterTrackerConfig config;
+  config.mFramesToActivate = 3u;
+  config.mFramesToStable = 5u;
+  config.mFramesToFade = 2u;
+  config.mFramesToLost = 2u;
+  config.mArchiveTime = 1.;
+  return config;
+}
+
+} // namespace
+
+TEST(ClusterTrackerTest, FollowsClustersThroughTheirLifecycle)
+{
+  ClusterTracker tracker(config());
+  double timestamp = 0.;
+
+  tracker.track({cluster("person", 0., 0.)}, timestamp);
+  auto clusters = tracker.getClusters();
+  ASSERT_EQ(clusters.size(), 1u);
+  auto const id = clusters[0].id;
+  EXPECT_EQ(clusters[0].state, ClusterState::New);
+  EXPECT_EQ(clusters[0].measurementIndex, 0);
+  EXPECT_DOUBLE_EQ(clusters[0].confidence, 0.5);
+
+  // a slowly moving cluster keeps its id, is activated and then stable
+  for (int frame = 1; frame < 3; ++frame)
+  {
+    timestamp += 0.1;
+    tracker.track({cluster("person", 0.05 * frame, 0.)}, timestamp);
+  }
+  auto state = tracker.getCluster(id);
+  EXPECT_EQ(tracker.getClusters().size(), 1u);
+  EXPECT_EQ(state.state, ClusterState::Active);
+  EXPECT_EQ(state.framesDetected, 3u);
+
+  for (int frame = 3; frame < 6; ++frame)
+  {
+    timestamp += 0.1;
+    tracker.track({cluster("person", 0.05 * frame, 0.)}, timestamp);
+  }
+  state = tracker.getCluster(id);
+  EXPECT_EQ(state.state, ClusterState::Stable);
+  EXPECT_GT(state.stabilityScore, 0.7);
+  EXPECT_GT(state.vx, 0.);
+
+  // missed frames fade the cluster, a detection brings it back
+  timestamp += 0.1;
+  tracker.track({}, timestamp);
+  EXPECT_EQ(tracker.getCluster(id).framesMissed, 1u);
+  EXPECT_EQ(tracker.getCluster(id).measurementIndex, -1);
+  timestamp += 0.1;
+  tracker.track({}, timestamp);
+  EXPECT_EQ(tracker.getCluster(id).state, ClusterState::Fading);
+  timestamp += 0.1;
+  tracker.track({cluster("person", 0.4, 0.)}, timestamp);
+  EXPECT_EQ(tracker.getCluster(id).state, ClusterState::Active);
+
+  // lost after mFramesToFade + mFramesToLost misses, archived after mArchiveTime
+  for (int frame = 0; frame < 4; ++frame)
+  {
+    timestamp += 0.1;
+    tracker.track({}, timestamp);
+  }
+  state = tracker.getCluster(id);
+  EXPECT_EQ(state.state, ClusterState::Lost);
+  double const lastSeen = state.lastSeen;
+
+  while (timestamp - lastSeen <= 1.)
+  {
+    timestamp += 0.1;
+    tracker.track({}, timestamp);
+  }
+  EXPECT_FALSE(tracker.hasCluster(id));
+  EXPECT_TRUE(tracker.getClusters().empty());
+}
+
+TEST(ClusterTrackerTest, MatchesWithinCategoryAndDistance)
+{
+  ClusterTracker tracker(config());
+
+  tracker.track({cluster("person", 0., 0.), cluster("vehicle", 0., 0.)}, 0.);
+  auto clusters = tracker.getClusters();
+  ASSERT_EQ(clusters.size(), 2u);
+  EXPECT_NE(clusters[0].id, clusters[1].id);
+  EXPECT_EQ(clusters[0].category, "person");
+  EXPECT_EQ(clusters[1].category, "vehicle");
+
+  // the far detection is a new cluster, the measurement indices follow the input
+  tracker.track({cluster("vehicle", 20., 0.), cluster("person", 0.1, 0.), cluster("vehicle", 0.1, 0.)}, 0.1);
+  clusters = tracker.getClusters();
+  ASSERT_EQ(clusters.size(), 3u);
+  EXPECT_EQ(clusters[0].measurementIndex, 1);
+  EXPECT_EQ(clusters[0].framesDetected, 2u);
+  EXPECT_EQ(clusters[1].measurementIndex, 2);
+  EXPECT_EQ(clusters[2].measurementIndex, 0);
+  EXPECT_EQ(clusters[2].category, "vehicle");
+  EXPECT_EQ(clusters[2].state, ClusterState::New);
+
+  EXPECT_EQ(tracker.clearCategory("vehicle"), 2u);
+  clusters = tracker.getClusters();
+  ASSERT_EQ(clusters.size(), 1u);
+  EXPECT_EQ(clusters[0].category, "person");
+  EXPECT_THROW(tracker.getCluster(clusters[0].id + 1), std::runtime_error);
+
+  tracker.reset();
+  EXPECT_TRUE(tracker.getClusters().empty());
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <rv/tracking/RegionOccupancy.hpp>
+
+using rv::tracking::RegionEvent;
+using rv::tracking::RegionOccupancy;
+
+namespace {
+
+std::vector<RegionEvent> update(RegionOccupancy &occupancy, double timestamp, const std::vector<std::string> &tracks,
+                                const std::vector<uint8_t> &membership)
+{
+  return occupancy.update("person", timestamp, {"zone"}, tracks, membership.data());
+}
+
+} // namespace
+
+TEST(RegionOccupancyTest, PublishesEntriesAndExitsWithDwell)
+{
+  RegionOccupancy occupancy(0.5);
+
+  auto events = update(occupancy, 10., {"a", "b"}, {1, 0});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_TRUE(events[0].fired);
+  EXPECT_EQ(events[0].marked, std::vector<std::string>({"a"}));
+  EXPECT_EQ(events[0].entered, std::vector<std::string>({"a"}));
+  EXPECT_TRUE(events[0].countChanged);
+  EXPECT_EQ(occupancy.count("zone", "person"), 1u);
+  EXPECT_EQ(occupancy.enteredAt("zone", "a"), 10.);
+
+  // no change, no event
+  EXPECT_TRUE(update(occupancy, 11., {"a", "b"}, {1, 0}).empty());
+
+  events = update(occupancy, 12., {"b"}, {0});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_TRUE(events[0].fired);
+  EXPECT_TRUE(events[0].entered.empty());
+  ASSERT_EQ(events[0].exited.size(), 1u);
+  EXPECT_EQ(events[0].exited[0].first, "a");
+  EXPECT_DOUBLE_EQ(events[0].exited[0].second, 2.);
+  EXPECT_EQ(events[0].count, 0u);
+  EXPECT_TRUE(std::isnan(occupancy.enteredAt("zone", "a")));
+}
+
+TEST(RegionOccupancyTest, DebouncesChangesButMarksEntriesImmediately)
+{
+  RegionOccupancy occupancy(0.5);
+  update(occupancy, 10., {"a", "b"}, {1, 0});
+
+  // within the debounce delay the change stays pending, the entry time is recorded right away
+  auto events = update(occupancy, 10.2, {"a", "b"}, {1, 1});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_FALSE(events[0].fired);
+  EXPECT_EQ(events[0].arrived, std::vector<std::string>({"b"}));
+  EXPECT_EQ(events[0].marked, std::vector<std::string>({"b"}));
+  EXPECT_EQ(occupancy.count("zone", "person"), 1u);
+
+  // still pending, b is not marked twice
+  events = update(occupancy, 10.4, {"a", "b"}, {1, 1});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_FALSE(events[0].fired);
+  EXPECT_TRUE(events[0].marked.empty());
+
+  events = update(occupancy, 10.6, {"a", "b"}, {1, 1});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_TRUE(events[0].fired);
+  EXPECT_EQ(events[0].entered, std::vector<std::string>({"b"}));
+  EXPECT_EQ(occupancy.count("zone", "person"), 2u);
+  EXPECT_EQ(occupancy.enteredAt("zone", "b"), 10.2);
+
+  // categories are published separately but share the debounce of the region
+  events = occupancy.update("vehicle", 10.8, {"zone"}, {"c"}, std::vector<uint8_t>{1}.data());
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_FALSE(events[0].fired);
+
+  occupancy.removeRegion("zone");
+  EXPECT_EQ(occupancy.count("zone", "person"), 0u);
+}
+
+TEST(RegionOccupancyTest, ForgetsEntriesOfTracksLeavingWithinTheDebounce)
+{
+  RegionOccupancy occupancy(0.5);
+  update(occupancy, 10., {"a", "b"}, {1, 0});
+
+  // b arrives and leaves before its arrival can be published
+  update(occupancy, 10.2, {"a", "b"}, {1, 1});
+  EXPECT_EQ(occupancy.enteredAt("zone", "b"), 10.2);
+  EXPECT_TRUE(update(occupancy, 10.3, {"a", "b"}, {1, 0}).empty());
+  EXPECT_TRUE(std::isnan(occupancy.enteredAt("zone", "b")));
+  EXPECT_EQ(occupancy.enteredAt("zone", "a"), 10.);
+  EXPECT_EQ(occupancy.mRegions.at("zone").entered.at("person").size(), 1u);
+
+  // another category is left alone, a new arrival of b is marked again
+  occupancy.update("vehicle", 10.4, {"zone"}, {"c"}, std::vector<uint8_t>{1}.data());
+  auto events = update(occupancy, 10.6, {"a", "b"}, {1, 1});
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].marked, std::vector<std::string>({"b"}));
+  EXPECT_EQ(occupancy.enteredAt("zone", "b"), 10.6);
+  EXPECT_EQ(occupancy.enteredAt("zone", "c"), 10.4);
+}
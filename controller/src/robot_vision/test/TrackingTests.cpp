@@ -2,13 +2,22 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <memory>
 #include <rv/tracking/MultipleObjectTracker.hpp>
 #include <rv/tracking/Classification.hpp>
+#include <rv/tracking/Measurement.hpp>
 #include <rv/tracking/TrackedObject.hpp>
 
-TEST(MultipleObjectTrackerTest, SingleDetectionTracking)
+// The tracker accuracy checks run with the filters and the matcher in double and in single precision
+class MultipleObjectTrackerTest : public ::testing::TestWithParam<bool>
+{
+};
+
+TEST_P(MultipleObjectTrackerTest, SingleDetectionTracking)
 {
   // This test simulates the detection of a moving object and tests that the tracker is able to identify it
   // according to the configuration provided
@@ -30,6 +39,7 @@ TEST(MultipleObjectTrackerTest, SingleDetectionTracking)
   trackerConfig.mNonMeasurementFramesStatic = 20;
   trackerConfig.mDefaultProcessNoise = 1e-4;
   trackerConfig.mDefaultMeasurementNoise = 1e-5;
+  trackerConfig.mUseSinglePrecision = GetParam();
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
 
   std::vector<rv::tracking::TrackedObject> trackedObjects;
@@ -81,7 +91,7 @@ TEST(MultipleObjectTrackerTest, SingleDetectionTracking)
   }
 }
 
-TEST(MultipleObjectTrackerTest, SingleDetectionSingleModelTracking)
+TEST_P(MultipleObjectTrackerTest, SingleDetectionSingleModelTracking)
 {
   // This test simulates the detection of a moving object and tests that the tracker is able to identify it
   // according to the configuration provided
@@ -104,6 +114,7 @@ TEST(MultipleObjectTrackerTest, SingleDetectionSingleModelTracking)
   trackerConfig.mDefaultProcessNoise = 1e-4;
   trackerConfig.mDefaultMeasurementNoise = 1e-5;
   trackerConfig.mMotionModels = std::vector<rv::tracking::MotionModel>{rv::tracking::MotionModel::CV};
+  trackerConfig.mUseSinglePrecision = GetParam();
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
 
   std::vector<rv::tracking::TrackedObject> trackedObjects;
@@ -157,7 +168,7 @@ TEST(MultipleObjectTrackerTest, SingleDetectionSingleModelTracking)
 
 
 
-TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingEuclideanDistance)
+TEST_P(MultipleObjectTrackerTest, MultipleDetectionTrackingEuclideanDistance)
 {
   auto classificationData = rv::tracking::ClassificationData({"Car", "Bike", "Pedestrian"});
 
@@ -201,6 +212,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingEuclideanDistance)
   trackerConfig.mMaxNumberOfUnreliableFrames = 5;
   trackerConfig.mNonMeasurementFramesDynamic = 7;
   trackerConfig.mNonMeasurementFramesStatic = 20;
+  trackerConfig.mUseSinglePrecision = GetParam();
 
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::Euclidean, 5.0);
 
@@ -257,7 +269,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingEuclideanDistance)
   }
 }
 
-TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMultiClassEuclideanDistance)
+TEST_P(MultipleObjectTrackerTest, MultipleDetectionTrackingMultiClassEuclideanDistance)
 {
   auto classificationData = rv::tracking::ClassificationData({"Car", "Bike", "Pedestrian"});
 
@@ -301,6 +313,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMultiClassEuclideanDist
   trackerConfig.mMaxNumberOfUnreliableFrames = 5;
   trackerConfig.mNonMeasurementFramesDynamic = 7;
   trackerConfig.mNonMeasurementFramesStatic = 20;
+  trackerConfig.mUseSinglePrecision = GetParam();
 
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::MultiClassEuclidean, 5.0);
 
@@ -357,7 +370,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMultiClassEuclideanDist
   }
 }
 
-TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMahalanobisDistance)
+TEST_P(MultipleObjectTrackerTest, MultipleDetectionTrackingMahalanobisDistance)
 {
   auto classificationData = rv::tracking::ClassificationData({"Car", "Bike", "Pedestrian"});
 
@@ -401,6 +414,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMahalanobisDistance)
   trackerConfig.mMaxNumberOfUnreliableFrames = 5;
   trackerConfig.mNonMeasurementFramesDynamic = 7;
   trackerConfig.mNonMeasurementFramesStatic = 20;
+  trackerConfig.mUseSinglePrecision = GetParam();
 
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::Mahalanobis, 5.0);
 
@@ -458,7 +472,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMahalanobisDistance)
 }
 
 
-TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMCEMahalanobisDistance)
+TEST_P(MultipleObjectTrackerTest, MultipleDetectionTrackingMCEMahalanobisDistance)
 {
   auto classificationData = rv::tracking::ClassificationData({"Car", "Bike", "Pedestrian"});
 
@@ -502,6 +516,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingMCEMahalanobisDistance)
   trackerConfig.mMaxNumberOfUnreliableFrames = 5;
   trackerConfig.mNonMeasurementFramesDynamic = 7;
   trackerConfig.mNonMeasurementFramesStatic = 20;
+  trackerConfig.mUseSinglePrecision = GetParam();
 
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::MCEMahalanobis, 5.0);
 
@@ -572,7 +587,7 @@ rv::tracking::TrackedObject createObjectAtLocation(double x, double y, const rv:
   return object;
 }
 
-TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingStressTest)
+TEST_P(MultipleObjectTrackerTest, MultipleDetectionTrackingStressTest)
 {
   auto classificationData = rv::tracking::ClassificationData({"1","2","3","4","5","6","7","8","9","10","11"});
 
@@ -580,6 +595,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingStressTest)
   trackerConfig.mMaxNumberOfUnreliableFrames = 5;
   trackerConfig.mNonMeasurementFramesDynamic = 7;
   trackerConfig.mNonMeasurementFramesStatic = 20;
+  trackerConfig.mUseSinglePrecision = GetParam();
 
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::MCEMahalanobis, 5.0);
 
@@ -629,7 +645,7 @@ TEST(MultipleObjectTrackerTest, MultipleDetectionTrackingStressTest)
   ASSERT_EQ(trackedObjects.size(), numberObjects);
 }
 
-TEST(MultipleObjectTrackerTest, SingleJumpingDetectionTracking)
+TEST_P(MultipleObjectTrackerTest, SingleJumpingDetectionTracking)
 {
   // This test simulates the detection of a moving object and tests that the tracker is able to identify it
   // according to the configuration provided
@@ -652,6 +668,7 @@ TEST(MultipleObjectTrackerTest, SingleJumpingDetectionTracking)
   trackerConfig.mNonMeasurementFramesStatic = 20;
   trackerConfig.mDefaultProcessNoise = 1e-4;
    trackerConfig.mDefaultMeasurementNoise = 1e-4;
+  trackerConfig.mUseSinglePrecision = GetParam();
   rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
 
   std::vector<rv::tracking::TrackedObject> trackedObjects;
@@ -700,3 +717,450 @@ TEST(MultipleObjectTrackerTest, SingleJumpingDetectionTracking)
     }
   }
 }
+
+TEST_P(MultipleObjectTrackerTest, LazyPredictionOfCoastingTracks)
+{
+  // A parked object stops being detected while a moving one far from it is still measured, only the moving one
+  // must be fully predicted every frame and both must follow the non lazy tracker
+  auto classificationData = rv::tracking::ClassificationData({"Car"});
+  auto movingObject = createObjectAtLocation(0.0, 0.0, classificationData, "Car");
+  auto parkedObject = createObjectAtLocation(50.0, 50.0, classificationData, "Car");
+
+  rv::tracking::TrackManagerConfig trackerConfig;
+  trackerConfig.mMaxNumberOfUnreliableFrames = 5;
+  trackerConfig.mNonMeasurementFramesDynamic = 7;
+  trackerConfig.mNonMeasurementFramesStatic = 40;
+  trackerConfig.mDefaultProcessNoise = 1e-4;
+  trackerConfig.mDefaultMeasurementNoise = 1e-5;
+  trackerConfig.mUseSinglePrecision = GetParam();
+  rv::tracking::MultipleObjectTracker referenceTracker(trackerConfig);
+
+  trackerConfig.mLazyPrediction = true;
+  trackerConfig.mLazyPredictionRefreshFrames = 5;
+  rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
+
+  double deltaT = 0.01;
+  size_t skippedFrames = 0;
+
+  for (uint32_t k = 0; k < 40; ++k)
+  {
+    auto const timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(10 * k));
+
+    movingObject.x += 2.0 * deltaT;
+    std::vector<rv::tracking::TrackedObject> detectedObjects{movingObject};
+    if (k < 10)
+    {
+      detectedObjects.push_back(parkedObject);
+    }
+
+    referenceTracker.track(detectedObjects, timestamp);
+    objectTracker.track(detectedObjects, timestamp);
+
+    if (k < 10)
+    {
+      EXPECT_EQ(objectTracker.getNumberOfSkippedPredictions(), 0u);
+    }
+    else
+    {
+      // the parked track only gets its full prediction every mLazyPredictionRefreshFrames frames
+      EXPECT_LE(objectTracker.getNumberOfSkippedPredictions(), 1u);
+      skippedFrames += objectTracker.getNumberOfSkippedPredictions();
+    }
+
+    // getReliableTracks() would complete the postponed predictions, the deferred states carry the extrapolated mean
+    auto referenceTracks = referenceTracker.getReliableTracks();
+    auto tracks = objectTracker.mTrackManager.getDeferredReliableTracks();
+    ASSERT_EQ(tracks.size(), referenceTracks.size());
+
+    auto byId = [](const rv::tracking::TrackedObject &a, const rv::tracking::TrackedObject &b) { return a.id < b.id; };
+    std::sort(tracks.begin(), tracks.end(), byId);
+    std::sort(referenceTracks.begin(), referenceTracks.end(), byId);
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+      EXPECT_NEAR(tracks[i].x, referenceTracks[i].x, 1e-3);
+      EXPECT_NEAR(tracks[i].y, referenceTracks[i].y, 1e-3);
+    }
+  }
+
+  EXPECT_EQ(skippedFrames, 24u);
+}
+
+TEST_P(MultipleObjectTrackerTest, LazyPredictionGatingAndRefresh)
+{
+  // The gating grid must find the tracks within the gating distance across cell borders, and the deferred tracks
+  // matched through their stale covariance must get their full prediction
+  auto classificationData = rv::tracking::ClassificationData({"Car"});
+
+  rv::tracking::TrackManagerConfig trackerConfig;
+  trackerConfig.mLazyPrediction = true;
+  trackerConfig.mLazyPredictionRefreshFrames = 5;
+  trackerConfig.mLazyPredictionGatingDistance = 5.0;
+  trackerConfig.mUseSinglePrecision = GetParam();
+  rv::tracking::TrackManager trackManager(trackerConfig, true);
+
+  auto const timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(0));
+  auto const nearId = trackManager.createTrack(createObjectAtLocation(0.0, 0.0, classificationData, "Car"), timestamp);
+  auto const otherCellId
+    = trackManager.createTrack(createObjectAtLocation(-9.9, 0.0, classificationData, "Car"), timestamp);
+  auto const farId = trackManager.createTrack(createObjectAtLocation(20.0, 0.0, classificationData, "Car"), timestamp);
+
+  trackManager.predict(0.1);
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(nearId).getPendingPredictionFrames(), 1u);
+
+  auto nanObject = createObjectAtLocation(std::nan(""), 0.0, classificationData, "Car");
+  trackManager.predictGatingCandidates(std::vector<rv::tracking::TrackedObject>{
+    createObjectAtLocation(-4.95, 0.0, classificationData, "Car"), nanObject});
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(nearId).getPendingPredictionFrames(), 0u);
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(otherCellId).getPendingPredictionFrames(), 0u);
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(farId).getPendingPredictionFrames(), 1u);
+
+  std::vector<rv::tracking::TrackedObject> tracks{trackManager.mKalmanEstimators.at(farId).currentState()};
+  auto const staleCovariance = tracks[0].predictedMeasurementCov;
+  EXPECT_TRUE(trackManager.completePredictions(tracks, {0}));
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(farId).getPendingPredictionFrames(), 0u);
+  EXPECT_GT((tracks[0].predictedMeasurementCov - staleCovariance).norm(), 0.);
+  EXPECT_FALSE(trackManager.completePredictions(tracks, {0}));
+
+  // the public accessors complete the postponed predictions of the tracks they return
+  trackManager.predict(0.1);
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(farId).getPendingPredictionFrames(), 1u);
+  EXPECT_EQ(trackManager.getDeferredUnreliableTracks().size(), 3u);
+  EXPECT_TRUE(trackManager.getReliableTracks().empty());
+  EXPECT_EQ(trackManager.mKalmanEstimators.at(farId).getPendingPredictionFrames(), 1u);
+  auto const unreliableTracks = trackManager.getUnreliableTracks();
+  ASSERT_EQ(unreliableTracks.size(), 3u);
+  for (auto const &element : trackManager.mKalmanEstimators)
+  {
+    EXPECT_EQ(element.second.getPendingPredictionFrames(), 0u);
+  }
+}
+
+TEST_P(MultipleObjectTrackerTest, MeasurementInputMatchesTrackedObjectInput)
+{
+  // The compact measurements must lead to the same tracks as the equivalent TrackedObject detections
+  auto classificationData = rv::tracking::ClassificationData({"Car", "Person"});
+  auto car = createObjectAtLocation(0.0, 0.0, classificationData, "Car");
+  auto person = createObjectAtLocation(5.0, 3.0, classificationData, "Person");
+  person.classification = classificationData.classification("Person", 0.4);
+
+  rv::tracking::TrackManagerConfig trackerConfig;
+  trackerConfig.mUseSinglePrecision = GetParam();
+  rv::tracking::MultipleObjectTracker referenceTracker(trackerConfig, rv::tracking::DistanceType::MultiClassEuclidean, 2.0);
+  rv::tracking::MultipleObjectTracker objectTracker(trackerConfig, rv::tracking::DistanceType::MultiClassEuclidean, 2.0);
+
+  double deltaT = 0.01;
+  for (uint32_t k = 0; k < 30; ++k)
+  {
+    auto const timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(10 * k));
+
+    car.x += 2.0 * deltaT;
+    person.y -= 1.0 * deltaT;
+    std::vector<rv::tracking::TrackedObject> detectedObjects{car, person};
+
+    std::vector<rv::tracking::Measurement> measurements;
+    for (auto const &object : detectedObjects)
+    {
+      measurements.push_back(rv::tracking::Measurement::fromTrackedObject(object));
+    }
+
+    referenceTracker.track(detectedObjects, timestamp);
+    objectTracker.track(measurements, timestamp);
+
+    auto referenceTracks = referenceTracker.getTracks();
+    auto tracks = objectTracker.getTracks();
+    ASSERT_EQ(tracks.size(), referenceTracks.size());
+
+    auto byId = [](const rv::tracking::TrackedObject &a, const rv::tracking::TrackedObject &b) { return a.id < b.id; };
+    std::sort(tracks.begin(), tracks.end(), byId);
+    std::sort(referenceTracks.begin(), referenceTracks.end(), byId);
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+      EXPECT_NEAR(tracks[i].x, referenceTracks[i].x, 1e-9);
+      EXPECT_NEAR(tracks[i].y, referenceTracks[i].y, 1e-9);
+      EXPECT_TRUE(tracks[i].classification.isApprox(referenceTracks[i].classification));
+    }
+  }
+
+  EXPECT_EQ(objectTracker.getReliableTracks().size(), 2u);
+}
+
+TEST_P(MultipleObjectTrackerTest, UserDataFollowsTheMeasurements)
+{
+  auto classificationData = rv::tracking::ClassificationData({"Car"});
+  auto car = rv::tracking::Measurement::fromTrackedObject(createObjectAtLocation(0.0, 0.0, classificationData, "Car"));
+
+  rv::tracking::TrackManagerConfig trackerConfig;
+  trackerConfig.mUseSinglePrecision = GetParam();
+  rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
+
+  for (uint32_t k = 0; k < 10; ++k)
+  {
+    auto const timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(10 * k));
+    car.x += 0.02;
+    car.userData = 1000u + k;
+
+    objectTracker.track(std::vector<rv::tracking::Measurement>{car}, timestamp);
+
+    auto tracks = objectTracker.getTracks();
+    ASSERT_EQ(tracks.size(), 1u);
+    EXPECT_EQ(tracks[0].userData, car.userData);
+    EXPECT_EQ(tracks[0].attributes, nullptr);
+    EXPECT_EQ(objectTracker.getMeasurementIndex(tracks[0].id), 0);
+  }
+
+  objectTracker.track(std::vector<rv::tracking::Measurement>{}, std::chrono::system_clock::time_point(std::chrono::milliseconds(100)));
+  EXPECT_EQ(objectTracker.getMeasurementIndex(objectTracker.getTracks()[0].id), -1);
+}
+
+TEST_P(MultipleObjectTrackerTest, AsyncTrackingMatchesSynchronousTracking)
+{
+  auto classificationData = rv::tracking::ClassificationData({"Car"});
+  auto car = rv::tracking::Measurement::fromTrackedObject(createObjectAtLocation(0.0, 0.0, classificationData, "Car"));
+  auto bike = rv::tracking::Measurement::fromTrackedObject(createObjectAtLocation(10.0, 5.0, classificationData, "Car"));
+
+  rv::tracking::TrackManagerConfig trackerConfig;
+  trackerConfig.mUseSinglePrecision = GetParam();
+  rv::tracking::MultipleObjectTracker referenceTracker(trackerConfig);
+  rv::tracking::MultipleObjectTracker objectTracker(trackerConfig);
+
+  std::vector<std::shared_future<void>> pending;
+  for (uint32_t k = 0; k < 20; ++k)
+  {
+    auto const timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(10 * k));
+    car.x += 0.02;
+    bike.y -= 0.01;
+    std::vector<rv::tracking::Measurement> measurements{car, bike};
+
+    referenceTracker.track(measurements, timestamp);
+    // the calls are queued without waiting, they must still be processed in order
+    pending.push_back(objectTracker.trackAsync(measurements, timestamp));
+  }
+
+  pending.back().wait();
+  for (auto &future : pending)
+  {
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_NO_THROW(future.get());
+  }
+
+  auto referenceTracks = referenceTracker.getTracks();
+  auto tracks = objectTracker.getTracks();
+  ASSERT_EQ(tracks.size(), referenceTracks.size());
+
+  auto byId = [](const rv::tracking::TrackedObject &a, const rv::tracking::TrackedObject &b) { return a.id < b.id; };
+  std::sort(tracks.begin(), tracks.end(), byId);
+  std::sort(referenceTracks.begin(), referenceTracks.end(), byId);
+  for (size_t i = 0; i < tracks.size(); ++i)
+  {
+    EXPECT_EQ(tracks[i].x, referenceTracks[i].x);
+    EXPECT_EQ(tracks[i].y, referenceTracks[i].y);
+  }
+  EXPECT_EQ(objectTracker.getTimestamp(), referenceTracker.getTimestamp());
+}
+
+TEST(MultipleObjectTrackerAsyncTest, ReportsErrorsAndReleasesCompletedSteps)
+{
+  rv::tracking::MultipleObjectTracker objectTracker;
+
+  // the first step owns a payload, it must be released once the following steps ran
+  auto payload = std::make_shared<int>(0);
+  std::weak_ptr<int> watcher = payload;
+  objectTracker.enqueueTracking([payload]() {});
+  payload.reset();
+
+  auto failed = objectTracker.enqueueTracking([]() { throw std::runtime_error("step failed"); });
+  std::vector<std::thread::id> workers(10);
+  std::shared_future<void> last;
+  for (size_t k = 0; k < workers.size(); ++k)
+  {
+    last = objectTracker.enqueueTracking([&workers, k]() { workers[k] = std::this_thread::get_id(); });
+  }
+
+  // the error is only reported by the future of the failed step
+  EXPECT_NO_THROW(objectTracker.waitForPendingTracking());
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  EXPECT_NO_THROW(last.get());
+
+  // all the steps run on the same worker thread
+  EXPECT_NE(workers.front(), std::this_thread::get_id());
+  EXPECT_EQ(std::count(workers.begin(), workers.end(), workers.front()), static_cast<long>(workers.size()));
+
+  EXPECT_TRUE(watcher.expired());
+  EXPECT_TRUE(objectTracker.getTracks().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Precision, MultipleObjectTrackerTest, ::testing::Values(false, true));
+
+TEST(ClassificationTest, FixedCapacity)
+{
+  auto classificationData = rv::tracking::ClassificationData({"Car", "Person", "Bicycle"});
+  auto car = classificationData.classification("Car", 0.8);
+  auto person = classificationData.classification("Person", 0.6);
+
+  // the probabilities are held inline, the results keep the runtime size
+  auto combined = rv::tracking::classification::combine(car, person);
+  EXPECT_EQ(combined.size(), 3);
+  EXPECT_EQ(static_cast<int>(rv::tracking::Classification::MaxRowsAtCompileTime), rv::tracking::MaxClassificationSize);
+  EXPECT_EQ(classificationData.getClass(combined), "Car");
+  EXPECT_NEAR(rv::tracking::classification::distance(car, car), 0.0, 1e-12);
+
+  std::vector<std::string> tooManyClasses(rv::tracking::MaxClassificationSize + 1, "class");
+  EXPECT_THROW(rv::tracking::ClassificationData{tooManyClasses}, std::runtime_error);
+}
+
+TEST(TrackedObjectTest, ContiguousStateAndValueCovariances)
+{
+  rv::tracking::TrackedObject object;
+  object.x = 1.0;
+  object.vy = 2.0;
+  object.height = 3.0;
+  object.w = 4.0;
+
+  // the named fields and the state vector share the same storage
+  auto const state = object.state();
+  EXPECT_EQ(state(0), 1.0);
+  EXPECT_EQ(state(3), 2.0);
+  EXPECT_EQ(state(9), 3.0);
+  EXPECT_EQ(state(11), 4.0);
+
+  cv::Mat stateVector = object.stateVector();
+  rv::tracking::TrackedObject other;
+  other.setStateVector(stateVector);
+  EXPECT_TRUE(other.state().isApprox(object.state()));
+
+  // copies do not share the covariances
+  other = object;
+  other.errorCovariance(0, 0) = 5.0;
+  other.predictedMeasurementMean(0) = 6.0;
+  EXPECT_NEAR(object.errorCovariance(0, 0), 1e-4, 1e-12);
+  EXPECT_EQ(object.predictedMeasurementMean(0), 0.0);
+
+  // but they share the attributes, which are never copied
+  object.attributes = std::make_shared<const rv::tracking::Attributes>(rv::tracking::Attributes{{"color", "red"}});
+  other = object;
+  EXPECT_EQ(other.attributes.get(), object.attributes.get());
+}
+
+TEST(MultiModelKalmanEstimatorTest, KalmanFilterCovarianceGetters)
+{
+  // The per model getters must return the state error covariance and the measurement covariance of that model
+  rv::tracking::TrackedObject object01;
+  object01.id = 1;
+  object01.width = 1.0;
+  object01.length = 2.0;
+  object01.height = 2.0;
+
+  auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(0));
+  rv::tracking::MultiModelKalmanEstimator estimator;
+  estimator.initialize(object01, timestamp);
+  object01.x += 0.1;
+  estimator.track(object01, timestamp + std::chrono::milliseconds(100));
+
+  for (std::size_t j = 0; j < estimator.mKalmanFilters.size(); ++j)
+  {
+    auto const &filter = estimator.mKalmanFilters[j];
+    cv::Mat errorCovariance = estimator.getKalmanFilterErrorCovariance(j);
+    cv::Mat measurementCovariance = estimator.getKalmanFilterMeasurementCovariance(j);
+
+    ASSERT_EQ(errorCovariance.rows, filter->getErrorCov().rows);
+    ASSERT_EQ(measurementCovariance.rows, filter->getMeasurementCov().rows);
+    EXPECT_NE(errorCovariance.rows, measurementCovariance.rows);
+    EXPECT_EQ(cv::norm(errorCovariance - filter->getErrorCov()), 0.);
+    EXPECT_EQ(cv::norm(measurementCovariance - filter->getMeasurementCov()), 0.);
+  }
+}
+
+TEST(MultiModelKalmanEstimatorTest, AdaptiveModelPruning)
+{
+  // A moving object makes the constant position model unlikely, it must be frozen and reinstated once the object
+  // stops abruptly
+  rv::tracking::TrackedObject object01;
+  object01.id = 1;
+  object01.width = 1.0;
+  object01.length = 2.0;
+  object01.height = 2.0;
+
+  double deltaT = 0.01;
+  auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(0));
+
+  rv::tracking::MultiModelKalmanEstimator estimator;
+  estimator.initialize(object01, timestamp, 1e-4, 1e-5, 1.,
+                       {rv::tracking::MotionModel::CV, rv::tracking::MotionModel::CP});
+  estimator.setModelPruning(true, 10u);
+
+  ASSERT_EQ(estimator.getNumberOfActiveModels(), 2);
+
+  // simulate a movement with velocity {2 m/s, 1.5 m/s}
+  for (int k = 1; k <= 200; ++k)
+  {
+    object01.x += 2.0 * deltaT;
+    object01.y += 1.5 * deltaT;
+    timestamp += std::chrono::milliseconds(10);
+    estimator.track(object01, timestamp);
+  }
+
+  auto events = estimator.popModelPruningEvents();
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].type, rv::tracking::ModelPruningEvent::Type::Pruned);
+  EXPECT_EQ(events[0].id, 1);
+  EXPECT_EQ(events[0].model, 1);
+  EXPECT_EQ(events[0].motionModel, rv::tracking::MotionModel::CP);
+  EXPECT_EQ(estimator.getNumberOfActiveModels(), 1);
+  EXPECT_TRUE(estimator.isModelActive(0));
+  EXPECT_FALSE(estimator.isModelActive(1));
+  EXPECT_EQ(estimator.getModelProbability().at<double>(1, 0), 0.);
+  EXPECT_NEAR(estimator.currentState().x, object01.x, 1e-2);
+
+  // the object stops
+  for (int k = 1; k <= 20; ++k)
+  {
+    timestamp += std::chrono::milliseconds(10);
+    estimator.track(object01, timestamp);
+  }
+
+  events = estimator.popModelPruningEvents();
+  ASSERT_GE(events.size(), 1);
+  EXPECT_EQ(events[0].type, rv::tracking::ModelPruningEvent::Type::Reactivated);
+  EXPECT_EQ(events[0].model, 1);
+  EXPECT_GT(events[0].innovationStatistic, 0.);
+  EXPECT_TRUE(estimator.popModelPruningEvents().empty());
+  EXPECT_NEAR(estimator.currentState().x, object01.x, 5e-2);
+}
+
+TEST(MultiModelKalmanEstimatorTest, SquareRootMatchesStandard)
+{
+  // The square-root estimator mixes and combines the cholesky factors of the model covariances, it must agree with the
+  // estimator that mixes the covariances up to rounding errors
+  rv::tracking::TrackedObject object01;
+  object01.id = 1;
+  object01.width = 1.0;
+  object01.length = 2.0;
+  object01.height = 2.0;
+
+  auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(0));
+  std::vector<rv::tracking::MotionModel> motionModels{
+    rv::tracking::MotionModel::CV, rv::tracking::MotionModel::CA, rv::tracking::MotionModel::CTRV};
+
+  rv::tracking::MultiModelKalmanEstimator standardEstimator;
+  rv::tracking::MultiModelKalmanEstimator squareRootEstimator;
+  standardEstimator.initialize(object01, timestamp, 1e-3, 1e-2, 1., motionModels, false);
+  squareRootEstimator.initialize(object01, timestamp, 1e-3, 1e-2, 1., motionModels, true);
+
+  // simulate a turning target
+  for (int k = 1; k <= 100; ++k)
+  {
+    double t = 0.05 * k;
+    object01.x = 5.0 * std::cos(0.2 * t);
+    object01.y = 5.0 * std::sin(0.2 * t);
+    timestamp += std::chrono::milliseconds(50);
+    standardEstimator.track(object01, timestamp);
+    squareRootEstimator.track(object01, timestamp);
+
+    EXPECT_NEAR(standardEstimator.currentState().x, squareRootEstimator.currentState().x, 1e-6);
+    EXPECT_NEAR(standardEstimator.currentState().y, squareRootEstimator.currentState().y, 1e-6);
+    EXPECT_LT((standardEstimator.currentState().errorCovariance - squareRootEstimator.currentState().errorCovariance)
+                .norm(),
+              1e-6);
+    EXPECT_LT(cv::norm(standardEstimator.getModelProbability() - squareRootEstimator.getModelProbability()), 1e-6);
+  }
+}
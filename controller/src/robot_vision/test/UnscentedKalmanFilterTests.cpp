@@ -0,0 +1,376 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <rv/tracking/CTRVModel.hpp>
+#include <rv/tracking/CVModel.hpp>
+#include <rv/tracking/UnscentedKalmanFilter.hpp>
+
+namespace {
+const int kStateSize = 12;
+const int kMeasurementSize = 7;
+
+cv::detail::tracking::UnscentedKalmanFilterParams createParams(const cv::Ptr<cv::detail::tracking::UkfSystemModel> &model,
+                                                               int type = CV_64F)
+{
+  cv::detail::tracking::UnscentedKalmanFilterParams params(kStateSize, kMeasurementSize, 1, 0, 0, model, type);
+  cv::Mat stateInit = cv::Mat::zeros(kStateSize, 1, CV_64F);
+  stateInit.at<double>(7, 0) = 2.0; // Length
+  stateInit.at<double>(8, 0) = 1.0; // Width
+  stateInit.at<double>(9, 0) = 2.0; // Height
+  stateInit.convertTo(params.stateInit, type);
+  params.errorCovInit = cv::Mat::eye(kStateSize, kStateSize, type) * 1.0;
+  params.measurementNoiseCov = cv::Mat::eye(kMeasurementSize, kMeasurementSize, type) * 1e-5;
+  params.processNoiseCov = cv::Mat::eye(kStateSize, kStateSize, type) * 1e-4;
+  params.alpha = 1.0;
+  params.beta = 2.0;
+  params.k = 0.0;
+  return params;
+}
+
+// Heap allocations made through operator new while gCountAllocations is set
+std::atomic<bool> gCountAllocations{false};
+std::atomic<size_t> gHeapAllocations{0};
+
+// Counts the cv::Mat buffer allocations, which go through the default MatAllocator and fastMalloc instead of operator
+// new, and forwards them to the standard allocator
+class CountingAllocator : public cv::MatAllocator
+{
+public:
+  cv::UMatData *allocate(int dims, const int *sizes, int type, void *data, size_t *step, cv::AccessFlag flags,
+                         cv::UMatUsageFlags usageFlags) const override
+  {
+    ++mCount;
+    return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+  }
+
+  bool allocate(cv::UMatData *data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override
+  {
+    return cv::Mat::getStdAllocator()->allocate(data, accessFlags, usageFlags);
+  }
+
+  void deallocate(cv::UMatData *data) const override
+  {
+    cv::Mat::getStdAllocator()->deallocate(data);
+  }
+
+  mutable std::atomic<size_t> mCount{0};
+};
+
+// Installs an allocator as the default one for the lifetime of the guard
+class ScopedDefaultAllocator
+{
+public:
+  explicit ScopedDefaultAllocator(cv::MatAllocator *allocator) : mPrevious(cv::Mat::getDefaultAllocator())
+  {
+    cv::Mat::setDefaultAllocator(allocator);
+  }
+
+  ~ScopedDefaultAllocator()
+  {
+    cv::Mat::setDefaultAllocator(mPrevious);
+  }
+
+private:
+  cv::MatAllocator *mPrevious;
+};
+
+// Counts every heap allocation, Mat buffers included, for the lifetime of the guard
+class ScopedAllocationCounter
+{
+public:
+  ScopedAllocationCounter() : mMatAllocations(&mAllocator)
+  {
+    gHeapAllocations = 0;
+    gCountAllocations = true;
+  }
+
+  ~ScopedAllocationCounter()
+  {
+    gCountAllocations = false;
+  }
+
+  size_t count() const
+  {
+    return gHeapAllocations + mAllocator.mCount;
+  }
+
+private:
+  CountingAllocator mAllocator;
+  ScopedDefaultAllocator mMatAllocations;
+};
+} // namespace
+
+// The replaced operators apply to the whole test binary, they only count while a ScopedAllocationCounter is alive
+void *operator new(std::size_t size)
+{
+  if (gCountAllocations.load(std::memory_order_relaxed))
+  {
+    ++gHeapAllocations;
+  }
+  if (void *pointer = std::malloc(size == 0 ? 1 : size))
+  {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+TEST(UnscentedKalmanFilterTest, SharedWorkspaceConvergence)
+{
+  // Two filters sharing the same sigma point workspace must track a constant velocity target independently
+  auto workspace = cv::makePtr<cv::detail::tracking::UkfWorkspace>();
+  auto cvFilter = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CVModel>()), workspace);
+  auto ctrvFilter = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CTRVModel>()), workspace);
+
+  double deltaT = 0.01;
+  cv::Mat control(1, 1, CV_64F, cv::Scalar(deltaT));
+  cv::Mat measurement = cv::Mat::zeros(kMeasurementSize, 1, CV_64F);
+  measurement.at<double>(3, 0) = 2.0;
+  measurement.at<double>(4, 0) = 1.0;
+  measurement.at<double>(5, 0) = 2.0;
+
+  ASSERT_TRUE(cvFilter->getMeasurementCov().empty());
+
+  for (int k = 1; k <= 200; ++k)
+  {
+    // simulate a movement with velocity {2 m/s, 1.5 m/s}
+    measurement.at<double>(0, 0) = 2.0 * deltaT * k;
+    measurement.at<double>(1, 0) = 1.5 * deltaT * k;
+
+    cvFilter->predictStep(control);
+    ctrvFilter->predictStep(control);
+    cvFilter->correctStep(measurement);
+    ctrvFilter->correctStep(measurement);
+  }
+
+  for (auto const &filter : {cvFilter, ctrvFilter})
+  {
+    const cv::Mat &state = filter->stateRef();
+    EXPECT_NEAR(state.at<double>(0, 0), 4.0, 1e-2);
+    EXPECT_NEAR(state.at<double>(1, 0), 3.0, 1e-2);
+    EXPECT_NEAR(state.at<double>(2, 0), 2.0, 5e-2);
+    EXPECT_NEAR(state.at<double>(3, 0), 1.5, 5e-2);
+    EXPECT_EQ(filter->getMeasurementCov().rows, kMeasurementSize);
+  }
+}
+
+TEST(UnscentedKalmanFilterTest, SteadyStateDoesNotAllocate)
+{
+  for (bool squareRoot : {false, true})
+  {
+    auto workspace = cv::makePtr<cv::detail::tracking::UkfWorkspace>();
+    auto cvFilter
+      = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CVModel>()), workspace, squareRoot);
+    auto ctrvFilter
+      = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CTRVModel>()), workspace, squareRoot);
+
+    cv::Mat control(1, 1, CV_64F, cv::Scalar(0.01));
+    cv::Mat measurement = cv::Mat::zeros(kMeasurementSize, 1, CV_64F);
+
+    // the first iteration sizes the buffers
+    cvFilter->predictStep(control);
+    ctrvFilter->predictStep(control);
+    cvFilter->correctStep(measurement);
+    ctrvFilter->correctStep(measurement);
+
+    size_t allocations = 0;
+    {
+      ScopedAllocationCounter counter;
+      for (int k = 1; k <= 50; ++k)
+      {
+        measurement.at<double>(0, 0) = 0.02 * k;
+        cvFilter->predictStep(control);
+        ctrvFilter->predictStep(control);
+        cvFilter->correctStep(measurement);
+        ctrvFilter->correctStep(measurement);
+      }
+      allocations = counter.count();
+    }
+
+    EXPECT_EQ(allocations, 0u) << "squareRoot: " << squareRoot;
+  }
+}
+
+TEST(UnscentedKalmanFilterTest, SquareRootMatchesStandard)
+{
+  // Both variants implement the same filter, they must agree up to rounding errors
+  auto params = createParams(cv::makePtr<rv::tracking::CTRVModel>());
+  auto standardFilter = createUnscentedKalmanFilterMod(params, cv::makePtr<cv::detail::tracking::UkfWorkspace>());
+  auto squareRootFilter
+    = createUnscentedKalmanFilterMod(params, cv::makePtr<cv::detail::tracking::UkfWorkspace>(), true);
+
+  ASSERT_FALSE(standardFilter->isSquareRoot());
+  ASSERT_TRUE(squareRootFilter->isSquareRoot());
+
+  double deltaT = 0.05;
+  cv::Mat control(1, 1, CV_64F, cv::Scalar(deltaT));
+  cv::Mat measurement = cv::Mat::zeros(kMeasurementSize, 1, CV_64F);
+  measurement.at<double>(3, 0) = 2.0;
+  measurement.at<double>(4, 0) = 1.0;
+  measurement.at<double>(5, 0) = 2.0;
+
+  for (int k = 1; k <= 100; ++k)
+  {
+    // simulate a turning target
+    double t = deltaT * k;
+    measurement.at<double>(0, 0) = 5.0 * std::cos(0.2 * t);
+    measurement.at<double>(1, 0) = 5.0 * std::sin(0.2 * t);
+    measurement.at<double>(6, 0) = 0.2 * t;
+
+    standardFilter->predictStep(control);
+    squareRootFilter->predictStep(control);
+
+    EXPECT_LT(cv::norm(standardFilter->errorCovRef() - squareRootFilter->errorCovRef()), 1e-6);
+    EXPECT_LT(cv::norm(standardFilter->measurementCovRef() - squareRootFilter->measurementCovRef()), 1e-6);
+
+    standardFilter->correctStep(measurement);
+    squareRootFilter->correctStep(measurement);
+
+    EXPECT_LT(cv::norm(standardFilter->stateRef() - squareRootFilter->stateRef()), 1e-6);
+    EXPECT_LT(cv::norm(standardFilter->errorCovRef() - squareRootFilter->errorCovRef()), 1e-6);
+  }
+}
+
+TEST(UnscentedKalmanFilterTest, SetStateAndCovarianceReachesTheFilter)
+{
+  // The IMM mixing overwrites the state and covariance of every model filter before its prediction
+  for (bool squareRoot : {false, true})
+  {
+    auto params = createParams(cv::makePtr<rv::tracking::CTRVModel>());
+    auto filter = createUnscentedKalmanFilterMod(params, cv::makePtr<cv::detail::tracking::UkfWorkspace>(), squareRoot);
+
+    cv::Mat state = params.stateInit.clone();
+    state.at<double>(0, 0) = 1.0;
+    state.at<double>(1, 0) = -2.0;
+    state.at<double>(2, 0) = 0.5;
+    cv::Mat errorCov = cv::Mat::eye(kStateSize, kStateSize, CV_64F) * 0.25;
+    errorCov.at<double>(0, 1) = errorCov.at<double>(1, 0) = 0.1;
+
+    filter->setStateAndCovariance(state, errorCov);
+    EXPECT_EQ(cv::norm(filter->stateRef() - state), 0.) << "squareRoot: " << squareRoot;
+    EXPECT_EQ(cv::norm(filter->errorCovRef() - errorCov), 0.) << "squareRoot: " << squareRoot;
+
+    // the prediction starts from the new state and covariance, the cholesky factor included
+    params.stateInit = state;
+    params.errorCovInit = errorCov;
+    auto reference
+      = createUnscentedKalmanFilterMod(params, cv::makePtr<cv::detail::tracking::UkfWorkspace>(), squareRoot);
+
+    cv::Mat control(1, 1, CV_64F, cv::Scalar(0.05));
+    filter->predictStep(control);
+    reference->predictStep(control);
+    EXPECT_LT(cv::norm(filter->stateRef() - reference->stateRef()), 1e-9) << "squareRoot: " << squareRoot;
+    EXPECT_LT(cv::norm(filter->errorCovRef() - reference->errorCovRef()), 1e-9) << "squareRoot: " << squareRoot;
+  }
+}
+
+TEST(UnscentedKalmanFilterTest, MixCovarianceFactorsMatchesTheMixture)
+{
+  // The square-root IMM mixes the cholesky factors of the model covariances without forming them
+  std::vector<cv::Mat> states;
+  std::vector<cv::Mat> factors;
+  std::vector<double> weights{0.7, 0.2, 0.1};
+  for (int i = 0; i < 3; ++i)
+  {
+    cv::Mat state(kStateSize, 1, CV_64F);
+    cv::Mat factor = cv::Mat::zeros(kStateSize, kStateSize, CV_64F);
+    for (int r = 0; r < kStateSize; ++r)
+    {
+      state.at<double>(r, 0) = std::sin(1.0 + r + 3.0 * i);
+      for (int c = 0; c <= r; ++c)
+      {
+        factor.at<double>(r, c) = r == c ? 0.5 + 0.1 * i : 0.05 * std::cos(r * c + i);
+      }
+    }
+    states.push_back(state);
+    factors.push_back(factor);
+  }
+
+  cv::Mat mixedState = cv::Mat::zeros(kStateSize, 1, CV_64F);
+  for (int i = 0; i < 3; ++i)
+  {
+    mixedState += weights[i] * states[i];
+  }
+  cv::Mat mixture = cv::Mat::zeros(kStateSize, kStateSize, CV_64F);
+  for (int i = 0; i < 3; ++i)
+  {
+    mixture += weights[i] * (factors[i] * factors[i].t() + (states[i] - mixedState) * (states[i] - mixedState).t());
+  }
+
+  cv::Mat mixedFactor;
+  cv::detail::tracking::mixCovarianceFactors(states, factors, weights, mixedState, mixedFactor);
+  EXPECT_LT(cv::norm(mixedFactor * mixedFactor.t() - mixture), 1e-12);
+  for (int r = 0; r < kStateSize; ++r)
+  {
+    EXPECT_GE(mixedFactor.at<double>(r, r), 0.);
+    for (int c = r + 1; c < kStateSize; ++c)
+    {
+      EXPECT_EQ(mixedFactor.at<double>(r, c), 0.);
+    }
+  }
+
+  cv::Mat combinedCovariance;
+  cv::detail::tracking::combineCovarianceFactors(states, factors, weights, mixedState, combinedCovariance);
+  EXPECT_LT(cv::norm(combinedCovariance - mixture), 1e-12);
+
+  // the covariance of a filter set through its factor is formed when it is requested
+  auto filter = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CTRVModel>()),
+                                               cv::makePtr<cv::detail::tracking::UkfWorkspace>(), true);
+  filter->setStateAndCovarianceFactor(mixedState, mixedFactor);
+  EXPECT_EQ(cv::norm(filter->errorCovFactorRef() - mixedFactor), 0.);
+  EXPECT_LT(cv::norm(filter->errorCovRef() - mixture), 1e-12);
+}
+
+TEST(UnscentedKalmanFilterTest, SinglePrecisionMatchesDouble)
+{
+  for (bool squareRoot : {false, true})
+  {
+    auto doubleFilter = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CTRVModel>()),
+                                                       cv::makePtr<cv::detail::tracking::UkfWorkspace>(), squareRoot);
+    auto floatFilter = createUnscentedKalmanFilterMod(createParams(cv::makePtr<rv::tracking::CTRVModel>(), CV_32F),
+                                                      cv::makePtr<cv::detail::tracking::UkfWorkspace>(), squareRoot);
+
+    double deltaT = 0.05;
+    cv::Mat control(1, 1, CV_64F, cv::Scalar(deltaT));
+    cv::Mat floatControl(1, 1, CV_32F, cv::Scalar(deltaT));
+    cv::Mat measurement = cv::Mat::zeros(kMeasurementSize, 1, CV_64F);
+    cv::Mat floatMeasurement;
+    measurement.at<double>(3, 0) = 2.0;
+    measurement.at<double>(4, 0) = 1.0;
+    measurement.at<double>(5, 0) = 2.0;
+
+    for (int k = 1; k <= 100; ++k)
+    {
+      // simulate a turning target a hundred meters away from the origin
+      double t = deltaT * k;
+      measurement.at<double>(0, 0) = 100.0 + 5.0 * std::cos(0.2 * t);
+      measurement.at<double>(1, 0) = 100.0 + 5.0 * std::sin(0.2 * t);
+      measurement.at<double>(6, 0) = 0.2 * t;
+      measurement.convertTo(floatMeasurement, CV_32F);
+
+      doubleFilter->predictStep(control);
+      floatFilter->predictStep(floatControl);
+      doubleFilter->correctStep(measurement);
+      floatFilter->correctStep(floatMeasurement);
+    }
+
+    cv::Mat floatState;
+    floatFilter->stateRef().convertTo(floatState, CV_64F);
+    ASSERT_EQ(floatFilter->stateRef().type(), CV_32F);
+    EXPECT_LT(cv::norm(doubleFilter->stateRef() - floatState), 1e-2) << "squareRoot: " << squareRoot;
+  }
+}
@@ -0,0 +1,404 @@
+//# SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+//# SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <pybind11/embed.h>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dbscan.h"
+#include "extruded_polygon.h"
+#include "geodesy.h"
+#include "line.h"
+#include "point.h"
+#include "point_array.h"
+#include "polygon.h"
+#include "rectangle.h"
+#include "region_index.h"
+#include "segment_crossings.h"
+
+namespace py = pybind11;
+
+namespace fast_geometry {
+namespace benchmark {
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> DoubleArray;
+
+/**
+ * @brief Deterministic inputs shared by the benchmarks, the same seed gives the same data on every build
+ */
+class GeometryData {
+public:
+    explicit GeometryData(unsigned int seed = 42) : gen(seed) {}
+
+    double uniform(double low, double high) {
+        return std::uniform_real_distribution<double>(low, high)(gen);
+    }
+
+    std::vector<double> coordinates(size_t count, size_t columns, double low, double high) {
+        std::vector<double> values(count * columns);
+        for (double& value : values) {
+            value = uniform(low, high);
+        }
+        return values;
+    }
+
+    std::vector<Point> points3D(size_t count, double low, double high) {
+        std::vector<Point> points;
+        points.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            points.emplace_back(uniform(low, high), uniform(low, high), uniform(low, high));
+        }
+        return points;
+    }
+
+    /**
+     * @brief Star shaped (possibly concave) polygon with the given number of vertices around the origin
+     */
+    std::vector<std::pair<double, double>> polygon(size_t vertices, double radius = 10.0,
+                                                   double cx = 0.0, double cy = 0.0) {
+        std::vector<std::pair<double, double>> result;
+        result.reserve(vertices);
+        for (size_t i = 0; i < vertices; i++) {
+            double angle = 2 * M_PI * static_cast<double>(i) / static_cast<double>(vertices);
+            double r = radius * uniform(0.5, 1.0);
+            result.emplace_back(cx + r * std::cos(angle), cy + r * std::sin(angle));
+        }
+        return result;
+    }
+
+private:
+    std::mt19937 gen;
+};
+
+static DoubleArray makeArray(const std::vector<double>& values, size_t columns) {
+    return DoubleArray(std::vector<py::ssize_t>{static_cast<py::ssize_t>(values.size() / columns),
+                                                static_cast<py::ssize_t>(columns)},
+                       values.data());
+}
+
+//---------------------------------------------------------------------------
+// Point, mirrors tests/perf_tests/tc_geometry_point.py
+//---------------------------------------------------------------------------
+
+static void BM_PointAsPolar(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Point> points = data.points3D(state.range(0), -100.0, 100.0);
+    for (auto _ : state) {
+        for (const Point& p : points) {
+            ::benchmark::DoNotOptimize(p.asPolar());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointAsPolar)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_PointAsCartesianFromPolar(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Point> points;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        points.emplace_back(data.uniform(0.1, 10.1), data.uniform(0.0, 360.0), data.uniform(0.0, 360.0), true);
+    }
+    for (auto _ : state) {
+        for (const Point& p : points) {
+            ::benchmark::DoNotOptimize(p.asCartesian());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointAsCartesianFromPolar)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_PointDistance(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Point> points = data.points3D(state.range(0), -100.0, 100.0);
+    Point origin(1.0, 2.0, 3.0);
+    for (auto _ : state) {
+        for (const Point& p : points) {
+            ::benchmark::DoNotOptimize(p.distance(origin));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointDistance)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_PointArrayDistance(::benchmark::State& state) {
+    GeometryData data;
+    PointArray points(makeArray(data.coordinates(state.range(0), 3, -100.0, 100.0), 3));
+    Point origin(1.0, 2.0, 3.0);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(points.distance(origin));
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointArrayDistance)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_PointArrayAsPolar(::benchmark::State& state) {
+    GeometryData data;
+    PointArray points(makeArray(data.coordinates(state.range(0), 3, -100.0, 100.0), 3));
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(points.asPolar());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointArrayAsPolar)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_PointArrayTransform(::benchmark::State& state) {
+    GeometryData data;
+    PointArray points(makeArray(data.coordinates(state.range(0), 3, -100.0, 100.0), 3));
+    DoubleArray matrix = makeArray({0, -1, 0, 1, 1, 0, 0, 2, 0, 0, 1, 3, 0, 0, 0, 1}, 4);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(points.transform(matrix));
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_PointArrayTransform)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+//---------------------------------------------------------------------------
+// Line, mirrors tests/perf_tests/tc_geometry_line.py
+//---------------------------------------------------------------------------
+
+static void BM_LineIntersection(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Line> lines;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        lines.emplace_back(data.uniform(-50, 50), data.uniform(-50, 50), data.uniform(-50, 50), data.uniform(-50, 50));
+    }
+    Line other(-50.0, -40.0, 50.0, 45.0);
+    for (auto _ : state) {
+        for (const Line& line : lines) {
+            ::benchmark::DoNotOptimize(line.intersection(other));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_LineIntersection)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_LineIsPointOnLine(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Point> points;
+    Line line(Point(-50.0, -50.0), Point(50.0, 50.0));
+    for (int64_t i = 0; i < state.range(0); i++) {
+        // half of the points lie on the line
+        double t = data.uniform(-60, 60);
+        points.emplace_back(t, (i % 2) ? t : t + data.uniform(-1, 1));
+    }
+    for (auto _ : state) {
+        for (const Point& p : points) {
+            ::benchmark::DoNotOptimize(line.isPointOnLine(p));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_LineIsPointOnLine)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+static void BM_SegmentCrossings(::benchmark::State& state) {
+    GeometryData data;
+    size_t motions = state.range(0);
+    size_t tripwires = state.range(1);
+    std::vector<double> motion(4 * motions);
+    for (size_t i = 0; i < motions; i++) {
+        double x = data.uniform(0, 100);
+        double y = data.uniform(0, 100);
+        motion[4 * i] = x;
+        motion[4 * i + 1] = y;
+        motion[4 * i + 2] = x + data.uniform(-2, 2);
+        motion[4 * i + 3] = y + data.uniform(-2, 2);
+    }
+    DoubleArray segments = makeArray(motion, 4);
+    std::vector<double> wire(4 * tripwires);
+    for (size_t i = 0; i < tripwires; i++) {
+        double x = data.uniform(0, 100);
+        double y = data.uniform(0, 100);
+        wire[4 * i] = x;
+        wire[4 * i + 1] = y;
+        wire[4 * i + 2] = x + data.uniform(-10, 10);
+        wire[4 * i + 3] = y + data.uniform(-10, 10);
+    }
+    DoubleArray wires = makeArray(wire, 4);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(segmentCrossings(segments, wires));
+    }
+    state.SetItemsProcessed(state.iterations() * motions);
+}
+BENCHMARK(BM_SegmentCrossings)->ArgsProduct({{1 << 8, 1 << 12}, {4, 64, 512}});
+
+//---------------------------------------------------------------------------
+// Rectangle
+//---------------------------------------------------------------------------
+
+static void BM_RectangleIntersection(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<Rectangle> rectangles;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        double x = data.uniform(-50, 50);
+        double y = data.uniform(-50, 50);
+        rectangles.emplace_back(Point(x, y), Point(x + data.uniform(1, 20), y + data.uniform(1, 20)));
+    }
+    Rectangle other(Point(-10.0, -10.0), Point(15.0, 20.0));
+    for (auto _ : state) {
+        for (Rectangle& rectangle : rectangles) {
+            ::benchmark::DoNotOptimize(rectangle.intersection(other));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * rectangles.size());
+}
+BENCHMARK(BM_RectangleIntersection)->RangeMultiplier(8)->Range(1 << 8, 1 << 14);
+
+//---------------------------------------------------------------------------
+// Polygon and regions, arguments are (vertices, points)
+//---------------------------------------------------------------------------
+
+static void BM_PolygonIsPointInside(::benchmark::State& state) {
+    GeometryData data;
+    Polygon polygon(data.polygon(state.range(0)));
+    std::vector<double> points = data.coordinates(state.range(1), 2, -12.0, 12.0);
+    for (auto _ : state) {
+        for (size_t k = 0; k < points.size(); k += 2) {
+            ::benchmark::DoNotOptimize(polygon.isPointInside(points[k], points[k + 1]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_PolygonIsPointInside)->ArgsProduct({{4, 16, 64, 256}, {1 << 10, 1 << 14}});
+
+static void BM_PolygonIsPointInsideBatch(::benchmark::State& state) {
+    GeometryData data;
+    Polygon polygon(data.polygon(state.range(0)));
+    DoubleArray points = makeArray(data.coordinates(state.range(1), 2, -12.0, 12.0), 2);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(polygon.isPointInsideBatch(points));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_PolygonIsPointInsideBatch)->ArgsProduct({{4, 16, 64, 256}, {1 << 10, 1 << 14}});
+
+// Arguments are (regions, points), the regions are 8-vertex polygons spread over a 1km square
+static void BM_RegionIndexQueryBatch(::benchmark::State& state) {
+    GeometryData data;
+    RegionIndex index;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        index.addPolygon("region" + std::to_string(i),
+                         data.polygon(8, data.uniform(5, 30), data.uniform(0, 1000), data.uniform(0, 1000)));
+    }
+    DoubleArray points = makeArray(data.coordinates(state.range(1), 2, 0.0, 1000.0), 2);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(index.queryBatch(points));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_RegionIndexQueryBatch)->ArgsProduct({{16, 256, 4096}, {1 << 10, 1 << 14}});
+
+static std::vector<double> boxes(GeometryData& data, size_t count) {
+    std::vector<double> values(10 * count);
+    for (size_t i = 0; i < count; i++) {
+        double yaw = data.uniform(0, 2 * M_PI);
+        double* box = values.data() + 10 * i;
+        box[0] = data.uniform(-12, 12);
+        box[1] = data.uniform(-12, 12);
+        box[2] = 0.0;
+        box[3] = data.uniform(0.3, 2.0);
+        box[4] = data.uniform(0.3, 2.0);
+        box[5] = data.uniform(1.0, 2.0);
+        box[6] = 0.0;
+        box[7] = 0.0;
+        box[8] = std::sin(yaw / 2);
+        box[9] = std::cos(yaw / 2);
+    }
+    return values;
+}
+
+// Arguments are (vertices, boxes)
+static void BM_ExtrudedPolygonIntersectsBoxes(::benchmark::State& state) {
+    GeometryData data;
+    ExtrudedPolygon prism(data.polygon(state.range(0)), 2.0);
+    DoubleArray objects = makeArray(boxes(data, state.range(1)), 10);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(prism.intersectsBoxes(objects));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ExtrudedPolygonIntersectsBoxes)->ArgsProduct({{4, 16, 64}, {1 << 6, 1 << 10}});
+
+//---------------------------------------------------------------------------
+// Geodesy
+//---------------------------------------------------------------------------
+
+static void BM_GeodeticToLLAWithHeadings(::benchmark::State& state) {
+    GeometryData data;
+    // local frame 1m per unit, anchored on the equator
+    GeodeticTransform transform(makeArray({0, 0, 1, 6378137.0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1}, 4));
+    DoubleArray points = makeArray(data.coordinates(state.range(0), 3, -500.0, 500.0), 3);
+    DoubleArray velocities = makeArray(data.coordinates(state.range(0), 3, -2.0, 2.0), 3);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(transform.toLLAWithHeadings(points, velocities));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GeodeticToLLAWithHeadings)->RangeMultiplier(8)->Range(1 << 6, 1 << 12);
+
+//---------------------------------------------------------------------------
+// Clustering, mirrors ClusterAnalyticsContext.analyzeObjectClusters
+//---------------------------------------------------------------------------
+
+// Objects spread over a square with about one object per 4 square meters
+static std::vector<double> crowd(GeometryData& data, size_t count) {
+    double side = 2.0 * std::sqrt(static_cast<double>(count));
+    return data.coordinates(count, 2, 0.0, side);
+}
+
+static void BM_DbscanFit(::benchmark::State& state) {
+    GeometryData data;
+    DoubleArray points = makeArray(crowd(data, state.range(0)), 2);
+    Dbscan dbscan(2.0, 2);
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(dbscan.fit(points));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DbscanFit)->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
+
+// Frames jitter around the same positions, the neighbors of the first fit are reused
+static void BM_DbscanFitIncremental(::benchmark::State& state) {
+    GeometryData data;
+    std::vector<double> base = crowd(data, state.range(0));
+    std::vector<std::string> ids;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        ids.push_back("object" + std::to_string(i));
+    }
+    std::vector<DoubleArray> frames;
+    for (int f = 0; f < 16; f++) {
+        std::vector<double> frame = base;
+        for (double& value : frame) {
+            value += data.uniform(-0.2, 0.2);
+        }
+        frames.push_back(makeArray(frame, 2));
+    }
+    Dbscan dbscan(2.0, 2);
+    dbscan.fit(makeArray(base, 2), ids);
+    size_t frame = 0;
+    for (auto _ : state) {
+        ::benchmark::DoNotOptimize(dbscan.fit(frames[frame++ % frames.size()], ids));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DbscanFitIncremental)->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
+
+} // namespace benchmark
+} // namespace fast_geometry
+
+// The batch APIs exchange numpy arrays, they need an interpreter with numpy loaded
+int main(int argc, char** argv) {
+    py::scoped_interpreter interpreter;
+    py::module_::import("numpy");
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
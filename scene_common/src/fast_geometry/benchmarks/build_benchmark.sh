@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+# Build benchmarks from scratch
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD_DIR="${SCRIPT_DIR}/build"
+
+echo "Cleaning build directory..."
+rm -rf "${BUILD_DIR}"
+
+echo "Configuring project..."
+cmake -S "${SCRIPT_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release
+
+echo "Building benchmarks..."
+cmake --build "${BUILD_DIR}" --target FastGeometryBenchmarks -- -j$(nproc)
+
+echo "Build completed successfully!"
+echo "Benchmark executable: ${BUILD_DIR}/FastGeometryBenchmarks"
@@ -2,9 +2,15 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "point.h"
+#include "point_array.h"
 #include "line.h"
 #include "rectangle.h"
 #include "polygon.h"
+#include "region_index.h"
+#include "segment_crossings.h"
+#include "extruded_polygon.h"
+#include "geodesy.h"
+#include "dbscan.h"
 
 
 namespace py = pybind11;
@@ -84,6 +90,36 @@ PYBIND11_MODULE( LIBRARY_NAME, m) {
         .def_property_readonly("log", &Point::log)
         .def("__repr__", &Point::repr);
 
+    py::class_<PointArray>(m, "PointArray", py::buffer_protocol())
+        .def(py::init<size_t, bool, bool>(),
+            py::arg("count") = 0, py::arg("is3D") = true, py::arg("polar") = false)
+        .def(py::init<const py::array_t<double, py::array::c_style | py::array::forcecast>&, bool>(),
+            py::arg("data"), py::arg("polar") = false)
+        .def_static("fromPoints", &PointArray::fromPoints, py::arg("points"))
+        .def_static("fromPoints2Dxy", &PointArray::fromPoints2Dxy, py::arg("points"))
+        .def_buffer([](PointArray& a) -> py::buffer_info {
+            return py::buffer_info(
+                a.data(), sizeof(double), py::format_descriptor<double>::format(), 2,
+                { a.size(), size_t(3) }, { 3 * sizeof(double), sizeof(double) });
+        })
+        .def_property_readonly("is3D", &PointArray::is3D)
+        .def_property_readonly("polar", &PointArray::polar)
+        .def("__len__", &PointArray::size)
+        // a writable numpy view of the row, it keeps the array alive
+        .def("__getitem__", [](py::object self, size_t i) {
+            return py::array_t<double>({ size_t(3) }, { sizeof(double) }, self.cast<PointArray&>().row(i), self);
+        })
+        .def("__setitem__", &PointArray::set)
+        .def("point", &PointArray::at, py::arg("i"))
+        .def_property_readonly("points", &PointArray::asPoints)
+        .def("distance", py::overload_cast<const PointArray&>(&PointArray::distance, py::const_))
+        .def("distance", py::overload_cast<const Point&>(&PointArray::distance, py::const_))
+        .def("midpoint", &PointArray::midpoint)
+        .def("transform", &PointArray::transform, py::arg("matrix"))
+        .def_property_readonly("asCartesian", &PointArray::asCartesian)
+        .def_property_readonly("asPolar", &PointArray::asPolar)
+        .def_property_readonly("as2Dxy", &PointArray::as2Dxy);
+
     py::class_<Line>(m, "Line")
         .def(py::init<double, double, double, double>())
         .def(py::init<Point &, Point &, bool>(),
@@ -158,6 +194,63 @@ PYBIND11_MODULE( LIBRARY_NAME, m) {
     py::class_<Polygon>(m, "Polygon")
         .def(py::init<const std::vector<std::pair<double, double>>&>())
         .def("getVertices", &Polygon::getVertices)
-        .def("isPointInside", &Polygon::isPointInside);
+        .def("isPointInside", &Polygon::isPointInside)
+        .def("isPointInsideBatch", &Polygon::isPointInsideBatch, py::arg("points"))
+        .def_property_readonly("boundingBox", &Polygon::getBoundingBox);
+
+    py::class_<RegionIndex>(m, "RegionIndex")
+        .def(py::init<double>(), py::arg("cell_size") = 0.0)
+        .def("addPolygon", &RegionIndex::addPolygon, py::arg("id"), py::arg("vertices"))
+        .def("addCircle", &RegionIndex::addCircle,
+            py::arg("id"), py::arg("cx"), py::arg("cy"), py::arg("radius"))
+        .def("addRectangle", &RegionIndex::addRectangle,
+            py::arg("id"), py::arg("x1"), py::arg("y1"), py::arg("x2"), py::arg("y2"))
+        .def("addUnbounded", &RegionIndex::addUnbounded, py::arg("id"))
+        .def("remove", &RegionIndex::remove, py::arg("id"))
+        .def("clear", &RegionIndex::clear)
+        .def("rebuild", &RegionIndex::rebuild)
+        .def("__contains__", &RegionIndex::contains)
+        .def("__len__", &RegionIndex::size)
+        .def_property_readonly("cellSize", &RegionIndex::getCellSize)
+        .def_property_readonly("ids", &RegionIndex::getIds)
+        .def("query", &RegionIndex::query, py::arg("x"), py::arg("y"))
+        .def("queryBatch", &RegionIndex::queryBatch, py::arg("points"));
+
+    py::class_<ExtrudedPolygon>(m, "ExtrudedPolygon")
+        .def(py::init<const std::vector<std::pair<double, double>>&, double, double>(),
+            py::arg("vertices"), py::arg("height"), py::arg("z_min") = 0.0)
+        .def("getVertices", &ExtrudedPolygon::getVertices)
+        .def_property_readonly("height", &ExtrudedPolygon::getHeight)
+        .def_property_readonly("zMin", &ExtrudedPolygon::getZMin)
+        .def_property_readonly("isConvex", &ExtrudedPolygon::isConvex)
+        .def("intersectsBox", &ExtrudedPolygon::intersectsBox,
+            py::arg("x"), py::arg("y"), py::arg("z"),
+            py::arg("size_x"), py::arg("size_y"), py::arg("size_z"),
+            py::arg("qx") = 0.0, py::arg("qy") = 0.0, py::arg("qz") = 0.0, py::arg("qw") = 1.0)
+        .def("intersectsBoxes", &ExtrudedPolygon::intersectsBoxes, py::arg("boxes"));
+
+    m.def("segmentCrossings", &segmentCrossings,
+        py::arg("segments"), py::arg("tripwires"), py::arg("cell_size") = 0.0);
+
+    m.def("llaToECEF", &llaToECEF, py::arg("lla"));
+
+    py::class_<GeodeticTransform>(m, "GeodeticTransform")
+        .def(py::init<const py::array_t<double, py::array::c_style | py::array::forcecast>&>(),
+            py::arg("trs_matrix"))
+        .def_property_readonly("matrix", &GeodeticTransform::getMatrix)
+        .def("toLLA", &GeodeticTransform::toLLA, py::arg("points"))
+        .def("fromLLA", &GeodeticTransform::fromLLA, py::arg("lla"))
+        .def("headings", &GeodeticTransform::headings, py::arg("points"), py::arg("velocities"))
+        .def("toLLAWithHeadings", &GeodeticTransform::toLLAWithHeadings,
+            py::arg("points"), py::arg("velocities"));
+
+    py::class_<Dbscan>(m, "Dbscan")
+        .def(py::init<double, int>(), py::arg("eps"), py::arg("min_samples"))
+        .def("setParams", &Dbscan::setParams, py::arg("eps"), py::arg("min_samples"))
+        .def("reset", &Dbscan::reset)
+        .def_property_readonly("eps", &Dbscan::getEps)
+        .def_property_readonly("minSamples", &Dbscan::getMinSamples)
+        .def_property_readonly("reusedNeighbors", &Dbscan::reusedNeighbors)
+        .def("fit", &Dbscan::fit, py::arg("points"), py::arg("ids") = std::vector<std::string>());
 
 }
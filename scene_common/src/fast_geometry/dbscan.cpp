@@ -0,0 +1,336 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "dbscan.h"
+
+// Cell coordinates are clamped so that two of them pack into one 64 bit key
+#define DBSCAN_MAX_CELL (1 << 30)
+// Relative margin on the neighbor list radius, so rounding never drops a pair at exactly eps
+#define DBSCAN_SKIN_MARGIN 1e-9
+
+static int64_t cellIndex(double v, double cell_size)
+{
+    double cell = std::floor(v / cell_size);
+    cell = std::min(std::max(cell, -double(DBSCAN_MAX_CELL)), double(DBSCAN_MAX_CELL));
+    return static_cast<int64_t>(cell);
+}
+static int64_t cellKey(int64_t cx, int64_t cy)
+{
+    return static_cast<int64_t>((static_cast<uint64_t>(cx) << 32) ^ (static_cast<uint64_t>(cy) & 0xffffffffu));
+}
+static double distanceSquared(const std::vector<double>& xy, size_t a, size_t b)
+{
+    double dx = xy[2 * a] - xy[2 * b];
+    double dy = xy[2 * a + 1] - xy[2 * b + 1];
+    return dx * dx + dy * dy;
+}
+
+static void checkParams(double eps, int min_samples)
+{
+    if (!std::isfinite(eps) || eps <= 0.0)
+    {
+        throw std::invalid_argument("eps must be a positive number");
+    }
+    if (min_samples < 1)
+    {
+        throw std::invalid_argument("min_samples must be at least 1");
+    }
+}
+
+Dbscan::Dbscan(double eps, int min_samples)
+    : eps(eps), min_samples(min_samples), reused(false)
+{
+    checkParams(eps, min_samples);
+}
+void Dbscan::setParams(double eps, int min_samples)
+{
+    checkParams(eps, min_samples);
+    if (eps != this->eps)
+    {
+        this->reset();
+    }
+    this->eps = eps;
+    this->min_samples = min_samples;
+}
+void Dbscan::reset()
+{
+    this->reference.clear();
+    this->slot_by_id.clear();
+    this->candidate_offsets.clear();
+    this->candidates.clear();
+    this->reused = false;
+}
+double Dbscan::getEps() const
+{
+    return this->eps;
+}
+int Dbscan::getMinSamples() const
+{
+    return this->min_samples;
+}
+bool Dbscan::reusedNeighbors() const
+{
+    return this->reused;
+}
+
+void Dbscan::buildGrid(const std::vector<double>& xy, Grid& grid) const
+{
+    size_t count = xy.size() / 2;
+    grid.cell_size = this->eps;
+    std::vector<int64_t> keys(count);
+    for (size_t k = 0; k < count; k++)
+    {
+        keys[k] = cellKey(cellIndex(xy[2 * k], grid.cell_size), cellIndex(xy[2 * k + 1], grid.cell_size));
+    }
+    grid.order.resize(count);
+    std::iota(grid.order.begin(), grid.order.end(), 0);
+    std::sort(grid.order.begin(), grid.order.end(),
+              [&keys](int a, int b) { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+
+    grid.cells.clear();
+    grid.cells.reserve(count);
+    size_t first = 0;
+    while (first < count)
+    {
+        int64_t key = keys[grid.order[first]];
+        size_t last = first + 1;
+        while (last < count && keys[grid.order[last]] == key)
+        {
+            last++;
+        }
+        grid.cells.emplace(key, std::make_pair(static_cast<int>(first), static_cast<int>(last)));
+        first = last;
+    }
+}
+
+template <typename Visit>
+void Dbscan::visitCells(const Grid& grid, double px, double py, int64_t range, Visit visit) const
+{
+    int64_t x0 = cellIndex(px, grid.cell_size);
+    int64_t y0 = cellIndex(py, grid.cell_size);
+    for (int64_t cx = x0 - range; cx <= x0 + range; cx++)
+    {
+        for (int64_t cy = y0 - range; cy <= y0 + range; cy++)
+        {
+            auto cell = grid.cells.find(cellKey(cx, cy));
+            if (cell == grid.cells.end())
+            {
+                continue;
+            }
+            for (int k = cell->second.first; k < cell->second.second; k++)
+            {
+                visit(grid.order[k]);
+            }
+        }
+    }
+}
+
+void Dbscan::rebuild(const std::vector<double>& xy, const std::vector<std::string>& ids, Grid& grid,
+                     std::vector<std::vector<int>>& neighbors)
+{
+    size_t count = xy.size() / 2;
+    double eps2 = this->eps * this->eps;
+    this->reset();
+    this->buildGrid(xy, grid);
+
+    // Without ids the points cannot be matched on the next call, only the eps neighbors are needed
+    if (ids.size() != count)
+    {
+        for (size_t k = 0; k < count; k++)
+        {
+            visitCells(grid, xy[2 * k], xy[2 * k + 1], 1, [&](int j)
+            {
+                if (static_cast<size_t>(j) != k && distanceSquared(xy, k, j) <= eps2)
+                {
+                    neighbors[k].push_back(j);
+                }
+            });
+        }
+        return;
+    }
+
+    double radius = 2.0 * this->eps * (1.0 + DBSCAN_SKIN_MARGIN);
+    double radius2 = radius * radius;
+    this->reference = xy;
+    this->candidate_offsets.assign(count + 1, 0);
+    for (size_t k = 0; k < count; k++)
+    {
+        // Duplicated ids keep their first point, the others are never matched
+        this->slot_by_id.emplace(ids[k], static_cast<int>(k));
+        visitCells(grid, xy[2 * k], xy[2 * k + 1], 2, [&](int j)
+        {
+            if (static_cast<size_t>(j) == k)
+            {
+                return;
+            }
+            double d2 = distanceSquared(xy, k, j);
+            if (d2 <= radius2)
+            {
+                this->candidates.push_back(j);
+                if (d2 <= eps2)
+                {
+                    neighbors[k].push_back(j);
+                }
+            }
+        });
+        this->candidate_offsets[k + 1] = static_cast<int>(this->candidates.size());
+    }
+}
+
+bool Dbscan::reuse(const std::vector<double>& xy, const std::vector<std::string>& ids, Grid& grid,
+                   std::vector<std::vector<int>>& neighbors) const
+{
+    size_t count = xy.size() / 2;
+    if (ids.size() != count || this->candidate_offsets.empty())
+    {
+        return false;
+    }
+
+    // Match the points to the slots of the last rebuild, a point is moved when it is new or
+    // drifted eps / 2 or more from its slot
+    size_t slots = this->reference.size() / 2;
+    double half = 0.5 * this->eps;
+    double half2 = half * half;
+    std::vector<int> point_of_slot(slots, -1);
+    std::vector<int> slot_of_point(count, -1);
+    std::vector<char> moved(count, 1);
+    size_t moved_count = 0;
+    for (size_t k = 0; k < count; k++)
+    {
+        auto found = this->slot_by_id.find(ids[k]);
+        if (found != this->slot_by_id.end() && point_of_slot[found->second] < 0)
+        {
+            int slot = found->second;
+            point_of_slot[slot] = static_cast<int>(k);
+            slot_of_point[k] = slot;
+            double dx = xy[2 * k] - this->reference[2 * slot];
+            double dy = xy[2 * k + 1] - this->reference[2 * slot + 1];
+            moved[k] = dx * dx + dy * dy < half2 ? 0 : 1;
+        }
+        moved_count += moved[k];
+    }
+    if (2 * moved_count >= count)
+    {
+        return false;
+    }
+
+    // Two points which both stayed within eps / 2 of their slots are within eps only if their
+    // slots are within 2 * eps, so their pair is in the neighbor list
+    double eps2 = this->eps * this->eps;
+    for (size_t k = 0; k < count; k++)
+    {
+        if (moved[k])
+        {
+            continue;
+        }
+        int slot = slot_of_point[k];
+        for (int c = this->candidate_offsets[slot]; c < this->candidate_offsets[slot + 1]; c++)
+        {
+            int j = point_of_slot[this->candidates[c]];
+            if (j >= 0 && !moved[j] && distanceSquared(xy, k, j) <= eps2)
+            {
+                neighbors[k].push_back(j);
+            }
+        }
+    }
+
+    // Pairs with a moved point come from the grid, the moved point records both sides
+    if (moved_count > 0)
+    {
+        this->buildGrid(xy, grid);
+    }
+    for (size_t k = 0; k < count; k++)
+    {
+        if (!moved[k])
+        {
+            continue;
+        }
+        visitCells(grid, xy[2 * k], xy[2 * k + 1], 1, [&](int j)
+        {
+            if (static_cast<size_t>(j) != k && distanceSquared(xy, k, j) <= eps2)
+            {
+                neighbors[k].push_back(j);
+                if (!moved[j])
+                {
+                    neighbors[j].push_back(static_cast<int>(k));
+                }
+            }
+        });
+    }
+    return true;
+}
+
+py::array_t<int64_t> Dbscan::fit(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                                 const std::vector<std::string>& ids)
+{
+    if (points.size() != 0 && (points.ndim() != 2 || (points.shape(1) != 2 && points.shape(1) != 3)))
+    {
+        throw std::invalid_argument("points must be a Nx2 or Nx3 array");
+    }
+    size_t stride = points.size() != 0 ? points.shape(1) : 2;
+    size_t count = points.size() / stride;
+    if (!ids.empty() && ids.size() != count)
+    {
+        throw std::invalid_argument("ids must have one entry per point");
+    }
+
+    const double* data = points.data();
+    std::vector<double> xy(2 * count);
+    for (size_t k = 0; k < count; k++)
+    {
+        xy[2 * k] = data[stride * k];
+        xy[2 * k + 1] = data[stride * k + 1];
+        if (!std::isfinite(xy[2 * k]) || !std::isfinite(xy[2 * k + 1]))
+        {
+            throw std::invalid_argument("points must have finite x and y coordinates");
+        }
+    }
+
+    Grid grid;
+    std::vector<std::vector<int>> neighbors(count);
+    this->reused = this->reuse(xy, ids, grid, neighbors);
+    if (!this->reused)
+    {
+        this->rebuild(xy, ids, grid, neighbors);
+    }
+
+    // Expand the clusters in the order of sklearn's dbscan_inner
+    std::vector<int64_t> labels(count, -1);
+    auto isCore = [&](size_t k) { return neighbors[k].size() + 1 >= static_cast<size_t>(this->min_samples); };
+    std::vector<int> stack;
+    int64_t label = 0;
+    for (size_t k = 0; k < count; k++)
+    {
+        if (labels[k] != -1 || !isCore(k))
+        {
+            continue;
+        }
+        labels[k] = label;
+        stack.push_back(static_cast<int>(k));
+        while (!stack.empty())
+        {
+            int current = stack.back();
+            stack.pop_back();
+            if (!isCore(current))
+            {
+                continue;
+            }
+            for (int j : neighbors[current])
+            {
+                if (labels[j] == -1)
+                {
+                    labels[j] = label;
+                    stack.push_back(j);
+                }
+            }
+        }
+        label++;
+    }
+
+    return py::array_t<int64_t>(labels.size(), labels.data());
+}
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DBSCAN_H
+#define DBSCAN_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+// DBSCAN over the x, y coordinates of a set of points, with neighbors found through a uniform
+// grid of cell size eps. Labels match sklearn.cluster.DBSCAN: a point is a core point when at
+// least min_samples points (itself included) are within eps, clusters are numbered in the order
+// of their first core point and border points go to the first cluster which reaches them.
+//
+// Between calls the engine keeps a neighbor list of radius 2 * eps over the points of the last
+// rebuild. When ids are given and most points moved less than eps / 2 since then, the list still
+// holds every pair within eps and the neighbors are filtered from it; only the points which moved
+// further, or are new, are looked up in the grid.
+class Dbscan
+{
+  public:
+    Dbscan(double eps, int min_samples);
+
+    // Changing eps drops the neighbor list
+    void setParams(double eps, int min_samples);
+    void reset();
+
+    double getEps() const;
+    int getMinSamples() const;
+    // Whether the last fit reused the neighbor list of a previous one
+    bool reusedNeighbors() const;
+
+    // Cluster label of each point of a Nx2 array, -1 for noise. Nx3 arrays are accepted, the
+    // z column is ignored. ids identify the points across calls, without them the neighbor
+    // list is rebuilt every time
+    py::array_t<int64_t> fit(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                             const std::vector<std::string>& ids = std::vector<std::string>());
+
+  private:
+    struct Grid
+    {
+        double cell_size = 1.0;
+        std::vector<int> order;
+        std::unordered_map<int64_t, std::pair<int, int>> cells;
+    };
+
+    void buildGrid(const std::vector<double>& xy, Grid& grid) const;
+    template <typename Visit>
+    void visitCells(const Grid& grid, double px, double py, int64_t range, Visit visit) const;
+    // The grid is only built when some point needs a lookup
+    void rebuild(const std::vector<double>& xy, const std::vector<std::string>& ids, Grid& grid,
+                 std::vector<std::vector<int>>& neighbors);
+    bool reuse(const std::vector<double>& xy, const std::vector<std::string>& ids, Grid& grid,
+               std::vector<std::vector<int>>& neighbors) const;
+
+    double eps;
+    int min_samples;
+    bool reused;
+
+    // Neighbor list of radius 2 * eps over the points of the last rebuild (reference slots)
+    std::vector<double> reference;
+    std::unordered_map<std::string, int> slot_by_id;
+    std::vector<int> candidate_offsets;
+    std::vector<int> candidates;
+};
+
+#endif
@@ -0,0 +1,313 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "extruded_polygon.h"
+#include "segment_crossings.h"
+
+typedef std::pair<double, double> Vertex;
+
+// Drop repeated vertices, including the closing vertex of shapely exteriors
+static std::vector<Vertex> cleanVertices(const std::vector<Vertex>& vertices)
+{
+    std::vector<Vertex> result;
+    for (const Vertex& v : vertices)
+    {
+        if (result.empty() || result.back() != v)
+        {
+            result.push_back(v);
+        }
+    }
+    while (result.size() > 1 && result.front() == result.back())
+    {
+        result.pop_back();
+    }
+    return result;
+}
+
+// Counter-clockwise convex hull without collinear points (monotone chain)
+static std::vector<Vertex> convexHull(std::vector<Vertex> points)
+{
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    std::vector<Vertex> hull(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        while (k >= 2 && orientation(hull[k - 2].first, hull[k - 2].second, hull[k - 1].first, hull[k - 1].second,
+                                     points[i].first, points[i].second) <= 0)
+        {
+            k--;
+        }
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--)
+    {
+        while (k >= lower && orientation(hull[k - 2].first, hull[k - 2].second, hull[k - 1].first, hull[k - 1].second,
+                                         points[i - 1].first, points[i - 1].second) <= 0)
+        {
+            k--;
+        }
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+static bool onSegment(const Vertex& a, const Vertex& b, const Vertex& p)
+{
+    return std::min(a.first, b.first) <= p.first && p.first <= std::max(a.first, b.first)
+           && std::min(a.second, b.second) <= p.second && p.second <= std::max(a.second, b.second);
+}
+
+// Closed segment intersection, touching and collinear overlaps count
+static bool segmentsIntersect(const Vertex& p1, const Vertex& p2, const Vertex& q1, const Vertex& q2)
+{
+    int d1 = orientation(q1.first, q1.second, q2.first, q2.second, p1.first, p1.second);
+    int d2 = orientation(q1.first, q1.second, q2.first, q2.second, p2.first, p2.second);
+    int d3 = orientation(p1.first, p1.second, p2.first, p2.second, q1.first, q1.second);
+    int d4 = orientation(p1.first, p1.second, p2.first, p2.second, q2.first, q2.second);
+    if (d1 * d2 < 0 && d3 * d4 < 0)
+    {
+        return true;
+    }
+    return (d1 == 0 && onSegment(q1, q2, p1)) || (d2 == 0 && onSegment(q1, q2, p2))
+           || (d3 == 0 && onSegment(p1, p2, q1)) || (d4 == 0 && onSegment(p1, p2, q2));
+}
+
+ExtrudedPolygon::ExtrudedPolygon(const std::vector<std::pair<double, double>>& vertices, double height, double z_min)
+    : vertices(cleanVertices(vertices)), polygon(this->vertices), height(height), z_min(z_min), convex(true),
+      min_x(std::numeric_limits<double>::infinity()),
+      min_y(std::numeric_limits<double>::infinity()),
+      max_x(-std::numeric_limits<double>::infinity()),
+      max_y(-std::numeric_limits<double>::infinity())
+{
+    if (this->vertices.size() < 3)
+    {
+        throw std::invalid_argument("An extruded polygon needs at least 3 distinct vertices");
+    }
+
+    size_t n = this->vertices.size();
+    int turn = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const Vertex& a = this->vertices[i];
+        const Vertex& b = this->vertices[(i + 1) % n];
+        const Vertex& c = this->vertices[(i + 2) % n];
+        this->min_x = std::min(this->min_x, a.first);
+        this->min_y = std::min(this->min_y, a.second);
+        this->max_x = std::max(this->max_x, a.first);
+        this->max_y = std::max(this->max_y, a.second);
+
+        int o = orientation(a.first, a.second, b.first, b.second, c.first, c.second);
+        if (o != 0)
+        {
+            if (turn != 0 && o != turn)
+            {
+                this->convex = false;
+            }
+            turn = o;
+        }
+    }
+}
+std::vector<std::pair<double, double>> ExtrudedPolygon::getVertices() const
+{
+    return this->vertices;
+}
+double ExtrudedPolygon::getHeight() const
+{
+    return this->height;
+}
+double ExtrudedPolygon::getZMin() const
+{
+    return this->z_min;
+}
+bool ExtrudedPolygon::isConvex() const
+{
+    return this->convex;
+}
+bool ExtrudedPolygon::intersectsBox(double x, double y, double z,
+                                    double size_x, double size_y, double size_z,
+                                    double qx, double qy, double qz, double qw) const
+{
+    double values[] = {x, y, z, size_x, size_y, size_z, qx, qy, qz, qw};
+    for (double v : values)
+    {
+        if (std::isnan(v))
+        {
+            return false;
+        }
+    }
+    double norm = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+    if (norm == 0.0)
+    {
+        return false;
+    }
+    qx /= norm;
+    qy /= norm;
+    qz /= norm;
+    qw /= norm;
+
+    double r[3][3] = {
+        {1 - 2 * (qy * qy + qz * qz), 2 * (qx * qy - qz * qw), 2 * (qx * qz + qy * qw)},
+        {2 * (qx * qy + qz * qw), 1 - 2 * (qx * qx + qz * qz), 2 * (qy * qz - qx * qw)},
+        {2 * (qx * qz - qy * qw), 2 * (qy * qz + qx * qw), 1 - 2 * (qx * qx + qy * qy)}};
+
+    std::vector<Vertex> footprint;
+    footprint.reserve(8);
+    double bottom = std::numeric_limits<double>::infinity();
+    double top = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 8; i++)
+    {
+        double lx = (i & 1 ? 0.5 : -0.5) * size_x;
+        double ly = (i & 2 ? 0.5 : -0.5) * size_y;
+        double lz = (i & 4 ? size_z : 0.0);
+        double cx = x + r[0][0] * lx + r[0][1] * ly + r[0][2] * lz;
+        double cy = y + r[1][0] * lx + r[1][1] * ly + r[1][2] * lz;
+        double cz = z + r[2][0] * lx + r[2][1] * ly + r[2][2] * lz;
+        footprint.emplace_back(cx, cy);
+        bottom = std::min(bottom, cz);
+        top = std::max(top, cz);
+    }
+
+    if (top < this->z_min || bottom > this->z_min + this->height)
+    {
+        return false;
+    }
+
+    std::vector<Vertex> hull = convexHull(footprint);
+    double hull_min_x = std::numeric_limits<double>::infinity();
+    double hull_min_y = std::numeric_limits<double>::infinity();
+    double hull_max_x = -std::numeric_limits<double>::infinity();
+    double hull_max_y = -std::numeric_limits<double>::infinity();
+    for (const Vertex& v : hull)
+    {
+        hull_min_x = std::min(hull_min_x, v.first);
+        hull_min_y = std::min(hull_min_y, v.second);
+        hull_max_x = std::max(hull_max_x, v.first);
+        hull_max_y = std::max(hull_max_y, v.second);
+    }
+    if (hull_max_x < this->min_x || hull_min_x > this->max_x || hull_max_y < this->min_y || hull_min_y > this->max_y)
+    {
+        return false;
+    }
+
+    return this->footprintIntersects(hull);
+}
+bool ExtrudedPolygon::footprintIntersects(const std::vector<std::pair<double, double>>& hull) const
+{
+    if (this->convex)
+    {
+        return this->separatingAxisTest(hull);
+    }
+    return this->edgeTest(hull);
+}
+bool ExtrudedPolygon::separatingAxisTest(const std::vector<std::pair<double, double>>& hull) const
+{
+    const std::vector<Vertex>* shapes[] = {&hull, &this->vertices};
+    for (const std::vector<Vertex>* shape : shapes)
+    {
+        size_t n = shape->size();
+        for (size_t i = 0; i < n; i++)
+        {
+            const Vertex& a = (*shape)[i];
+            const Vertex& b = (*shape)[(i + 1) % n];
+            double ax = a.second - b.second;
+            double ay = b.first - a.first;
+            if (ax == 0.0 && ay == 0.0)
+            {
+                continue;
+            }
+
+            double min_a = std::numeric_limits<double>::infinity();
+            double max_a = -std::numeric_limits<double>::infinity();
+            for (const Vertex& v : hull)
+            {
+                double p = v.first * ax + v.second * ay;
+                min_a = std::min(min_a, p);
+                max_a = std::max(max_a, p);
+            }
+            double min_b = std::numeric_limits<double>::infinity();
+            double max_b = -std::numeric_limits<double>::infinity();
+            for (const Vertex& v : this->vertices)
+            {
+                double p = v.first * ax + v.second * ay;
+                min_b = std::min(min_b, p);
+                max_b = std::max(max_b, p);
+            }
+            if (max_a < min_b || max_b < min_a)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+bool ExtrudedPolygon::edgeTest(const std::vector<std::pair<double, double>>& hull) const
+{
+    for (const Vertex& v : hull)
+    {
+        if (this->polygon.isPointInside(v.first, v.second))
+        {
+            return true;
+        }
+    }
+
+    size_t h = hull.size();
+    if (h >= 3)
+    {
+        const Vertex& p = this->vertices[0];
+        bool inside = true;
+        for (size_t i = 0; i < h && inside; i++)
+        {
+            const Vertex& a = hull[i];
+            const Vertex& b = hull[(i + 1) % h];
+            inside = orientation(a.first, a.second, b.first, b.second, p.first, p.second) >= 0;
+        }
+        if (inside)
+        {
+            return true;
+        }
+    }
+
+    size_t n = this->vertices.size();
+    for (size_t i = 0; i < h; i++)
+    {
+        const Vertex& a = hull[i];
+        const Vertex& b = hull[(i + 1) % h];
+        for (size_t j = 0; j < n; j++)
+        {
+            if (segmentsIntersect(a, b, this->vertices[j], this->vertices[(j + 1) % n]))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+py::array_t<bool> ExtrudedPolygon::intersectsBoxes(const py::array_t<double, py::array::c_style | py::array::forcecast>& boxes) const
+{
+    if (boxes.size() != 0 && (boxes.ndim() != 2 || boxes.shape(1) != 10))
+    {
+        throw std::invalid_argument("boxes must be a Nx10 array of (x, y, z, size_x, size_y, size_z, qx, qy, qz, qw)");
+    }
+    size_t count = boxes.size() / 10;
+    py::array_t<bool> result(count);
+    bool* mask = result.mutable_data();
+    const double* data = boxes.data();
+    for (size_t k = 0; k < count; k++)
+    {
+        const double* b = data + 10 * k;
+        mask[k] = this->intersectsBox(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b[8], b[9]);
+    }
+    return result;
+}
@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EXTRUDED_POLYGON_H
+#define EXTRUDED_POLYGON_H
+
+#include <utility>
+#include <vector>
+
+#include <pybind11/numpy.h>
+
+#include "polygon.h"
+
+namespace py = pybind11;
+
+// Volume of a region: a polygon footprint on the XY plane extruded from z_min to
+// z_min + height. Intersection with oriented boxes is decided on the XY footprint and on
+// the height interval. The test is exact for boxes rotated about the vertical axis, for
+// tilted boxes the footprint is the convex hull of the projected corners and the height
+// interval spans the corners, which can report an intersection the surfaces do not have.
+class ExtrudedPolygon
+{
+  public:
+
+    ExtrudedPolygon(const std::vector<std::pair<double, double>>& vertices, double height, double z_min = 0.0);
+
+    // Box with its base centered at (x, y, z), extending size_z upwards before the
+    // rotation by the quaternion (qx, qy, qz, qw) about the center of its base
+    bool intersectsBox(double x, double y, double z,
+                       double size_x, double size_y, double size_z,
+                       double qx, double qy, double qz, double qw) const ;
+
+    // Nx10 array of boxes (x, y, z, size_x, size_y, size_z, qx, qy, qz, qw), returns a
+    // boolean mask of length N. Rows with NaN never intersect.
+    py::array_t<bool> intersectsBoxes(const py::array_t<double, py::array::c_style | py::array::forcecast>& boxes) const ;
+
+    std::vector<std::pair<double, double>> getVertices() const ;
+    double getHeight() const ;
+    double getZMin() const ;
+    bool isConvex() const ;
+
+  private:
+    bool footprintIntersects(const std::vector<std::pair<double, double>>& hull) const ;
+    bool separatingAxisTest(const std::vector<std::pair<double, double>>& hull) const ;
+    bool edgeTest(const std::vector<std::pair<double, double>>& hull) const ;
+
+    std::vector<std::pair<double, double>> vertices;
+    Polygon polygon;
+    double height;
+    double z_min;
+    bool convex;
+    double min_x, min_y, max_x, max_y;
+};
+
+#endif
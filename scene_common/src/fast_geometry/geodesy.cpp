@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geodesy.h"
+
+#define DEG_TO_RADIANS(deg)   ((deg) * M_PI / 180.0)
+#define RADIANS_TO_DEG(rad)   ((rad) * 180.0 / M_PI)
+
+// Same constants as scene_common.earth_lla
+static const double EQUATORIAL_RADIUS = 6378137.0;
+static const double POLAR_RADIUS = 6356752.314245;
+static const double SPHERICAL_RADIUS = 6378000.0;
+
+static const double A_SQ = EQUATORIAL_RADIUS * EQUATORIAL_RADIUS;
+static const double B_SQ = POLAR_RADIUS * POLAR_RADIUS;
+static const double E_SQ = 1 - B_SQ / A_SQ;
+static const double E_P_SQ = A_SQ / B_SQ - 1;
+
+static size_t checkRows(const py::array_t<double, py::array::c_style | py::array::forcecast>& array, const char* name)
+{
+    if (array.size() != 0 && (array.ndim() != 2 || array.shape(1) != 3))
+    {
+        throw std::invalid_argument(std::string(name) + " must be a Nx3 array");
+    }
+    return array.size() / 3;
+}
+
+static py::array_t<double> rows(size_t count, size_t columns)
+{
+    return py::array_t<double>(std::vector<py::ssize_t>{static_cast<py::ssize_t>(count), static_cast<py::ssize_t>(columns)});
+}
+
+static void llaToECEFKernel(const double* lla, double* ecef, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        double lat = DEG_TO_RADIANS(lla[3 * i]);
+        double lon = DEG_TO_RADIANS(lla[3 * i + 1]);
+        double alt = lla[3 * i + 2];
+        double sin_lat = std::sin(lat);
+        double cos_lat = std::cos(lat);
+        double n = EQUATORIAL_RADIUS / std::sqrt(1 - E_SQ * sin_lat * sin_lat);
+        ecef[3 * i] = (n + alt) * cos_lat * std::cos(lon);
+        ecef[3 * i + 1] = (n + alt) * cos_lat * std::sin(lon);
+        ecef[3 * i + 2] = ((1 - E_SQ) * n + alt) * sin_lat;
+    }
+}
+
+// Heikkinen's closed form, the spherical fallback is taken where it is not real
+static void ecefToLLAKernel(const double* ecef, double* lla, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        double x = ecef[3 * i];
+        double y = ecef[3 * i + 1];
+        double z = ecef[3 * i + 2];
+        double z_sq = z * z;
+        double p_sq = x * x + y * y;
+        double p = std::sqrt(p_sq);
+        double f = 54 * B_SQ * z_sq;
+        double g = p_sq + (1 - E_SQ) * z_sq - E_SQ * (A_SQ - B_SQ);
+        double c = E_SQ * E_SQ * f * p_sq / (g * g * g);
+        double s = std::pow(1 + c + std::sqrt(c * c + 2 * c), 1.0 / 3.0);
+        double k = s + 1 + 1 / s;
+        double pp = f / (3 * k * k * g * g);
+        double q = std::sqrt(1 + 2 * E_SQ * E_SQ * pp);
+        double r0 = -pp * E_SQ * p / (1 + q)
+                    + std::sqrt(0.5 * A_SQ * (1 + 1 / q) - pp * (1 - E_SQ) * z_sq / (q + q * q) - 0.5 * pp * p_sq);
+        double d = p - E_SQ * r0;
+        double u = std::sqrt(d * d + z_sq);
+        double v = std::sqrt(d * d + (1 - E_SQ) * z_sq);
+        double z0 = B_SQ * z / (EQUATORIAL_RADIUS * v);
+        double alt = u * (1 - B_SQ / (EQUATORIAL_RADIUS * v));
+        double lat = std::atan2(z + E_P_SQ * z0, p);
+
+        if (!std::isfinite(lat) || !std::isfinite(alt))
+        {
+            double r = std::sqrt(p_sq + z_sq);
+            lat = std::asin(z / r);
+            alt = r - SPHERICAL_RADIUS;
+        }
+        lla[3 * i] = RADIANS_TO_DEG(lat);
+        lla[3 * i + 1] = RADIANS_TO_DEG(std::atan2(y, x));
+        lla[3 * i + 2] = alt;
+    }
+}
+
+// Initial bearing from a to b in degrees [0, 360), latitudes and longitudes in degrees
+static double bearing(double lat_a, double lon_a, double lat_b, double lon_b)
+{
+    lat_a = DEG_TO_RADIANS(lat_a);
+    lat_b = DEG_TO_RADIANS(lat_b);
+    double lon_diff = DEG_TO_RADIANS(lon_b) - DEG_TO_RADIANS(lon_a);
+    double x = std::cos(lat_b) * std::sin(lon_diff);
+    double y = std::cos(lat_a) * std::sin(lat_b) - std::sin(lat_a) * std::cos(lat_b) * std::cos(lon_diff);
+    double heading = std::fmod(RADIANS_TO_DEG(std::atan2(x, y)), 360.0);
+    if (heading < 0)
+    {
+        heading += 360.0;
+    }
+    return heading + 0.0;
+}
+
+py::array_t<double> llaToECEF(const py::array_t<double, py::array::c_style | py::array::forcecast>& lla)
+{
+    size_t count = checkRows(lla, "lla");
+    py::array_t<double> result = rows(count, 3);
+    llaToECEFKernel(lla.data(), result.mutable_data(), count);
+    return result;
+}
+
+GeodeticTransform::GeodeticTransform(const py::array_t<double, py::array::c_style | py::array::forcecast>& trs_matrix)
+{
+    if (trs_matrix.ndim() != 2 || trs_matrix.shape(0) != 4 || trs_matrix.shape(1) != 4)
+    {
+        throw std::invalid_argument("trs_matrix must be a 4x4 matrix");
+    }
+    const double* m = trs_matrix.data();
+    double work[4][8];
+    for (int r = 0; r < 4; r++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            this->matrix[4 * r + c] = m[4 * r + c];
+            work[r][c] = m[4 * r + c];
+            work[r][c + 4] = (r == c) ? 1.0 : 0.0;
+        }
+    }
+
+    // Gauss-Jordan elimination with partial pivoting
+    for (int col = 0; col < 4; col++)
+    {
+        int pivot = col;
+        for (int r = col + 1; r < 4; r++)
+        {
+            if (std::abs(work[r][col]) > std::abs(work[pivot][col]))
+            {
+                pivot = r;
+            }
+        }
+        if (work[pivot][col] == 0.0)
+        {
+            throw std::invalid_argument("trs_matrix is singular");
+        }
+        std::swap(work[col], work[pivot]);
+        double scale = work[col][col];
+        for (int c = 0; c < 8; c++)
+        {
+            work[col][c] /= scale;
+        }
+        for (int r = 0; r < 4; r++)
+        {
+            if (r != col)
+            {
+                double factor = work[r][col];
+                for (int c = 0; c < 8; c++)
+                {
+                    work[r][c] -= factor * work[col][c];
+                }
+            }
+        }
+    }
+    for (int r = 0; r < 4; r++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            this->inverse[4 * r + c] = work[r][c + 4];
+        }
+    }
+}
+py::array_t<double> GeodeticTransform::getMatrix() const
+{
+    return py::array_t<double>(std::vector<py::ssize_t>{4, 4}, this->matrix);
+}
+void GeodeticTransform::transform(const double* m, const double* in, double* out, size_t count) const
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const double* p = in + 3 * i;
+        for (int r = 0; r < 3; r++)
+        {
+            out[3 * i + r] = m[4 * r] * p[0] + m[4 * r + 1] * p[1] + m[4 * r + 2] * p[2] + m[4 * r + 3];
+        }
+    }
+}
+py::array_t<double> GeodeticTransform::toLLA(const py::array_t<double, py::array::c_style | py::array::forcecast>& points) const
+{
+    size_t count = checkRows(points, "points");
+    std::vector<double> ecef(3 * count);
+    this->transform(this->matrix, points.data(), ecef.data(), count);
+    py::array_t<double> result = rows(count, 3);
+    ecefToLLAKernel(ecef.data(), result.mutable_data(), count);
+    return result;
+}
+py::array_t<double> GeodeticTransform::fromLLA(const py::array_t<double, py::array::c_style | py::array::forcecast>& lla) const
+{
+    size_t count = checkRows(lla, "lla");
+    std::vector<double> ecef(3 * count);
+    llaToECEFKernel(lla.data(), ecef.data(), count);
+    py::array_t<double> result = rows(count, 3);
+    this->transform(this->inverse, ecef.data(), result.mutable_data(), count);
+    return result;
+}
+py::array_t<double> GeodeticTransform::headings(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                                                const py::array_t<double, py::array::c_style | py::array::forcecast>& velocities) const
+{
+    py::array_t<double> combined = this->toLLAWithHeadings(points, velocities);
+    size_t count = combined.size() / 4;
+    py::array_t<double> result(count);
+    double* out = result.mutable_data();
+    const double* data = combined.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = data[4 * i + 3];
+    }
+    return result;
+}
+py::array_t<double> GeodeticTransform::toLLAWithHeadings(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                                                         const py::array_t<double, py::array::c_style | py::array::forcecast>& velocities) const
+{
+    size_t count = checkRows(points, "points");
+    if (checkRows(velocities, "velocities") != count)
+    {
+        throw std::invalid_argument("points and velocities must have the same number of rows");
+    }
+
+    // The points and the points moved by their velocity are converted in one pass
+    const double* p = points.data();
+    const double* v = velocities.data();
+    std::vector<double> local(6 * count);
+    for (size_t i = 0; i < count; i++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            local[3 * i + c] = p[3 * i + c];
+            local[3 * (count + i) + c] = p[3 * i + c] + v[3 * i + c];
+        }
+    }
+    std::vector<double> ecef(6 * count);
+    std::vector<double> lla(6 * count);
+    this->transform(this->matrix, local.data(), ecef.data(), 2 * count);
+    ecefToLLAKernel(ecef.data(), lla.data(), 2 * count);
+
+    py::array_t<double> result = rows(count, 4);
+    double* out = result.mutable_data();
+    for (size_t i = 0; i < count; i++)
+    {
+        const double* a = lla.data() + 3 * i;
+        const double* b = lla.data() + 3 * (count + i);
+        out[4 * i] = a[0];
+        out[4 * i + 1] = a[1];
+        out[4 * i + 2] = a[2];
+        out[4 * i + 3] = bearing(a[0], a[1], b[0], b[1]);
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef GEODESY_H
+#define GEODESY_H
+
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+// Batched counterparts of scene_common.earth_lla, on the WGS84 ellipsoid. LLA rows are
+// (latitude, longitude, altitude) in degrees and meters, ECEF rows are (X, Y, Z) in meters.
+
+// Nx3 LLA to Nx3 ECEF
+py::array_t<double> llaToECEF(const py::array_t<double, py::array::c_style | py::array::forcecast>& lla);
+
+// Mapping between the local cartesian frame of a scene and LLA, through the scene TRS
+// matrix from local XYZ to ECEF (Scene.trs_xyz_to_lla).
+class GeodeticTransform
+{
+  public:
+
+    GeodeticTransform(const py::array_t<double, py::array::c_style | py::array::forcecast>& trs_matrix);
+
+    py::array_t<double> getMatrix() const ;
+
+    // Nx3 local points to Nx3 LLA
+    py::array_t<double> toLLA(const py::array_t<double, py::array::c_style | py::array::forcecast>& points) const ;
+    // Nx3 LLA to Nx3 local points
+    py::array_t<double> fromLLA(const py::array_t<double, py::array::c_style | py::array::forcecast>& lla) const ;
+    // Bearing in degrees [0, 360) of each Nx3 velocity at the matching Nx3 local point, on a
+    // spherical earth as calculateHeading
+    py::array_t<double> headings(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                                 const py::array_t<double, py::array::c_style | py::array::forcecast>& velocities) const ;
+    // Nx4 rows of (latitude, longitude, altitude, heading), converting each point once
+    py::array_t<double> toLLAWithHeadings(const py::array_t<double, py::array::c_style | py::array::forcecast>& points,
+                                          const py::array_t<double, py::array::c_style | py::array::forcecast>& velocities) const ;
+
+  private:
+    double matrix[16];
+    double inverse[16];
+
+    void transform(const double* m, const double* in, double* out, size_t count) const ;
+};
+
+#endif
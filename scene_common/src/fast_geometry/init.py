@@ -1,4 +1,5 @@
 # SPDX-FileCopyrightText: (C) 2025 Intel Corporation
 # SPDX-License-Identifier: Apache-2.0
 
-from .fast_geometry import Point, Line, Rectangle, Polygon, Size
+from .fast_geometry import Point, PointArray, Line, Rectangle, Polygon, RegionIndex, ExtrudedPolygon, Size, segmentCrossings, \
+    GeodeticTransform, llaToECEF, Dbscan
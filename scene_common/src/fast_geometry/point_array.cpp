@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "utils.h"
+#include "point_array.h"
+
+PointArray::PointArray(size_t count, bool is3D, bool polar)
+    : buffer(3 * count, 0.0), _is3D(is3D), _polar(polar)
+{
+    if (!is3D)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            this->buffer[3 * i + 2] = std::nan("2d");
+        }
+    }
+}
+PointArray::PointArray(const py::array_t<double, py::array::c_style | py::array::forcecast>& data, bool polar)
+    : _is3D(true), _polar(polar)
+{
+    if (data.size() != 0 && (data.ndim() != 2 || (data.shape(1) != 2 && data.shape(1) != 3)))
+    {
+        throw std::invalid_argument("data must be a Nx2 or Nx3 array");
+    }
+    size_t stride = data.size() != 0 ? data.shape(1) : 3;
+    size_t count = data.size() / stride;
+    const double* values = data.data();
+    this->_is3D = (stride == 3);
+    this->buffer.resize(3 * count);
+    for (size_t i = 0; i < count; i++)
+    {
+        this->buffer[3 * i] = values[stride * i];
+        this->buffer[3 * i + 1] = values[stride * i + 1];
+        this->buffer[3 * i + 2] = this->_is3D ? values[stride * i + 2] : std::nan("2d");
+    }
+}
+PointArray PointArray::fromPoints(const std::vector<Point>& points)
+{
+    PointArray result(points.size(), points.empty() || points[0].is3D(), !points.empty() && points[0].polar());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        result.set(i, points[i]);
+    }
+    return result;
+}
+PointArray PointArray::fromPoints2Dxy(const std::vector<Point>& points)
+{
+    PointArray result(points.size(), false, false);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        double* row = result.buffer.data() + 3 * i;
+        row[0] = points[i].x();
+        row[1] = points[i].y();
+    }
+    return result;
+}
+size_t PointArray::size() const
+{
+    return this->buffer.size() / 3;
+}
+bool PointArray::is3D() const
+{
+    return this->_is3D;
+}
+bool PointArray::polar() const
+{
+    return this->_polar;
+}
+double* PointArray::data()
+{
+    return this->buffer.data();
+}
+const double* PointArray::data() const
+{
+    return this->buffer.data();
+}
+Point PointArray::at(size_t i) const
+{
+    this->checkIndex(i);
+    const double* row = this->buffer.data() + 3 * i;
+    if (this->_is3D)
+    {
+        return Point(row[0], row[1], row[2], this->_polar);
+    }
+    return Point(row[0], row[1], this->_polar);
+}
+double* PointArray::row(size_t i)
+{
+    this->checkIndex(i);
+    return this->buffer.data() + 3 * i;
+}
+void PointArray::set(size_t i, const Point& p)
+{
+    this->checkIndex(i);
+    if (p.is3D() != this->_is3D)
+    {
+        throw std::invalid_argument("Cannot mix 3D and 2D points!\n");
+    }
+    if (p.polar() != this->_polar)
+    {
+        throw std::invalid_argument("Cannot mix polar and Cartesian points!\n");
+    }
+    double* row = this->buffer.data() + 3 * i;
+    if (this->_polar)
+    {
+        row[0] = p.radius();
+        row[1] = p.azimuth();
+        row[2] = this->_is3D ? p.inclination() : std::nan("2d");
+    }
+    else
+    {
+        row[0] = p.x();
+        row[1] = p.y();
+        row[2] = this->_is3D ? p.z() : std::nan("2d");
+    }
+}
+std::vector<Point> PointArray::asPoints() const
+{
+    std::vector<Point> points;
+    points.reserve(this->size());
+    for (size_t i = 0; i < this->size(); i++)
+    {
+        points.push_back(this->at(i));
+    }
+    return points;
+}
+py::array_t<double> PointArray::distance(const PointArray& other) const
+{
+    this->checkArraysMatch(other);
+    if (other.size() != this->size() && other.size() != 1)
+    {
+        throw std::invalid_argument("Point arrays must have the same size or hold a single point\n");
+    }
+    size_t count = this->size();
+    size_t step = other.size() == 1 ? 0 : 3;
+    py::array_t<double> result(count);
+    double* out = result.mutable_data();
+    const double* a = this->buffer.data();
+    const double* b = other.buffer.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        double dx = a[3 * i] - b[step * i];
+        double dy = a[3 * i + 1] - b[step * i + 1];
+        if (this->_is3D)
+        {
+            out[i] = magnitude(dx, dy, a[3 * i + 2] - b[step * i + 2]);
+        }
+        else
+        {
+            out[i] = magnitude(dx, dy);
+        }
+    }
+    return result;
+}
+py::array_t<double> PointArray::distance(const Point& p) const
+{
+    PointArray other(1, p.is3D(), p.polar());
+    other.set(0, p);
+    return this->distance(other);
+}
+PointArray PointArray::midpoint(const PointArray& other) const
+{
+    this->checkArraysMatch(other);
+    if (other.size() != this->size())
+    {
+        throw std::invalid_argument("Point arrays must have the same size\n");
+    }
+    PointArray result(*this);
+    const double* b = other.buffer.data();
+    for (size_t k = 0; k < result.buffer.size(); k++)
+    {
+        result.buffer[k] += (b[k] - result.buffer[k]) / 2;
+    }
+    return result;
+}
+PointArray PointArray::transform(const py::array_t<double, py::array::c_style | py::array::forcecast>& matrix) const
+{
+    this->checkPointIsCartesian();
+    size_t dim = this->_is3D ? 3 : 2;
+    if (matrix.ndim() != 2 || matrix.shape(0) != matrix.shape(1)
+        || (static_cast<size_t>(matrix.shape(0)) != dim && static_cast<size_t>(matrix.shape(0)) != dim + 1))
+    {
+        std::ostringstream errstr;
+        errstr << "The transform of " << dim << "D points must be a " << dim << "x" << dim
+               << " or " << dim + 1 << "x" << dim + 1 << " matrix\n";
+        throw std::invalid_argument(errstr.str());
+    }
+    size_t n = matrix.shape(0);
+    bool homogeneous = (n == dim + 1);
+    const double* m = matrix.data();
+
+    PointArray result(*this);
+    for (size_t i = 0; i < this->size(); i++)
+    {
+        const double* row = this->buffer.data() + 3 * i;
+        double* out = result.buffer.data() + 3 * i;
+        double w = 1.0;
+        if (homogeneous)
+        {
+            w = m[n * dim + dim];
+            for (size_t c = 0; c < dim; c++)
+            {
+                w += m[n * dim + c] * row[c];
+            }
+        }
+        for (size_t r = 0; r < dim; r++)
+        {
+            double value = homogeneous ? m[n * r + dim] : 0.0;
+            for (size_t c = 0; c < dim; c++)
+            {
+                value += m[n * r + c] * row[c];
+            }
+            out[r] = value / w;
+        }
+    }
+    return result;
+}
+PointArray PointArray::asCartesian() const
+{
+    if (!this->_polar)
+    {
+        return *this;
+    }
+    PointArray result(this->size(), this->_is3D, false);
+    for (size_t i = 0; i < this->size(); i++)
+    {
+        result.set(i, this->at(i).asCartesian());
+    }
+    return result;
+}
+PointArray PointArray::asPolar() const
+{
+    if (this->_polar)
+    {
+        return *this;
+    }
+    PointArray result(this->size(), this->_is3D, true);
+    for (size_t i = 0; i < this->size(); i++)
+    {
+        result.set(i, this->at(i).asPolar());
+    }
+    return result;
+}
+PointArray PointArray::as2Dxy() const
+{
+    PointArray result = this->asCartesian();
+    result._is3D = false;
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        result.buffer[3 * i + 2] = std::nan("2d");
+    }
+    return result;
+}
+void PointArray::checkIndex(size_t i) const
+{
+    if (i >= this->size())
+    {
+        throw py::index_error("Point index out of range");
+    }
+}
+void PointArray::checkPointIsCartesian() const
+{
+    if (this->_polar)
+    {
+        throw std::invalid_argument("Cannot do Cartesian math on polar points!\n");
+    }
+}
+void PointArray::checkArraysMatch(const PointArray& other) const
+{
+    this->checkPointIsCartesian();
+    other.checkPointIsCartesian();
+    if (this->_is3D != other._is3D)
+    {
+        throw std::invalid_argument("Cannot mix 3D and 2D points!\n");
+    }
+}
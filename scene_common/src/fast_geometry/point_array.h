@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef POINT_ARRAY_H
+#define POINT_ARRAY_H
+
+#include <vector>
+
+#include <pybind11/numpy.h>
+
+#include "point.h"
+
+namespace py = pybind11;
+
+// Batch of points stored as a contiguous Nx3 buffer of doubles, exposed to python with the
+// buffer protocol so numpy.asarray() and the batch kernels (Polygon.isPointInsideBatch,
+// RegionIndex.queryBatch) view it without copying. All the points share the space (2D or
+// 3D) and the representation (cartesian or polar), the z column of 2D arrays is NaN as for
+// Point. Polar rows are (radius, azimuth, inclination) in degrees. The number of points is
+// fixed at construction so the buffer exported to numpy is never reallocated.
+class PointArray
+{
+  public:
+
+    PointArray(size_t count = 0, bool is3D = true, bool polar = false);
+    // Nx2 or Nx3 array
+    PointArray(const py::array_t<double, py::array::c_style | py::array::forcecast>& data, bool polar = false);
+
+    static PointArray fromPoints(const std::vector<Point>& points);
+    // 2D cartesian array of the x and y of each point, the points may mix 2D, 3D and polar
+    static PointArray fromPoints2Dxy(const std::vector<Point>& points);
+
+    size_t size() const ;
+    bool is3D() const ;
+    bool polar() const ;
+    double* data();
+    const double* data() const ;
+
+    // Point over row i, a copy of the three coordinates without heap allocation
+    Point at(size_t i) const ;
+    // Row i of the buffer, views over it stay valid since the size of an array is fixed
+    double* row(size_t i);
+    void set(size_t i, const Point& p);
+    std::vector<Point> asPoints() const ;
+
+    // Row-wise distances to the points of other, other may hold a single point which is
+    // then compared with every row
+    py::array_t<double> distance(const PointArray& other) const ;
+    py::array_t<double> distance(const Point& p) const ;
+    PointArray midpoint(const PointArray& other) const ;
+
+    // Apply a linear (2x2 / 3x3) or homogeneous (3x3 / 4x4) transform to cartesian points
+    PointArray transform(const py::array_t<double, py::array::c_style | py::array::forcecast>& matrix) const ;
+
+    PointArray asCartesian() const ;
+    PointArray asPolar() const ;
+    PointArray as2Dxy() const ;
+
+  private:
+    std::vector<double> buffer;
+    bool _is3D;
+    bool _polar;
+
+    void checkIndex(size_t i) const ;
+    void checkPointIsCartesian() const ;
+    void checkArraysMatch(const PointArray& other) const ;
+};
+
+#endif
@@ -1,33 +1,71 @@
 // SPDX-FileCopyrightText: (C) 2024 - 2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <sstream>
 
 #include "polygon.h"
 
 Polygon::Polygon(const std::vector<std::pair<double, double>>& vertices)
-    : vertices(vertices)
+    : vertices(vertices), region_type(0),
+      min_x(std::numeric_limits<double>::infinity()),
+      min_y(std::numeric_limits<double>::infinity()),
+      max_x(-std::numeric_limits<double>::infinity()),
+      max_y(-std::numeric_limits<double>::infinity())
 {
+    size_t n = this->vertices.size();
+    this->edge_x.reserve(n);
+    this->edge_y.reserve(n);
+    this->edge_y_end.reserve(n);
+    this->edge_slope.reserve(n);
+
+    for (size_t i = 0, j = n - 1; i < n; j = i++)
+    {
+        double xi = this->vertices[i].first;
+        double yi = this->vertices[i].second;
+        double xj = this->vertices[j].first;
+        double yj = this->vertices[j].second;
+
+        this->min_x = std::min(this->min_x, xi);
+        this->min_y = std::min(this->min_y, yi);
+        this->max_x = std::max(this->max_x, xi);
+        this->max_y = std::max(this->max_y, yi);
+
+        // Horizontal edges never straddle the ray, their slope is never used
+        this->edge_x.push_back(xi);
+        this->edge_y.push_back(yi);
+        this->edge_y_end.push_back(yj);
+        this->edge_slope.push_back(yi != yj ? (xj - xi) / (yj - yi) : 0.0);
+    }
 }
 std::vector<std::pair<double, double>> Polygon::getVertices() const
 {
     return this->vertices;
 }
+std::vector<double> Polygon::getBoundingBox() const
+{
+    return {this->min_x, this->min_y, this->max_x, this->max_y};
+}
+bool Polygon::isPointInBoundingBox(double px, double py) const
+{
+    return px >= this->min_x && px <= this->max_x && py >= this->min_y && py <= this->max_y;
+}
 bool Polygon::isPointInside(double px, double py) const
 {
-    int n = this->vertices.size();
+    if (!this->isPointInBoundingBox(px, py))
+    {
+        return false;
+    }
+
+    size_t n = this->edge_x.size();
     bool inside = false;
 
-    for (int i = 0, j = n - 1; i < n; j = i++)
+    for (size_t i = 0; i < n; i++)
     {
-        double xi = this->vertices[i].first;
-        double yi = this->vertices[i].second;
-        double xj = this->vertices[j].first;
-        double yj = this->vertices[j].second;
-
-        bool intersect = ((yi > py) != (yj > py))
-                          && px < ((xj - xi) * (py - yi) / (yj - yi) + xi);
+        bool intersect = ((this->edge_y[i] > py) != (this->edge_y_end[i] > py))
+                          && px < (this->edge_slope[i] * (py - this->edge_y[i]) + this->edge_x[i]);
         if (intersect)
         {
             inside = !inside;
@@ -35,4 +73,61 @@ bool Polygon::isPointInside(double px, double py) const
     }
     return inside;
 }
+py::array_t<bool> Polygon::isPointInsideBatch(const py::array_t<double, py::array::c_style | py::array::forcecast>& points) const
+{
+    if (points.size() != 0 && (points.ndim() != 2 || (points.shape(1) != 2 && points.shape(1) != 3)))
+    {
+        throw std::invalid_argument("points must be a Nx2 or Nx3 array");
+    }
+    size_t stride = points.size() != 0 ? points.shape(1) : 2;
+    size_t count = points.size() / stride;
+    py::array_t<bool> result(count);
+    bool* mask = result.mutable_data();
+    const double* data = points.data();
+
+    // Gather the points which pass the bounding box test into contiguous x and y columns
+    std::vector<size_t> candidates;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    candidates.reserve(count);
+    xs.reserve(count);
+    ys.reserve(count);
+    for (size_t k = 0; k < count; k++)
+    {
+        double px = data[stride * k];
+        double py = data[stride * k + 1];
+        mask[k] = false;
+        if (this->isPointInBoundingBox(px, py))
+        {
+            candidates.push_back(k);
+            xs.push_back(px);
+            ys.push_back(py);
+        }
+    }
 
+    // Edge-major ray cast: the inner loop runs over the points without branches so it vectorizes
+    size_t m = candidates.size();
+    std::vector<unsigned char> inside(m, 0);
+    const double* x = xs.data();
+    const double* y = ys.data();
+    unsigned char* parity = inside.data();
+    for (size_t i = 0; i < this->edge_x.size(); i++)
+    {
+        double xi = this->edge_x[i];
+        double yi = this->edge_y[i];
+        double yj = this->edge_y_end[i];
+        double slope = this->edge_slope[i];
+        for (size_t k = 0; k < m; k++)
+        {
+            unsigned char straddles = (yi > y[k]) != (yj > y[k]);
+            unsigned char left = x[k] < (slope * (y[k] - yi) + xi);
+            parity[k] ^= straddles & left;
+        }
+    }
+
+    for (size_t k = 0; k < m; k++)
+    {
+        mask[candidates[k]] = inside[k] != 0;
+    }
+    return result;
+}
@@ -10,6 +10,10 @@
 #include <map>
 #include <vector>
 
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
 class Polygon
 {
   public:
@@ -21,9 +25,26 @@ class Polygon
     // Method to check if a point is inside the region
     bool isPointInside(double px, double py) const ;
 
+    // Check a Nx2 array of points, returns a boolean mask of length N. Nx3 arrays (such as
+    // a PointArray) are accepted, the z column is ignored
+    py::array_t<bool> isPointInsideBatch(const py::array_t<double, py::array::c_style | py::array::forcecast>& points) const ;
+
+    // Bounding box of the vertices as (min x, min y, max x, max y)
+    std::vector<double> getBoundingBox() const ;
+
   private:
+    bool isPointInBoundingBox(double px, double py) const ;
+
     std::vector<std::pair<double, double>> vertices;
     int region_type;
+
+    // Precomputed at construction: bounding box and, per edge (i, j), the start vertex,
+    // the end y and the inverse slope dx/dy used by the even-odd ray cast.
+    double min_x, min_y, max_x, max_y;
+    std::vector<double> edge_x;
+    std::vector<double> edge_y;
+    std::vector<double> edge_y_end;
+    std::vector<double> edge_slope;
 };
 
 
@@ -0,0 +1,375 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "region_index.h"
+
+// Cell coordinates are clamped so that two of them pack into one 64 bit key
+#define REGION_INDEX_MAX_CELL (1 << 30)
+
+RegionIndex::RegionIndex(double cell_size)
+    : requested_cell_size(cell_size), cell_size(cell_size), grid_built(false)
+{
+}
+static void requireFinite(double value, const char* name)
+{
+    // the bounds are converted to integer grid cells, which is undefined for NaN
+    if (!std::isfinite(value))
+    {
+        throw std::invalid_argument(std::string(name) + " must be finite");
+    }
+}
+
+void RegionIndex::addPolygon(const std::string& id, const std::vector<std::pair<double, double>>& vertices)
+{
+    for (const auto& vertex : vertices)
+    {
+        requireFinite(vertex.first, "polygon vertices");
+        requireFinite(vertex.second, "polygon vertices");
+    }
+
+    Entry entry;
+    entry.id = id;
+    // Region.isPointWithin never matches polygons with less than 3 points
+    entry.shape = vertices.size() > 2 ? Shape::Polygon : Shape::Empty;
+    entry.polygon.reset(new Polygon(vertices));
+    std::vector<double> bounds = entry.polygon->getBoundingBox();
+    entry.min_x = bounds[0];
+    entry.min_y = bounds[1];
+    entry.max_x = bounds[2];
+    entry.max_y = bounds[3];
+    this->insert(std::move(entry));
+}
+void RegionIndex::addCircle(const std::string& id, double cx, double cy, double radius)
+{
+    requireFinite(cx, "circle center");
+    requireFinite(cy, "circle center");
+    requireFinite(radius, "circle radius");
+
+    Entry entry;
+    entry.id = id;
+    entry.shape = Shape::Circle;
+    entry.cx = cx;
+    entry.cy = cy;
+    entry.radius = radius;
+    entry.min_x = cx - radius;
+    entry.min_y = cy - radius;
+    entry.max_x = cx + radius;
+    entry.max_y = cy + radius;
+    this->insert(std::move(entry));
+}
+void RegionIndex::addRectangle(const std::string& id, double x1, double y1, double x2, double y2)
+{
+    requireFinite(x1, "rectangle corners");
+    requireFinite(y1, "rectangle corners");
+    requireFinite(x2, "rectangle corners");
+    requireFinite(y2, "rectangle corners");
+
+    Entry entry;
+    entry.id = id;
+    entry.shape = Shape::Rectangle;
+    entry.min_x = std::min(x1, x2);
+    entry.min_y = std::min(y1, y2);
+    entry.max_x = std::max(x1, x2);
+    entry.max_y = std::max(y1, y2);
+    this->insert(std::move(entry));
+}
+void RegionIndex::addUnbounded(const std::string& id)
+{
+    Entry entry;
+    entry.id = id;
+    entry.shape = Shape::Unbounded;
+    entry.min_x = entry.min_y = -INFINITY;
+    entry.max_x = entry.max_y = INFINITY;
+    this->insert(std::move(entry));
+}
+void RegionIndex::insert(Entry entry)
+{
+    this->remove(entry.id);
+    entry.large = false;
+    entry.active = true;
+
+    int slot;
+    if (!this->free_slots.empty())
+    {
+        slot = this->free_slots.back();
+        this->free_slots.pop_back();
+        this->entries[slot] = std::move(entry);
+    }
+    else
+    {
+        slot = static_cast<int>(this->entries.size());
+        this->entries.push_back(std::move(entry));
+    }
+    this->slot_by_id[this->entries[slot].id] = slot;
+    if (this->grid_built)
+    {
+        this->addToGrid(slot);
+    }
+}
+bool RegionIndex::remove(const std::string& id)
+{
+    auto found = this->slot_by_id.find(id);
+    if (found == this->slot_by_id.end())
+    {
+        return false;
+    }
+    int slot = found->second;
+    this->slot_by_id.erase(found);
+    if (this->grid_built)
+    {
+        this->removeFromGrid(slot);
+    }
+    Entry& entry = this->entries[slot];
+    entry.active = false;
+    entry.id.clear();
+    entry.polygon.reset();
+    this->free_slots.push_back(slot);
+    return true;
+}
+void RegionIndex::clear()
+{
+    this->entries.clear();
+    this->free_slots.clear();
+    this->slot_by_id.clear();
+    this->rebuild();
+}
+void RegionIndex::rebuild()
+{
+    this->grid.clear();
+    this->large.clear();
+    this->unbounded.clear();
+    for (Entry& entry : this->entries)
+    {
+        entry.cells.clear();
+        entry.large = false;
+    }
+    this->cell_size = this->requested_cell_size;
+    this->grid_built = false;
+}
+bool RegionIndex::contains(const std::string& id) const
+{
+    return this->slot_by_id.count(id) > 0;
+}
+size_t RegionIndex::size() const
+{
+    return this->slot_by_id.size();
+}
+double RegionIndex::getCellSize() const
+{
+    return this->cell_size;
+}
+std::vector<std::string> RegionIndex::getIds() const
+{
+    std::vector<std::string> ids;
+    ids.reserve(this->entries.size());
+    for (const Entry& entry : this->entries)
+    {
+        ids.push_back(entry.id);
+    }
+    return ids;
+}
+void RegionIndex::ensureGrid()
+{
+    if (this->grid_built)
+    {
+        return;
+    }
+
+    if (this->requested_cell_size <= 0.0)
+    {
+        std::vector<double> extents;
+        for (const Entry& entry : this->entries)
+        {
+            if (entry.active && entry.shape != Shape::Unbounded && entry.shape != Shape::Empty)
+            {
+                extents.push_back(std::max(entry.max_x - entry.min_x, entry.max_y - entry.min_y));
+            }
+        }
+        this->cell_size = 1.0;
+        if (!extents.empty())
+        {
+            std::nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+            double median = extents[extents.size() / 2];
+            if (std::isfinite(median) && median > 0.0)
+            {
+                this->cell_size = median;
+            }
+        }
+    }
+
+    this->grid_built = true;
+    for (size_t slot = 0; slot < this->entries.size(); slot++)
+    {
+        if (this->entries[slot].active)
+        {
+            this->addToGrid(static_cast<int>(slot));
+        }
+    }
+}
+int64_t RegionIndex::cellIndex(double v) const
+{
+    double cell = std::floor(v / this->cell_size);
+    cell = std::min(std::max(cell, -double(REGION_INDEX_MAX_CELL)), double(REGION_INDEX_MAX_CELL));
+    return static_cast<int64_t>(cell);
+}
+int64_t RegionIndex::cellKey(int64_t cx, int64_t cy) const
+{
+    return static_cast<int64_t>((static_cast<uint64_t>(cx) << 32) ^ (static_cast<uint64_t>(cy) & 0xffffffffu));
+}
+void RegionIndex::addToGrid(int slot)
+{
+    Entry& entry = this->entries[slot];
+    if (entry.shape == Shape::Empty)
+    {
+        return;
+    }
+    if (entry.shape == Shape::Unbounded)
+    {
+        this->unbounded.push_back(slot);
+        return;
+    }
+
+    int64_t x0 = this->cellIndex(entry.min_x);
+    int64_t y0 = this->cellIndex(entry.min_y);
+    int64_t x1 = this->cellIndex(entry.max_x);
+    int64_t y1 = this->cellIndex(entry.max_y);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > MAX_CELLS_PER_REGION)
+    {
+        entry.large = true;
+        this->large.push_back(slot);
+        return;
+    }
+    for (int64_t cx = x0; cx <= x1; cx++)
+    {
+        for (int64_t cy = y0; cy <= y1; cy++)
+        {
+            int64_t key = this->cellKey(cx, cy);
+            this->grid[key].push_back(slot);
+            entry.cells.push_back(key);
+        }
+    }
+}
+void RegionIndex::removeFromGrid(int slot)
+{
+    Entry& entry = this->entries[slot];
+    for (int64_t key : entry.cells)
+    {
+        auto cell = this->grid.find(key);
+        if (cell == this->grid.end())
+        {
+            continue;
+        }
+        std::vector<int>& slots = cell->second;
+        slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+        if (slots.empty())
+        {
+            this->grid.erase(cell);
+        }
+    }
+    entry.cells.clear();
+    if (entry.large)
+    {
+        this->large.erase(std::remove(this->large.begin(), this->large.end(), slot), this->large.end());
+        entry.large = false;
+    }
+    if (entry.shape == Shape::Unbounded)
+    {
+        this->unbounded.erase(std::remove(this->unbounded.begin(), this->unbounded.end(), slot), this->unbounded.end());
+    }
+}
+bool RegionIndex::isPointInside(const Entry& entry, double px, double py) const
+{
+    switch (entry.shape)
+    {
+        case Shape::Polygon:
+            return entry.polygon->isPointInside(px, py);
+        case Shape::Circle:
+        {
+            // Same test as Region.isPointWithin
+            double dx = std::abs(px - entry.cx);
+            double dy = std::abs(py - entry.cy);
+            return dx + dy <= entry.radius || dx * dx + dy * dy <= entry.radius * entry.radius;
+        }
+        case Shape::Rectangle:
+            return px >= entry.min_x && px <= entry.max_x && py >= entry.min_y && py <= entry.max_y;
+        case Shape::Unbounded:
+            return true;
+        default:
+            return false;
+    }
+}
+void RegionIndex::collect(double px, double py, std::vector<int>& slots) const
+{
+    slots = this->unbounded;
+    if (std::isnan(px) || std::isnan(py))
+    {
+        std::sort(slots.begin(), slots.end());
+        return;
+    }
+
+    auto cell = this->grid.find(this->cellKey(this->cellIndex(px), this->cellIndex(py)));
+    if (cell != this->grid.end())
+    {
+        for (int slot : cell->second)
+        {
+            if (this->isPointInside(this->entries[slot], px, py))
+            {
+                slots.push_back(slot);
+            }
+        }
+    }
+    for (int slot : this->large)
+    {
+        const Entry& entry = this->entries[slot];
+        if (px >= entry.min_x && px <= entry.max_x && py >= entry.min_y && py <= entry.max_y
+            && this->isPointInside(entry, px, py))
+        {
+            slots.push_back(slot);
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+}
+std::vector<std::string> RegionIndex::query(double px, double py)
+{
+    this->ensureGrid();
+    std::vector<int> slots;
+    this->collect(px, py, slots);
+
+    std::vector<std::string> ids;
+    ids.reserve(slots.size());
+    for (int slot : slots)
+    {
+        ids.push_back(this->entries[slot].id);
+    }
+    return ids;
+}
+py::tuple RegionIndex::queryBatch(const py::array_t<double, py::array::c_style | py::array::forcecast>& points)
+{
+    if (points.size() != 0 && (points.ndim() != 2 || (points.shape(1) != 2 && points.shape(1) != 3)))
+    {
+        throw std::invalid_argument("points must be a Nx2 or Nx3 array");
+    }
+    this->ensureGrid();
+
+    size_t stride = points.size() != 0 ? points.shape(1) : 2;
+    size_t count = points.size() / stride;
+    const double* data = points.data();
+    std::vector<int64_t> offsets(count + 1, 0);
+    std::vector<int64_t> hits;
+    hits.reserve(count);
+    std::vector<int> slots;
+    for (size_t k = 0; k < count; k++)
+    {
+        this->collect(data[stride * k], data[stride * k + 1], slots);
+        hits.insert(hits.end(), slots.begin(), slots.end());
+        offsets[k + 1] = static_cast<int64_t>(hits.size());
+    }
+
+    return py::make_tuple(py::array_t<int64_t>(offsets.size(), offsets.data()),
+                          py::array_t<int64_t>(hits.size(), hits.data()));
+}
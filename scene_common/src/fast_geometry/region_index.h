@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef REGION_INDEX_H
+#define REGION_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <pybind11/numpy.h>
+
+#include "polygon.h"
+
+namespace py = pybind11;
+
+// Uniform grid over the bounding boxes of the regions of a scene. Each cell lists the regions
+// whose bounds overlap it, so a point is only tested against the few regions around it.
+// Regions covering more than MAX_CELLS_PER_REGION cells are kept in a separate list and
+// tested against every point after a bounding box check.
+class RegionIndex
+{
+  public:
+
+    // cell_size <= 0 picks the median extent of the regions when the grid is first queried
+    RegionIndex(double cell_size = 0.0);
+
+    // Adding an id which is already indexed replaces its geometry
+    void addPolygon(const std::string& id, const std::vector<std::pair<double, double>>& vertices);
+    void addCircle(const std::string& id, double cx, double cy, double radius);
+    void addRectangle(const std::string& id, double x1, double y1, double x2, double y2);
+    // Region which contains every point (whole scene)
+    void addUnbounded(const std::string& id);
+
+    bool remove(const std::string& id);
+    void clear();
+    // Drop the grid, it is rebuilt with a new cell size on the next query
+    void rebuild();
+
+    bool contains(const std::string& id) const;
+    size_t size() const;
+    double getCellSize() const;
+    // Id of every slot returned by queryBatch, freed slots are empty strings
+    std::vector<std::string> getIds() const;
+
+    // Ids of the regions containing the point
+    std::vector<std::string> query(double px, double py);
+    // Regions containing each point of a Nx2 array, as (offsets, slots): the slots of point i
+    // are slots[offsets[i]:offsets[i + 1]] in increasing order. Nx3 arrays are accepted, the
+    // z column is ignored
+    py::tuple queryBatch(const py::array_t<double, py::array::c_style | py::array::forcecast>& points);
+
+  private:
+    enum class Shape { Polygon, Circle, Rectangle, Unbounded, Empty };
+
+    struct Entry
+    {
+        std::string id;
+        Shape shape = Shape::Empty;
+        std::unique_ptr<Polygon> polygon;
+        double cx = 0.0, cy = 0.0, radius = 0.0;
+        double min_x = 0.0, min_y = 0.0, max_x = 0.0, max_y = 0.0;
+        std::vector<int64_t> cells;
+        bool large = false;
+        bool active = false;
+    };
+
+    static const int64_t MAX_CELLS_PER_REGION = 1024;
+
+    void insert(Entry entry);
+    void addToGrid(int slot);
+    void removeFromGrid(int slot);
+    void ensureGrid();
+    int64_t cellIndex(double v) const;
+    int64_t cellKey(int64_t cx, int64_t cy) const;
+    bool isPointInside(const Entry& entry, double px, double py) const;
+    void collect(double px, double py, std::vector<int>& slots) const;
+
+    double requested_cell_size;
+    double cell_size;
+    bool grid_built;
+    std::vector<Entry> entries;
+    std::vector<int> free_slots;
+    std::unordered_map<std::string, int> slot_by_id;
+    std::unordered_map<int64_t, std::vector<int>> grid;
+    std::vector<int> large;
+    std::vector<int> unbounded;
+};
+
+#endif
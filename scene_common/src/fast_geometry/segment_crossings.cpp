@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "segment_crossings.h"
+
+// Below this number of tripwire segments the brute force test is faster than the grid
+#define SEGMENT_GRID_MIN_TRIPWIRES 16
+// Motion segments covering more cells than this are tested against every tripwire segment
+#define SEGMENT_GRID_MAX_CELLS 64
+
+// Relative error bound of the 2x2 orientation determinant, (3 + 16 eps) eps
+static const double ORIENTATION_ERROR_BOUND = 3.3306690738754716e-16;
+
+int orientation(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    double left = (bx - ax) * (cy - ay);
+    double right = (by - ay) * (cx - ax);
+    double det = left - right;
+    double bound = ORIENTATION_ERROR_BOUND * (std::abs(left) + std::abs(right));
+    if (det > bound)
+    {
+        return 1;
+    }
+    if (det < -bound)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+// Direction of the crossing of motion segment m with tripwire segment t, 0 if they do not cross
+static int crossingDirection(const double* m, const double* t)
+{
+    int o1 = orientation(t[0], t[1], t[2], t[3], m[0], m[1]);
+    int o2 = orientation(t[0], t[1], t[2], t[3], m[2], m[3]);
+    if ((o1 == 0 && o2 == 0) || o1 * o2 > 0)
+    {
+        return 0;
+    }
+    int o3 = orientation(m[0], m[1], m[2], m[3], t[0], t[1]);
+    int o4 = orientation(m[0], m[1], m[2], m[3], t[2], t[3]);
+    if (o3 * o4 > 0)
+    {
+        return 0;
+    }
+    // The motion ends on the right of the tripwire segment, or on it
+    return o2 > 0 ? -1 : 1;
+}
+
+static void checkSegments(const py::array_t<double, py::array::c_style | py::array::forcecast>& array, const char* name)
+{
+    if (array.size() != 0 && (array.ndim() != 2 || array.shape(1) != 4))
+    {
+        throw std::invalid_argument(std::string(name) + " must be a Nx4 array of (x1, y1, x2, y2)");
+    }
+}
+
+py::array_t<int64_t> segmentCrossings(const py::array_t<double, py::array::c_style | py::array::forcecast>& segments,
+                                      const py::array_t<double, py::array::c_style | py::array::forcecast>& tripwires,
+                                      double cell_size)
+{
+    checkSegments(segments, "segments");
+    checkSegments(tripwires, "tripwires");
+    size_t m_count = segments.size() / 4;
+    size_t t_count = tripwires.size() / 4;
+    const double* motion = segments.data();
+    const double* wires = tripwires.data();
+
+    std::vector<int64_t> result;
+    auto test = [&](size_t m, size_t t)
+    {
+        int direction = crossingDirection(motion + 4 * m, wires + 4 * t);
+        if (direction != 0)
+        {
+            result.push_back(static_cast<int64_t>(m));
+            result.push_back(static_cast<int64_t>(t));
+            result.push_back(direction);
+        }
+    };
+
+    if (t_count < SEGMENT_GRID_MIN_TRIPWIRES)
+    {
+        for (size_t m = 0; m < m_count; m++)
+        {
+            for (size_t t = 0; t < t_count; t++)
+            {
+                test(m, t);
+            }
+        }
+    }
+    else
+    {
+        if (cell_size <= 0.0)
+        {
+            double extent = 0.0;
+            for (size_t t = 0; t < t_count; t++)
+            {
+                const double* w = wires + 4 * t;
+                extent += std::max(std::abs(w[2] - w[0]), std::abs(w[3] - w[1]));
+            }
+            cell_size = extent / t_count;
+            if (!std::isfinite(cell_size) || cell_size <= 0.0)
+            {
+                cell_size = 1.0;
+            }
+        }
+
+        auto cell = [cell_size](double v)
+        {
+            double c = std::floor(v / cell_size);
+            return static_cast<int64_t>(std::min(std::max(c, -1073741824.0), 1073741824.0));
+        };
+        auto key = [](int64_t cx, int64_t cy)
+        {
+            return static_cast<int64_t>((static_cast<uint64_t>(cx) << 32) ^ (static_cast<uint64_t>(cy) & 0xffffffffu));
+        };
+
+        // Tripwire segments binned by the cells of their bounding box, long ones are always tested
+        std::unordered_map<int64_t, std::vector<size_t>> grid;
+        std::vector<size_t> unbinned;
+        for (size_t t = 0; t < t_count; t++)
+        {
+            const double* w = wires + 4 * t;
+            if (std::isnan(w[0]) || std::isnan(w[1]) || std::isnan(w[2]) || std::isnan(w[3]))
+            {
+                continue;
+            }
+            int64_t x0 = cell(std::min(w[0], w[2]));
+            int64_t x1 = cell(std::max(w[0], w[2]));
+            int64_t y0 = cell(std::min(w[1], w[3]));
+            int64_t y1 = cell(std::max(w[1], w[3]));
+            if ((x1 - x0 + 1) * (y1 - y0 + 1) > SEGMENT_GRID_MAX_CELLS)
+            {
+                unbinned.push_back(t);
+                continue;
+            }
+            for (int64_t cx = x0; cx <= x1; cx++)
+            {
+                for (int64_t cy = y0; cy <= y1; cy++)
+                {
+                    grid[key(cx, cy)].push_back(t);
+                }
+            }
+        }
+
+        std::vector<size_t> seen(t_count, SIZE_MAX);
+        std::vector<size_t> candidates;
+        for (size_t m = 0; m < m_count; m++)
+        {
+            const double* s = motion + 4 * m;
+            if (std::isnan(s[0]) || std::isnan(s[1]) || std::isnan(s[2]) || std::isnan(s[3]))
+            {
+                continue;
+            }
+            int64_t x0 = cell(std::min(s[0], s[2]));
+            int64_t x1 = cell(std::max(s[0], s[2]));
+            int64_t y0 = cell(std::min(s[1], s[3]));
+            int64_t y1 = cell(std::max(s[1], s[3]));
+            if ((x1 - x0 + 1) * (y1 - y0 + 1) > SEGMENT_GRID_MAX_CELLS)
+            {
+                for (size_t t = 0; t < t_count; t++)
+                {
+                    test(m, t);
+                }
+                continue;
+            }
+
+            candidates.assign(unbinned.begin(), unbinned.end());
+            for (int64_t cx = x0; cx <= x1; cx++)
+            {
+                for (int64_t cy = y0; cy <= y1; cy++)
+                {
+                    auto found = grid.find(key(cx, cy));
+                    if (found == grid.end())
+                    {
+                        continue;
+                    }
+                    for (size_t t : found->second)
+                    {
+                        if (seen[t] != m)
+                        {
+                            seen[t] = m;
+                            candidates.push_back(t);
+                        }
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            for (size_t t : candidates)
+            {
+                test(m, t);
+            }
+        }
+    }
+
+    py::array_t<int64_t> crossings(std::vector<py::ssize_t>{static_cast<py::ssize_t>(result.size() / 3), 3});
+    std::copy(result.begin(), result.end(), crossings.mutable_data());
+    return crossings;
+}
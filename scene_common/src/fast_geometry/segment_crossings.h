@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SEGMENT_CROSSINGS_H
+#define SEGMENT_CROSSINGS_H
+
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+// Sign of the orientation of c with respect to the directed line a->b: 1 left, -1 right,
+// 0 collinear. Determinants within the floating point error bound count as collinear, so
+// the result never depends on rounding.
+int orientation(double ax, double ay, double bx, double by, double cx, double cy);
+
+// Find the crossings between the Mx4 motion segments (x1, y1, x2, y2) and the Kx4 tripwire
+// segments. Returns a Px3 array of (motion index, tripwire index, direction) sorted by motion
+// then tripwire index. Touching counts as crossing, collinear segments never cross. The
+// direction is the side of the tripwire segment the motion segment ends on, 1 when it ends
+// on the right (or on the segment itself) and -1 on the left, as Tripwire.lineCrosses.
+// Tripwire segments are binned in a uniform grid when there are many of them, cell_size <= 0
+// picks the mean extent of the tripwire segments.
+py::array_t<int64_t> segmentCrossings(const py::array_t<double, py::array::c_style | py::array::forcecast>& segments,
+                                      const py::array_t<double, py::array::c_style | py::array::forcecast>& tripwires,
+                                      double cell_size = 0.0);
+
+#endif
@@ -15,6 +15,7 @@ import numpy as np
 import cv2
 import math
 
+from fast_geometry import GeodeticTransform, llaToECEF
 from scene_common.geometry import Point
 
 EQUATORIAL_RADIUS = 6378137.0
@@ -93,6 +94,13 @@ def convertECEFToLLA(ecef_pt):
 
   return np.array([np.rad2deg(lat), np.rad2deg(long), altitude])
 
+def convertLLAToECEFBatch(lla_pts):
+  """! Batched convertLLAToECEF, converted natively in one call.
+  @param      lla_pts          Nx3 coordinates in LLA format
+  @returns    numpy.ndarray    Nx3 data in ECEF format
+  """
+  return llaToECEF(np.asarray(lla_pts, dtype=np.float64).reshape(-1, 3))
+
 def convertToCartesianTRS(from_pts, to_pts):
   # Needs 3 point pairs, reliable with 4+
   (tr_mat, scale) = cv2.estimateAffine3D(from_pts, to_pts, force_rotation=False)
@@ -104,7 +112,7 @@ def convertToCartesianTRS(from_pts, to_pts):
   return trs_mat
 
 def convertLLAToCartesianTRS(map_pts, lla_pts):
-  ecef_pts = np.array([convertLLAToECEF(pt) for pt in lla_pts])
+  ecef_pts = convertLLAToECEFBatch(lla_pts)
   trs_mat = convertToCartesianTRS(map_pts, ecef_pts)
   return trs_mat
 
@@ -5,13 +5,14 @@ import math
 
 import numpy as np
 
-from fast_geometry import Point, Line, Rectangle, Polygon, Size
+from fast_geometry import Point, PointArray, Line, Rectangle, Polygon, RegionIndex, ExtrudedPolygon, Size, segmentCrossings, \
+  GeodeticTransform, Dbscan
 
 DEFAULTZ = 0
 ROI_Z_HEIGHT = 1.0
 
 # Re-export modules from fast geometry as our own
-__all__ = ['Point', 'Line', 'Rectangle', 'Size']
+__all__ = ['Point', 'PointArray', 'Line', 'Rectangle', 'RegionIndex', 'ExtrudedPolygon', 'Size', 'segmentCrossings', 'GeodeticTransform', 'Dbscan']
 
 def isarray(a):
   return isinstance(a, (list, tuple, np.ndarray))
@@ -26,6 +27,7 @@ class Region:
     self.name = name
     self.area = None
     self.mesh = None
+    self.prism = None
     self.objects = {}
     self.when = -1
     self.points_list = None
@@ -37,6 +39,7 @@ class Region:
     return
 
   def updatePoints(self, info):
+    self.prism = None
     if (not self.hasPointsArray(info) and 'center' in info):
       pt = info['center']
       self.center = pt if isinstance(pt, Point) else Point(pt)
@@ -74,6 +77,7 @@ class Region:
 
   def updateVolumetricInfo(self, info):
     if isinstance(info, dict):
+      self.prism = None
       self.compute_intersection = info.get('volumetric', False)
       self.height = float(info.get('height', ROI_Z_HEIGHT))
       self.buffer_size = float(info.get('buffer_size', 0.0))
@@ -132,6 +136,22 @@ class Region:
       return True
     return False
 
+  def addToIndex(self, index, key=None):
+    """Insert or replace the region geometry in a RegionIndex, under its uuid unless key is given"""
+    key = self.uuid if key is None else key
+    if self.area == Region.REGION_SCENE:
+      index.addUnbounded(key)
+      return
+    try:
+      if self.area == Region.REGION_POLY:
+        index.addPolygon(key, [x.as2Dxy.asCartesianVector for x in self.points])
+      else:
+        index.addCircle(key, self.center.x, self.center.y, self.radius)
+    except ValueError:
+      # non-finite geometry never contains a point, the region is kept as an empty entry
+      index.addPolygon(key, [])
+    return
+
   def serialize(self):
     data = {'points':[], 'title':self.name, 'uuid':self.uuid}
     if self.area == self.REGION_SCENE:
@@ -176,6 +196,12 @@ class Tripwire(Region):
         return int(math.copysign(1, direction))
     return 0
 
+  @property
+  def segments(self):
+    """Segments of the tripwire as a Nx4 array of (x1, y1, x2, y2)"""
+    pts = np.array([x.as2Dxy.asCartesianVector for x in self.points], dtype=np.float64).reshape(-1, 2)
+    return np.hstack([pts[:-1], pts[1:]])
+
   def serialize(self):
     data = {
       'title': self.name,
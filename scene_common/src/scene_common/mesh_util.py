@@ -7,6 +7,7 @@ import math
 import numpy as np
 import open3d as o3d
 import trimesh
+from fast_geometry import ExtrudedPolygon
 from scene_common import log
 
 MESH_FLATTEN_Z_SCALE = 1000 # This is a calibrated value, used to make mesh look like a flat map.
@@ -351,6 +352,15 @@ def createRegionMesh(region):
   region.mesh = mesh
   return
 
+def createRegionPrism(region):
+  """
+  Create the native extruded polygon used for volumetric intersection checks, it
+  replaces the region mesh for that purpose and the mesh is only built for display
+  """
+  roi_pts = createBasePolygon(region.points, region.buffer_size)
+  region.prism = ExtrudedPolygon([(x, y) for x, y in roi_pts], region.height)
+  return
+
 def createBasePolygon(points, buffer_size):
   from shapely import geometry
   mitre_inflated = None
@@ -378,8 +388,7 @@ def createBasePolygon(points, buffer_size):
 def isarray(a):
   return isinstance(a, (list, tuple, np.ndarray))
 
-def createObjectMesh(obj):
-  from scipy.spatial.transform import Rotation
+def validateObjectBox(obj):
   if not (hasattr(obj, 'sceneLoc') and hasattr(obj.sceneLoc, 'asNumpyCartesian')):
     raise ValueError("Object must have a valid 'sceneLoc' attribute with 'asNumpyCartesian' method")
 
@@ -388,6 +397,27 @@ def createObjectMesh(obj):
 
   if not (hasattr(obj, 'rotation') and isarray(obj.rotation) and len(obj.rotation) == 4):
     raise ValueError("Object must have a valid 'rotation' attribute (quaternion)")
+  return
+
+def createObjectBox(obj):
+  """
+  Returns the (x, y, z, size_x, size_y, size_z, qx, qy, qz, qw) row describing the
+  object box for ExtrudedPolygon.intersectsBox(es), validated as createObjectMesh
+  """
+  validateObjectBox(obj)
+  if len(obj.size) < 3:
+    raise ValueError("Object must have a valid 'size' attribute (list or array of numbers)")
+  box = np.empty(10)
+  box[:3] = obj.sceneLoc.asNumpyCartesian
+  box[3:6] = obj.size[:3]
+  box[6:] = obj.rotation
+  if not np.any(box[6:]):
+    raise ValueError("Failed to apply rotation: zero norm quaternion")
+  return box
+
+def createObjectMesh(obj):
+  from scipy.spatial.transform import Rotation
+  validateObjectBox(obj)
 
   # Create a basic box mesh
   mesh = o3d.geometry.TriangleMesh.create_box(
@@ -0,0 +1,87 @@
+# SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import pytest
+
+import scene_common.geometry as geometry
+
+def referenceDbscan(points, eps, min_samples):
+  """! Brute force DBSCAN visiting the points in the order of sklearn.cluster.DBSCAN. """
+  distances = np.linalg.norm(points[:, None, :2] - points[None, :, :2], axis=2)
+  neighbors = [np.flatnonzero(row <= eps) for row in distances]
+  core = [len(n) >= min_samples for n in neighbors]
+  labels = np.full(len(points), -1)
+  label = 0
+  for start in range(len(points)):
+    if labels[start] != -1 or not core[start]:
+      continue
+    labels[start] = label
+    stack = [start]
+    while stack:
+      current = stack.pop()
+      if not core[current]:
+        continue
+      for j in neighbors[current]:
+        if labels[j] == -1:
+          labels[j] = label
+          stack.append(j)
+    label += 1
+  return labels
+
+def test_dbscan_labels():
+  """! Verifies 'geometry.Dbscan' labels match a brute force DBSCAN. """
+
+  rng = np.random.default_rng(7)
+  centers = rng.uniform(0, 50, size=(6, 2))
+  points = np.vstack([c + rng.normal(0, 0.8, size=(30, 2)) for c in centers] +
+                     [rng.uniform(0, 50, size=(40, 2))])
+  for eps, min_samples in [(0.5, 2), (1.0, 3), (2.5, 5)]:
+    labels = geometry.Dbscan(eps, min_samples).fit(points)
+    assert np.array_equal(labels, referenceDbscan(points, eps, min_samples))
+
+  # z is ignored
+  flat = np.hstack([points, rng.uniform(-5, 5, size=(len(points), 1))])
+  assert np.array_equal(geometry.Dbscan(1.0, 3).fit(flat), referenceDbscan(points, 1.0, 3))
+
+  assert len(geometry.Dbscan(1.0, 3).fit(np.empty((0, 2)))) == 0
+  with pytest.raises(ValueError):
+    geometry.Dbscan(0.0, 3)
+  with pytest.raises(ValueError):
+    geometry.Dbscan(1.0, 3).fit(np.array([[0., np.nan]]))
+  with pytest.raises(ValueError):
+    geometry.Dbscan(1.0, 3).fit(points, ['a'])
+
+  return
+
+def test_dbscan_incremental():
+  """! Verifies 'geometry.Dbscan' reuses its neighbors across frames without changing the labels. """
+
+  rng = np.random.default_rng(11)
+  points = rng.uniform(0, 30, size=(300, 2))
+  ids = [str(i) for i in range(len(points))]
+  engine = geometry.Dbscan(1.5, 3)
+  reused = 0
+  for frame in range(20):
+    points += rng.uniform(-0.1, 0.1, size=points.shape)
+    # a few objects jump or are replaced by new ones
+    jumped = rng.choice(len(points), 5, replace=False)
+    points[jumped] = rng.uniform(0, 30, size=(5, 2))
+    ids[int(rng.integers(len(ids)))] = f"new-{frame}"
+    labels = engine.fit(points, ids)
+    reused += engine.reusedNeighbors
+    assert np.array_equal(labels, referenceDbscan(points, 1.5, 3))
+  assert reused > 0
+
+  # every object moved far, the neighbors are rebuilt
+  points += 10.
+  engine.fit(points, ids)
+  assert not engine.reusedNeighbors
+
+  # changing eps drops the neighbors
+  engine.setParams(2.0, 3)
+  labels = engine.fit(points, ids)
+  assert not engine.reusedNeighbors
+  assert np.array_equal(labels, referenceDbscan(points, 2.0, 3))
+
+  return
@@ -0,0 +1,81 @@
+# SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import pytest
+
+import scene_common.geometry as geometry
+
+def test_point_array_buffer():
+  """! Verifies 'geometry.PointArray' exposes its points as a Nx3 numpy view. """
+
+  points = [geometry.Point(1., 2., 3.), geometry.Point(4., 5., 6.)]
+  array = geometry.PointArray.fromPoints(points)
+  view = np.asarray(array)
+  assert len(array) == 2 and array.is3D and not array.polar
+  assert view.shape == (2, 3)
+  assert np.array_equal(view, [[1, 2, 3], [4, 5, 6]])
+
+  # writes through the view are seen by the points
+  view[1, 0] = 10.
+  assert array.point(1) == geometry.Point(10., 5., 6.)
+
+  array[0] = geometry.Point(7., 8., 9.)
+  assert np.array_equal(view[0], [7, 8, 9])
+
+  # indexing returns a view of the row, which keeps the array alive
+  row = array[1]
+  row[2] = 12.
+  assert array.point(1) == geometry.Point(10., 5., 12.)
+  del array, view
+  assert np.array_equal(row, [10, 5, 12])
+
+  flat = geometry.PointArray(np.array([[1., 2.], [3., 4.]]))
+  assert not flat.is3D
+  assert np.isnan(np.asarray(flat)[:, 2]).all()
+
+  with pytest.raises(ValueError):
+    geometry.PointArray.fromPoints([geometry.Point(1., 2.), geometry.Point(1., 2., 3.)])
+
+  # fromPoints2Dxy flattens mixed points to their x and y
+  mixed = geometry.PointArray.fromPoints2Dxy([geometry.Point(1., 2.), geometry.Point(4., 5., 6.)])
+  assert not mixed.is3D and not mixed.polar
+  assert np.array_equal(np.asarray(mixed)[:, :2], [[1, 2], [4, 5]])
+  assert np.isnan(np.asarray(mixed)[:, 2]).all()
+
+  return
+
+def test_point_array_operations():
+  """! Verifies the batch operations of 'geometry.PointArray' match 'geometry.Point'. """
+
+  rng = np.random.default_rng(3)
+  data = rng.uniform(-10, 10, size=(50, 3))
+  other = rng.uniform(-10, 10, size=(50, 3))
+  array = geometry.PointArray(data)
+  points = [geometry.Point(*row) for row in data]
+  others = [geometry.Point(*row) for row in other]
+
+  distances = array.distance(geometry.PointArray(other))
+  assert np.allclose(distances, [p.distance(q) for p, q in zip(points, others)])
+  assert np.allclose(array.distance(points[0]), [p.distance(points[0]) for p in points])
+
+  midpoints = np.asarray(array.midpoint(geometry.PointArray(other)))
+  assert np.allclose(midpoints, [p.midpoint(q).asCartesianVector for p, q in zip(points, others)])
+
+  polar = array.asPolar
+  assert polar.polar
+  assert np.allclose(np.asarray(polar), [[p.asPolar.radius, p.asPolar.azimuth, p.asPolar.inclination]
+                                        for p in points])
+  assert np.allclose(np.asarray(polar.asCartesian),
+                     [p.asPolar.asCartesian.asCartesianVector for p in points])
+
+  transform = np.eye(4)
+  transform[:3, :3] = [[0, -1, 0], [1, 0, 0], [0, 0, 1]]
+  transform[:3, 3] = [1, 2, 3]
+  expected = data @ transform[:3, :3].T + transform[:3, 3]
+  assert np.allclose(np.asarray(array.transform(transform)), expected)
+
+  polygon = geometry.Polygon([(-5, -5), (5, -5), (5, 5), (-5, 5)])
+  assert polygon.isPointInsideBatch(array).tolist() == [polygon.isPointInside(x, y) for x, y, _ in data]
+
+  return
@@ -1,6 +1,7 @@
 # SPDX-FileCopyrightText: (C) 2022 - 2025 Intel Corporation
 # SPDX-License-Identifier: Apache-2.0
 
+import numpy as np
 import pytest
 
 from scene_common import geometry
@@ -77,3 +78,68 @@ def test_repr(region_poly):
   assert expected_result in repr(region_poly)
 
   return
+
+def test_segmentCrossings():
+  """! Verifies 'geometry.segmentCrossings()' matches 'geometry.Tripwire.lineCrosses()' for every tripwire. """
+
+  rng = np.random.default_rng(1)
+  tripwires = [geometry.Tripwire("39bd9698-8603-43fb-9cb9-06d9a14e6a24", "wire%d" % idx,
+                                 {'points': rng.uniform(0, 20, size=(3, 2)).tolist()})
+               for idx in range(20)]
+  owners = [idx for idx, tripwire in enumerate(tripwires) for _ in range(len(tripwire.segments))]
+  segments = np.vstack([tripwire.segments for tripwire in tripwires])
+  start = rng.uniform(0, 20, size=(300, 2))
+  motion = np.hstack([start, start + rng.uniform(-2, 2, size=(300, 2))])
+
+  expected = {}
+  for idx, (x1, y1, x2, y2) in enumerate(motion):
+    line = geometry.Line(geometry.Point(x1, y1), geometry.Point(x2, y2))
+    for wire, tripwire in enumerate(tripwires):
+      direction = tripwire.lineCrosses(line)
+      if direction != 0:
+        expected[(idx, wire)] = direction
+
+  for cell_size in [0.0, 0.5]:
+    crossings = {}
+    for idx, segment, direction in geometry.segmentCrossings(motion, segments, cell_size).tolist():
+      crossings.setdefault((idx, owners[segment]), direction)
+    assert crossings == expected
+
+  assert geometry.segmentCrossings(np.zeros((0, 4)), segments).shape == (0, 3)
+
+  return
+
+def test_extrudedPolygon():
+  """! Verifies 'geometry.ExtrudedPolygon.intersectsBoxes()' against shapely for boxes rotated about the vertical axis. """
+  from shapely import geometry as shapely_geometry
+
+  vertices = [(0, 0), (10, 0), (10, 2), (2, 2), (2, 10), (0, 10)]
+  prism = geometry.ExtrudedPolygon(vertices, 2.0, 1.0)
+  footprint = shapely_geometry.Polygon(vertices)
+  assert not prism.isConvex
+
+  rng = np.random.default_rng(2)
+  count = 500
+  yaw = rng.uniform(0, 2 * np.pi, count)
+  boxes = np.zeros((count, 10))
+  boxes[:, :2] = rng.uniform(-3, 13, size=(count, 2))
+  boxes[:, 2] = rng.uniform(-1, 4, count)
+  boxes[:, 3:6] = rng.uniform(0.2, 3, size=(count, 3))
+  boxes[:, 8] = np.sin(yaw / 2)
+  boxes[:, 9] = np.cos(yaw / 2)
+
+  expected = []
+  for (x, y, z, sx, sy, sz), angle in zip(boxes[:, :6], yaw):
+    corners = np.array([[-sx, -sy], [sx, -sy], [sx, sy], [-sx, sy]]) / 2
+    rotation = np.array([[np.cos(angle), -np.sin(angle)], [np.sin(angle), np.cos(angle)]])
+    box = shapely_geometry.Polygon(corners @ rotation.T + [x, y])
+    expected.append(bool(box.intersects(footprint)) and z <= 3.0 and z + sz >= 1.0)
+
+  assert prism.intersectsBoxes(boxes).tolist() == expected
+  assert prism.intersectsBox(5, 1, 1.5, 1, 1, 1) is True
+
+  boxes[0, 0] = np.nan
+  assert prism.intersectsBoxes(boxes)[0] == False
+  assert prism.intersectsBoxes(np.zeros((0, 10))).shape == (0,)
+
+  return
@@ -0,0 +1,80 @@
+# SPDX-FileCopyrightText: (C) 2025 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import pytest
+
+from scene_common import geometry
+
+REGIONS = {
+  "poly": {'points': [[2, 1], [5, 1], [5, 4], [3.5, 2.5], [2, 4]]},
+  "circle": {"area": "circle", "center": [5, 5], "radius": 10},
+  "small": {"area": "circle", "center": [-3, -3], "radius": 0.5},
+  "scene": {"area": "scene"},
+}
+
+def buildRegions():
+  return {key: geometry.Region(key, key, info) for key, info in REGIONS.items()}
+
+def queryRegions(index, points):
+  offsets, slots = index.queryBatch(points)
+  ids = index.ids
+  return [sorted(ids[slot] for slot in slots[offsets[i]:offsets[i + 1]]) for i in range(len(points))]
+
+@pytest.mark.parametrize("cell_size", [0.0, 0.25, 100.0])
+
+def test_queryBatch(cell_size):
+  """! Verifies 'geometry.RegionIndex.queryBatch()' matches 'Region.isPointWithin()' for every region. """
+
+  regions = buildRegions()
+  index = geometry.RegionIndex(cell_size)
+  for region in regions.values():
+    region.addToIndex(index)
+  assert len(index) == len(regions)
+
+  rng = np.random.default_rng(0)
+  points = np.vstack([rng.uniform(-10, 20, size=(500, 2)), [[3, 2], [-3, -3], [15, 15]]])
+  expected = [sorted(key for key, region in regions.items() if region.isPointWithin(geometry.Point(x, y)))
+              for x, y in points]
+  assert queryRegions(index, points) == expected
+  assert sorted(index.query(3, 2)) == expected[-3]
+
+  offsets, slots = index.queryBatch(np.zeros((0, 2)))
+  assert offsets.tolist() == [0] and len(slots) == 0
+
+  return
+
+def test_incremental_update():
+  """! Verifies regions can be replaced and removed after the index was queried. """
+
+  regions = buildRegions()
+  index = geometry.RegionIndex()
+  for region in regions.values():
+    region.addToIndex(index)
+  assert queryRegions(index, [[3, 2]]) == [["circle", "poly", "scene"]]
+
+  moved = geometry.Region("poly", "poly", {'points': [[90, 90], [110, 90], [110, 110]]})
+  moved.addToIndex(index)
+  assert index.remove("scene")
+  assert not index.remove("scene")
+  assert "scene" not in index and "poly" in index
+  assert queryRegions(index, [[3, 2], [105, 95]]) == [["circle"], ["poly"]]
+
+  return
+
+def test_non_finite_geometry():
+  """! Verifies non-finite region geometry is rejected and indexed as a region that never matches. """
+
+  index = geometry.RegionIndex()
+  with pytest.raises(ValueError):
+    index.addPolygon("poly", [(0, 0), (float('nan'), 0), (0, 1)])
+  with pytest.raises(ValueError):
+    index.addCircle("circle", 0, 0, float('inf'))
+  assert "poly" not in index and "circle" not in index
+
+  region = geometry.Region("poly", "poly", {'points': [[0, 0], [float('nan'), 0], [0, 1]]})
+  region.addToIndex(index)
+  assert "poly" in index
+  assert queryRegions(index, [[0.1, 0.1]]) == [[]]
+
+  return
@@ -260,3 +260,33 @@ def test_getHeading():
     error = np.linalg.norm(calc_pt - expected_outputs[i])
     assert error < 1  # degrees
   return
+
+def test_batchConversions(lla_datafile):
+  """ Test the batched conversions match the conversions of single points. """
+  rng = np.random.default_rng(4)
+  lla_pts = rng.uniform([-89.0, -179.0, -50.0], [89.0, 179.0, 50.0], size=(200, 3))
+  ecef_pts = earth_lla.convertLLAToECEFBatch(lla_pts)
+  assert np.allclose(ecef_pts, [earth_lla.convertLLAToECEF(pt) for pt in lla_pts], rtol=0, atol=1e-6)
+  # with an identity TRS matrix the local frame is ECEF
+  ecef_transform = earth_lla.GeodeticTransform(np.identity(4))
+  assert np.allclose(ecef_transform.toLLA(ecef_pts),
+                     [earth_lla.convertECEFToLLA(pt) for pt in ecef_pts], rtol=0, atol=1e-9)
+  # points inside the earth use the spherical approximation
+  inner = np.array([[1000.0, 2000.0, 3000.0]])
+  assert np.allclose(ecef_transform.toLLA(inner)[0], earth_lla.convertECEFToLLA(inner[0]))
+
+  with open(lla_datafile, 'r') as f:
+    inputs = json.load(f)
+  trs_mat = earth_lla.calculateTRSLocal2LLAFromSurfacePoints(inputs[0]['map points'][:4],
+                                                             inputs[0]['lat, long, altitude points'][:4])
+  map_pts = np.array(inputs[0]['map points'], dtype=np.float64)
+  velocities = rng.uniform(-2.0, 2.0, size=map_pts.shape)
+  transform = earth_lla.GeodeticTransform(trs_mat)
+  combined = transform.toLLAWithHeadings(map_pts, velocities)
+  for i, pt in enumerate(map_pts):
+    assert np.allclose(combined[i, :3], earth_lla.convertXYZToLLA(trs_mat, pt), rtol=0, atol=1e-9)
+    heading = earth_lla.calculateHeading(trs_mat, pt, velocities[i])
+    assert abs((combined[i, 3] - heading + 180) % 360 - 180) < 1e-6
+  assert np.allclose(transform.headings(map_pts, velocities), combined[:, 3])
+  assert np.allclose(transform.fromLLA(combined[:, :3]), map_pts, rtol=0, atol=1e-6)
+  return
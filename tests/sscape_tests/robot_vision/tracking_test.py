@@ -200,6 +200,26 @@ class TestMultiModelKalmanEstimator(unittest.TestCase):
 
     self.assertEqual(estimator_a.timestamp().timestamp(), estimator_b.timestamp().timestamp())
 
+  def test_matrices_share_memory(self):
+    estimator = tracking.MultiModelKalmanEstimator()
+    estimator.initialize(create_object_at_location(), datetime.now())
+
+    model_probability = estimator.model_probability
+    self.assertIsInstance(model_probability, np.ndarray)
+    self.assertTrue(np.shares_memory(model_probability, estimator.model_probability))
+    # the arrays alias the filter state, they are read-only
+    self.assertFalse(model_probability.flags.writeable)
+    with self.assertRaises(ValueError):
+      model_probability[0] = 1.
+    self.assertEqual(estimator.kalman_filter_error_covariance(0).shape, (12, 12))
+
+    tracked_object = estimator.current_state()
+    error_covariance = tracked_object.error_covariance
+    error_covariance[0, 0] = 42.
+    self.assertEqual(tracked_object.error_covariance[0, 0], 42.)
+    del tracked_object
+    self.assertEqual(error_covariance[0, 0], 42.)
+
 class TestTrackManager(unittest.TestCase):
   def test_track_manager_with_one_track(self):
     initial_timestamp = datetime.now()
@@ -285,6 +305,68 @@ class TestTrackManager(unittest.TestCase):
     with self.assertRaises(RuntimeError):
       track_manager.get_kalman_estimator(tracked_object.id)
 
+  def test_array_input_and_columnar_output(self):
+    """
+    Tracks fed with contiguous arrays report their input row and handle
+    """
+    tracker_config = tracking.TrackManagerConfig()
+    tracker_config.default_process_noise = 1e-5
+    tracker_config.default_measurement_noise = 1e-3
+    tracker = tracking.MultipleObjectTracker(tracker_config)
+    initial_timestamp = datetime.now()
+    step = 0.1
+    velocities = np.array([[2.0, 0.0], [0.0, -1.0]])
+    positions = np.array([[0.0, 0.0], [20.0, 20.0]])
+
+    for k in range(1, 60):
+      timestamp = initial_timestamp + timedelta(seconds=k * step)
+      current = positions + velocities * k * step
+      # the input order is reversed on odd frames
+      order = [1, 0] if k % 2 else [0, 1]
+      states = np.zeros((2, 7))
+      states[:, 0:2] = current[order]
+      states[:, 3:6] = 1.0
+      classifications = np.ones((2, 1))
+      handles = np.array(order, dtype=np.int64) + 100 * k
+      tracker.track(states, classifications, handles, timestamp)
+
+    tracks = tracker.get_reliable_track_arrays()
+    self.assertEqual(len(tracks['id']), 2)
+    self.assertEqual(tracks['state'].shape, (2, 12))
+    self.assertEqual(tracks['covariance'].shape, (2, 12))
+    for i in range(2):
+      index = tracks['measurement_index'][i]
+      self.assertEqual(tracks['user_data'][i], handles[index])
+      np.testing.assert_allclose(tracks['state'][i, 0:2], states[index, 0:2], atol=1e-2)
+      np.testing.assert_allclose(tracks['state'][i, 2:4], velocities[handles[index] % 100], atol=1e-2)
+
+  def test_async_tracking_matches_synchronous_tracking(self):
+    """
+    Background track steps give the same tracks as the synchronous ones
+    """
+    trackers = [tracking.MultipleObjectTracker(), tracking.MultipleObjectTracker()]
+    initial_timestamp = datetime.now()
+    futures = []
+
+    for k in range(1, 30):
+      timestamp = initial_timestamp + timedelta(seconds=k * 0.1)
+      states = np.zeros((2, 7))
+      states[:, 0] = [0.2 * k, 20.0]
+      states[:, 1] = [0.0, 20.0 - 0.1 * k]
+      states[:, 3:6] = 1.0
+      classifications = np.ones((2, 1))
+      handles = np.array([1, 2], dtype=np.int64)
+      trackers[0].track(states, classifications, handles, timestamp)
+      futures.append(trackers[1].track_async(states, classifications, handles, timestamp))
+
+    futures[-1].result()
+    self.assertTrue(all(future.done() for future in futures))
+    expected = trackers[0].get_reliable_track_arrays()
+    actual = trackers[1].get_reliable_track_arrays()
+    np.testing.assert_array_equal(np.sort(expected['user_data']), np.sort(actual['user_data']))
+    np.testing.assert_allclose(expected['state'][np.argsort(expected['user_data'])],
+                               actual['state'][np.argsort(actual['user_data'])])
+
 class TestMatchFunction(unittest.TestCase):
   def test_match_single_objects(self):
     classification_data = tracking.ClassificationData(['Car', 'Bike', 'Pedestrian'])
@@ -491,3 +573,128 @@ class TestComputePixelsToMeterPlane(unittest.TestCase):
 
     self.assertEqual(len(results), 0, "Empty input should return empty results")
     self.assertIsInstance(results, list, "Result should be a list")
+
+  def test_undistortion_map_vs_batch_implementation(self):
+    """
+    Test that the cached undistortion map stays within its error bound of the exact batch function.
+    """
+    intrinsics = np.array([[800.0, 0.0, 320.0],
+                          [0.0, 800.0, 240.0],
+                          [0.0, 0.0, 1.0]], dtype=np.float64)
+    distortion = np.array([0.1, -0.2, 0.01, -0.005, 0.05], dtype=np.float64)
+    undistortion_map = tracking.UndistortionMap(intrinsics, distortion)
+    self.assertLessEqual(undistortion_map.max_error, 1e-4)
+    self.assertTrue(undistortion_map.matches(intrinsics, distortion))
+    self.assertFalse(undistortion_map.matches(intrinsics, np.zeros(5)))
+
+    test_bboxes = [
+      (100, 150, 50, 100),
+      (0, 0, 1, 1),
+      (320, 240, 100, 80),
+      (50.5, 75.3, 25.7, 30.2),
+      (600, 400, 20, 40),
+      (-10, 630, 30, 40)  # Outside the image
+    ]
+    expected = np.array(tracking.compute_pixels_to_meter_plane_batch(test_bboxes, intrinsics, distortion))
+    actual = undistortion_map.compute_pixels_to_meter_plane(np.array(test_bboxes))
+    self.assertEqual(actual.shape, (len(test_bboxes), 4))
+    np.testing.assert_allclose(actual, expected, atol=4 * undistortion_map.max_error + 1e-5)
+    self.assertEqual(undistortion_map.compute_pixels_to_meter_plane(np.zeros((0, 4))).shape, (0, 4))
+
+  def test_camera_projection_of_boxes_and_bounds(self):
+    """
+    Test the batched camera projection with a camera 5m above the ground looking straight down.
+    """
+    pose = np.array([[1.0, 0.0, 0.0, 0.0],
+                     [0.0, -1.0, 0.0, 0.0],
+                     [0.0, 0.0, -1.0, 5.0],
+                     [0.0, 0.0, 0.0, 1.0]])
+    intrinsics = np.eye(3)
+    distortion = np.zeros(5)
+    projection = tracking.CameraProjection(pose, intrinsics, distortion, view_angle=90.0)
+    self.assertTrue(projection.matches(pose, intrinsics, distortion))
+    self.assertFalse(projection.matches(np.eye(4), intrinsics, distortion))
+    np.testing.assert_allclose(projection.camera_point_to_world_point(0.1, 0.2), (0.5, -1.0, 0.0), atol=1e-9)
+
+    # zero object size, the position is not pushed away from the camera
+    projected = projection.project_boxes(np.array([[0.1, 0.2, 0.2, 0.1]]), object_sizes=np.zeros((1, 2)))
+    self.assertEqual(projected['position'].shape, (1, 3))
+    self.assertEqual(projected['shadow'].shape, (1, 4, 3))
+    np.testing.assert_allclose(projected['position'][0], (1.0, -1.5, 0.0), atol=1e-9)
+    np.testing.assert_allclose(projected['shadow'][0][3], (0.5, -1.5, 0.0), atol=1e-9)
+    self.assertAlmostEqual(projected['bounds'][0][0], 1.0)
+    self.assertAlmostEqual(projected['base_angle'][0], np.degrees(np.arctan2(5.0, np.hypot(1.0, 1.5))))
+    self.assertEqual(projection.project_boxes(np.zeros((0, 4)))['position'].shape, (0, 3))
+
+    bounds = projection.project_estimated_bounds(np.array([[0.0, -1.0, 0.0]]), np.array([[2.0, 1.0]]))
+    np.testing.assert_allclose(bounds, [[0.2, 0.25, -0.4, -0.05]], atol=1e-9)
+
+class TestRegionOccupancy(unittest.TestCase):
+  def test_region_occupancy_events(self):
+    """
+    Test that the occupancy engine reports debounced entries and exits with dwell times.
+    """
+    occupancy = tracking.RegionOccupancy(debounce=0.5)
+    regions = ['zone_a', 'zone_b']
+
+    changes = occupancy.update('person', 10.0, regions, ['1', '2'], np.array([[True, False], [False, False]]))
+    self.assertEqual([change.region for change in changes], ['zone_a'])
+    self.assertTrue(changes[0].fired)
+    self.assertEqual(changes[0].entered, ['1'])
+    self.assertEqual(changes[0].count, 1)
+
+    # inside the debounce delay the exit stays pending
+    self.assertEqual(occupancy.update('person', 10.2, regions, ['2'], np.zeros((2, 1), dtype=bool)), [])
+    changes = occupancy.update('person', 11.0, regions, ['2'], np.zeros((2, 1), dtype=bool))
+    self.assertEqual(len(changes), 1)
+    self.assertEqual(changes[0].exited, [('1', 1.0)])
+    self.assertTrue(changes[0].count_changed)
+    self.assertEqual(occupancy.count('zone_a', 'person'), 0)
+
+    # a track leaving before its arrival was published loses its entry time
+    occupancy.update('person', 11.2, regions, ['2'], np.array([[True], [False]]))
+    self.assertEqual(occupancy.entered_at('zone_a', '2'), 11.2)
+    occupancy.update('person', 11.3, regions, ['2'], np.zeros((2, 1), dtype=bool))
+    self.assertTrue(np.isnan(occupancy.entered_at('zone_a', '2')))
+
+    with self.assertRaises(RuntimeError):
+      occupancy.update('person', 12.0, regions, ['2'], np.zeros((1, 1), dtype=bool))
+    return
+
+class TestClusterTracker(unittest.TestCase):
+  def test_cluster_tracker(self):
+    """
+    Test that the cluster tracker keeps cluster ids across frames and drives their lifecycle.
+    """
+    config = tracking.ClusterTrackerConfig()
+    config.frames_to_activate = 3
+    config.frames_to_fade = 2
+    config.frames_to_lost = 2
+    tracker = tracking.ClusterTracker(config)
+
+    timestamp = 10.0
+    tracker.track([tracking.ClusterMeasurement('person', 0.0, 0.0, 4, 'circle'),
+                   tracking.ClusterMeasurement('vehicle', 0.0, 0.0, 3, 'line')], timestamp)
+    clusters = tracker.get_clusters()
+    self.assertEqual([cluster.category for cluster in clusters], ['person', 'vehicle'])
+    self.assertEqual(clusters[0].state, tracking.ClusterState.New)
+    person_id = clusters[0].id
+
+    for frame in range(1, 3):
+      timestamp += 0.1
+      tracker.track([tracking.ClusterMeasurement('person', 0.05 * frame, 0.0, 4, 'circle')], timestamp)
+    person = tracker.get_cluster(person_id)
+    self.assertEqual(person.state, tracking.ClusterState.Active)
+    self.assertEqual(person.frames_detected, 3)
+    self.assertEqual(person.measurement_index, 0)
+
+    # the vehicle cluster was never confirmed, it is lost after frames_to_fade + frames_to_lost misses
+    for _ in range(2):
+      timestamp += 0.1
+      tracker.track([tracking.ClusterMeasurement('person', 0.1, 0.0, 4, 'circle')], timestamp)
+    vehicle = [cluster for cluster in tracker.get_clusters() if cluster.category == 'vehicle'][0]
+    self.assertEqual(vehicle.state, tracking.ClusterState.Lost)
+
+    self.assertEqual(tracker.clear_category('person'), 1)
+    self.assertFalse(tracker.has_cluster(person_id))
+    return